@@ -0,0 +1,774 @@
+// -----------------------------------------------------------------------------
+// @file bench_e2e.c
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#include <stdbool.h>      // bool
+#include <stdio.h>        // FILE, fclose, fflush, fgets, fopen, fprintf, printf, snprintf
+#include <stdlib.h>       // atof, atoi, calloc, free, malloc, strtod, strtol, strtoul
+#include <string.h>       // memcpy, memset, strcmp, strlen, strncpy, strstr, strtok
+#include <sys/resource.h> // getrusage, RUSAGE_SELF
+#include <sys/wait.h>     // waitpid, WEXITSTATUS, WIFEXITED
+#include <time.h>         // clock_gettime, time, CLOCK_MONOTONIC
+#include <unistd.h>       // _exit, close, fork, pipe, read, write
+
+#include "data_writer.h"
+#include "g_network.h"
+#include "g_random.h"
+#include "g_validator.h"
+
+// -----------------------------------------------------------------------------
+/*
+ * End-to-end throughput harness. For every reference topology it generates
+ * a synthetic classification set in memory (noisy copies of one prototype
+ * per class; the seven segments of the digits for 7 inputs), trains for a
+ * few epochs, runs inference and validation on a held-out set, and records
+ * samples/s of each phase, the peak RSS and the held-out accuracy.
+ *
+ * Each topology runs in a child process, so the peak RSS is its own. The
+ * results can be saved as JSON (--json) and compared with a stored baseline
+ * (--baseline): throughput below the baseline by more than --tolerance, peak
+ * RSS above it by more than --rss-tolerance, or accuracy lower by more than
+ * --accuracy-tolerance, is a regression and the exit status is 1. A
+ * --tolerance of 1 accepts any throughput, for hosts other than the
+ * baseline's.
+ */
+
+#define E2E_SCHEMA     1
+#define E2E_MAX_LAYERS 8  // layers per topology, inputs excluded
+#define E2E_MAX_TOPOS  16 // topologies per run
+#define E2E_NAME_LEN   64
+
+typedef struct e2e_config_t {
+    char topologies[E2E_MAX_TOPOS][E2E_NAME_LEN];
+    int  topologies_len;
+
+    long     train_samples;
+    long     valid_samples;
+    int      epochs;
+    float    noise;   // standard deviation around the prototypes
+    uint32_t seed;
+    int      threads; // validation workers
+
+    const char *json;
+    const char *baseline;
+    const char *sets; // prefix of the text sets written for the first topology
+    double      tolerance;     // relative throughput band
+    double      rss_tolerance; // relative peak RSS band
+    double      accuracy_tolerance;
+} e2e_config_t;
+
+typedef struct e2e_result_t {
+    char   topology[E2E_NAME_LEN];
+    double train_sps;
+    double infer_sps;
+    double valid_sps;
+    long   peak_rss_kb;
+    double accuracy;
+    bool   agree; // inference and validation found the same hits
+} e2e_result_t;
+
+typedef struct e2e_topology_t {
+    int sizes[E2E_MAX_LAYERS + 1]; // inputs, then neurons per layer
+    int len;                       // entries of sizes
+} e2e_topology_t;
+
+typedef struct e2e_set_t {
+    float *x; // [samples][inputs]
+    float *t; // [samples][classes], one-hot
+    long   samples;
+    int    inputs;
+    int    classes;
+} e2e_set_t;
+
+typedef struct e2e_model_t {
+    g_page_t    page[E2E_MAX_LAYERS];
+    g_pages_t   pages;
+    g_network_t network;
+    float      *block;
+} e2e_model_t;
+
+static const char *__default_topologies[] = {"7-20-20-10", "32-64-32-10", "128-128-10"};
+
+// segments a..g of the digits 0..9
+static const float __segments[10][7] = {
+    {1, 1, 1, 1, 1, 1, 0},
+    {0, 1, 1, 0, 0, 0, 0},
+    {1, 1, 0, 1, 1, 0, 1},
+    {1, 1, 1, 1, 0, 0, 1},
+    {0, 1, 1, 0, 0, 1, 1},
+    {1, 0, 1, 1, 0, 1, 1},
+    {1, 0, 1, 1, 1, 1, 1},
+    {1, 1, 1, 0, 0, 0, 0},
+    {1, 1, 1, 1, 1, 1, 1},
+    {1, 1, 1, 1, 0, 1, 1},
+};
+
+// -----------------------------------------------------------------------------
+
+static double __now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static bool __parse_topology(const char *name, e2e_topology_t *topology) {
+    char text[E2E_NAME_LEN];
+    strncpy(text, name, sizeof(text) - 1);
+    text[sizeof(text) - 1] = '\0';
+
+    topology->len = 0;
+
+    for (char *tok = strtok(text, "-"); tok != NULL; tok = strtok(NULL, "-")) {
+        const long value = strtol(tok, NULL, 10);
+
+        if ((value <= 0) || (topology->len == E2E_MAX_LAYERS + 1)) {
+            return false;
+        }
+
+        topology->sizes[topology->len++] = (int)value;
+    }
+
+    return topology->len >= 2;
+}
+
+// -----------------------------------------------------------------------------
+// Synthetic Dataset
+// -----------------------------------------------------------------------------
+
+static void __set_free(e2e_set_t *set) {
+    free(set->x);
+    free(set->t);
+    memset(set, 0, sizeof(*set));
+}
+
+static bool __set_generate(e2e_set_t *set, const float *prototypes, long samples, int inputs, int classes, float noise, g_random_t *random) {
+    set->samples = samples;
+    set->inputs  = inputs;
+    set->classes = classes;
+    set->x       = malloc(sizeof(float) * samples * inputs);
+    set->t       = calloc((size_t)samples * classes, sizeof(float));
+
+    if ((set->x == NULL) || (set->t == NULL)) {
+        __set_free(set);
+        return false;
+    }
+
+    // noise for the whole set at once, then shifted onto the prototypes
+    g_random_fill_normal(random, set->x, (size_t)samples * inputs, 0.0f, noise);
+
+    for (long n = 0; n < samples; ++n) {
+        const int c = (int)(((uint64_t)g_random_draw(random) * classes) >> 32);
+
+        float       *X = &set->x[n * inputs];
+        const float *C = &prototypes[c * inputs];
+
+        for (int i = 0; i < inputs; ++i) {
+            X[i] += C[i];
+        }
+
+        set->t[n * classes + c] = 1.0f;
+    }
+
+    return true;
+}
+
+static bool __set_write(const e2e_set_t *set, const char *prefix, const char *name) {
+    char filename[256];
+    bool rvalue = true;
+
+    for (int k = 0; (k < 2) && rvalue; ++k) {
+        snprintf(filename, sizeof(filename), "%s_%s%s.set", prefix, name, (k == 0) ? "" : "_out");
+
+        data_writer_t *file = data_writer_open(filename);
+        rvalue = file != NULL;
+
+        const int    len = (k == 0) ? set->inputs : set->classes;
+        float *const ptr = (k == 0) ? set->x : set->t;
+
+        for (long n = 0; (n < set->samples) && rvalue; ++n) {
+            rvalue = data_writer_next_values(file, &ptr[n * len], len);
+        }
+
+        data_writer_close(&file);
+
+        if (rvalue) {
+            printf("[INFO] Written '%s' (%ld samples)\n", filename, set->samples);
+        }
+    }
+
+    return rvalue;
+}
+
+// -----------------------------------------------------------------------------
+// Model
+// -----------------------------------------------------------------------------
+
+static void __model_free(e2e_model_t *model) {
+    if (model->network.Destroy != NULL) {
+        model->network.Destroy(&model->network);
+    }
+
+    free(model->block);
+    model->block = NULL;
+}
+
+// hidden layers leaky ReLU, output sigmoid, as the 7-segment example
+static bool __model_create(e2e_model_t *model, const e2e_topology_t *topology, uint32_t seed) {
+    const int L = topology->len - 1;
+
+    memset(model, 0, sizeof(*model));
+
+    size_t floats = topology->sizes[0];
+    for (int k = 0; k < L; ++k) {
+        const size_t N = topology->sizes[k];
+        const size_t P = topology->sizes[k + 1];
+
+        floats += P * (N + 1) + 4 * P + 2;
+    }
+
+    model->block = calloc(floats, sizeof(float));
+    if (model->block == NULL) {
+        return false;
+    }
+
+    float *ptr = model->block;
+    float *x   = ptr;
+    ptr += topology->sizes[0];
+
+    for (int k = 0; k < L; ++k) {
+        g_page_t *page = &model->page[k];
+
+        const int N = topology->sizes[k];
+        const int P = topology->sizes[k + 1];
+
+        g_page_reset(page);
+
+        page->l_id      = k;
+        page->x.ptr     = x;
+        page->x.len     = N;
+        page->w.ptr     = ptr;
+        page->w.row     = P;
+        page->w.col     = N + 1;
+        page->z.ptr     = (ptr += (size_t)P * (N + 1));
+        page->z.len     = P;
+        page->y.ptr     = (ptr += P);
+        page->y.len     = P;
+        page->dy_dz.ptr = (ptr += P);
+        page->dy_dz.len = P;
+        page->de_dy.ptr = (ptr += P);
+        page->de_dy.len = P;
+        ptr += P;
+
+        page->lr             = 0.01f;
+        page->af_type        = (k < L - 1) ? LEAKY_RELU : SIGMOID;
+        page->af_args.ptr    = ptr;
+        page->af_args.len    = 1;
+        page->af_args.ptr[0] = (k < L - 1) ? 0.01f : 0.0f;
+        ptr += 2;
+
+        x = page->y.ptr;
+    }
+
+    model->pages.ptr = model->page;
+    model->pages.len = L;
+
+    g_network_link(&model->network);
+
+    if (!model->network.Create(&model->network, &model->pages)) {
+        __model_free(model);
+        return false;
+    }
+
+    model->network.Init_Weights(&model->network, 0.5f, seed, 1);
+
+    return true;
+}
+
+static bool __bind_valid(void *ctx, long index, f_vector_t *inputs, f_vector_t *targets) {
+    const e2e_set_t *set = ctx;
+
+    if (index >= set->samples) {
+        return false;
+    }
+
+    inputs->ptr  = &set->x[index * set->inputs];
+    targets->ptr = &set->t[index * set->classes];
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Topology Run (child process)
+// -----------------------------------------------------------------------------
+
+static bool __run(const e2e_config_t *cfg, const char *name, bool write_sets, e2e_result_t *result) {
+    memset(result, 0, sizeof(*result));
+    strncpy(result->topology, name, sizeof(result->topology) - 1);
+
+    e2e_topology_t topology;
+    if (!__parse_topology(name, &topology)) {
+        printf("[ERROR] Invalid topology '%s'\n", name);
+        return false;
+    }
+
+    const int N = topology.sizes[0];
+    const int C = topology.sizes[topology.len - 1];
+
+    g_random_t random;
+    g_random_init(&random, cfg->seed, 0);
+
+    // one prototype per class
+    float *prototypes = malloc(sizeof(float) * C * N);
+    if (prototypes == NULL) {
+        return false;
+    }
+
+    if ((N == 7) && (C == 10)) {
+        memcpy(prototypes, __segments, sizeof(__segments));
+    } else {
+        g_random_fill_uniform(&random, prototypes, (size_t)C * N, 0.0f, 1.0f);
+    }
+
+    e2e_set_t train;
+    e2e_set_t valid;
+
+    memset(&train, 0, sizeof(train));
+    memset(&valid, 0, sizeof(valid));
+
+    bool rvalue = __set_generate(&train, prototypes, cfg->train_samples, N, C, cfg->noise, &random);
+    rvalue      = rvalue && __set_generate(&valid, prototypes, cfg->valid_samples, N, C, cfg->noise, &random);
+
+    free(prototypes);
+
+    if (rvalue && write_sets) {
+        rvalue = __set_write(&train, cfg->sets, "train") && __set_write(&valid, cfg->sets, "valid");
+    }
+
+    e2e_model_t model;
+    rvalue = rvalue && __model_create(&model, &topology, cfg->seed);
+
+    if (!rvalue) {
+        __set_free(&train);
+        __set_free(&valid);
+        return false;
+    }
+
+    g_network_t *network = &model.network;
+    f_vector_t  *inputs  = &model.pages.ptr[0].x;
+    f_vector_t  *outputs = &model.pages.ptr[model.pages.len - 1].y;
+
+    f_vector_t targets;
+    targets.len = C;
+
+    long *order = malloc(sizeof(long) * train.samples);
+    rvalue      = order != NULL;
+
+    // training: shuffled epochs, adaptive learning rate, as the example
+    const double t0 = __now();
+
+    for (int e = 0; (e < cfg->epochs) && rvalue; ++e) {
+        for (long n = 0; n < train.samples; ++n) {
+            order[n] = n;
+        }
+
+        for (long n = train.samples; n > 1; --n) {
+            const long j = (long)(((uint64_t)g_random_draw(&random) * (uint64_t)n) >> 32);
+            const long k = order[n - 1];
+
+            order[n - 1] = order[j];
+            order[j]     = k;
+        }
+
+        for (long n = 0; n < train.samples; ++n) {
+            inputs->ptr = &train.x[order[n] * N];
+            targets.ptr = &train.t[order[n] * C];
+
+            network->Step_Forward(network);
+            network->Step_Errors(network, &targets);
+            network->Step_Adjust(network);
+            network->Step_Backward(network);
+        }
+    }
+
+    const double t1 = __now();
+
+    // inference: forward pass and argmax, one sample at a time
+    long hits = 0;
+
+    for (long n = 0; n < valid.samples; ++n) {
+        inputs->ptr = &valid.x[n * N];
+
+        network->Step_Forward(network);
+
+        int y_max = 0;
+        for (int j = 1; j < C; ++j) {
+            y_max = (outputs->ptr[j] > outputs->ptr[y_max]) ? j : y_max;
+        }
+
+        hits += valid.t[n * C + y_max] > 0.5f;
+    }
+
+    const double t2 = __now();
+
+    // validation: the multi-threaded engine, with accuracy
+    g_validator_t validator;
+    g_validator_link(&validator);
+
+    rvalue = rvalue && validator.Create(&validator, &model.pages, cfg->threads, 1);
+    rvalue = rvalue && validator.Run(&validator, __bind_valid, &valid, valid.samples, NULL);
+
+    const double t3 = __now();
+
+    if (rvalue) {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+
+        result->train_sps   = (double)cfg->epochs * train.samples / (t1 - t0);
+        result->infer_sps   = (double)valid.samples / (t2 - t1);
+        result->valid_sps   = (double)valid.samples / (t3 - t2);
+        result->peak_rss_kb = usage.ru_maxrss; // kilobytes on Linux
+        result->accuracy    = (validator.samples > 0) ? (double)validator.hits_1 / validator.samples : 0.0;
+        result->agree       = hits == validator.hits_1;
+    }
+
+    validator.Destroy(&validator);
+
+    free(order);
+    __model_free(&model);
+    __set_free(&train);
+    __set_free(&valid);
+
+    return rvalue;
+}
+
+static bool __run_isolated(const e2e_config_t *cfg, const char *name, bool write_sets, e2e_result_t *result) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return false;
+    }
+
+    fflush(stdout);
+
+    const pid_t pid = fork();
+
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+
+    if (pid == 0) {
+        close(fds[0]);
+
+        e2e_result_t child;
+        const bool   rvalue = __run(cfg, name, write_sets, &child);
+
+        const bool sent = write(fds[1], &child, sizeof(child)) == (ssize_t)sizeof(child);
+
+        fflush(stdout);
+        _exit((rvalue && sent) ? 0 : 1);
+    }
+
+    close(fds[1]);
+
+    const bool received = read(fds[0], result, sizeof(*result)) == (ssize_t)sizeof(*result);
+
+    close(fds[0]);
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+
+    return received && WIFEXITED(status) && (WEXITSTATUS(status) == 0);
+}
+
+// -----------------------------------------------------------------------------
+// JSON Report & Baseline
+// -----------------------------------------------------------------------------
+
+static bool __write_json(const e2e_config_t *cfg, const e2e_result_t *results, int len) {
+    FILE *file = fopen(cfg->json, "w");
+    if (file == NULL) {
+        printf("[ERROR] Unable to create '%s'\n", cfg->json);
+        return false;
+    }
+
+    fprintf(file, "{\n");
+    fprintf(file, "  \"benchmark\": \"g_fnn_bench_e2e\",\n");
+    fprintf(file, "  \"schema\": %d,\n", E2E_SCHEMA);
+    fprintf(file, "  \"timestamp\": %ld,\n", (long)time(NULL));
+    fprintf(file, "  \"compiler\": \"%s\",\n", __VERSION__);
+    fprintf(file,
+            "  \"config\": {\"train_samples\": %ld, \"valid_samples\": %ld, \"epochs\": %d, \"noise\": %g, "
+            "\"seed\": %u, \"threads\": %d},\n",
+            cfg->train_samples,
+            cfg->valid_samples,
+            cfg->epochs,
+            cfg->noise,
+            cfg->seed,
+            cfg->threads);
+    fprintf(file, "  \"results\": [\n");
+
+    // one result per line, as __read_baseline expects
+    for (int i = 0; i < len; ++i) {
+        fprintf(file,
+                "    {\"topology\": \"%s\", \"train_sps\": %.1f, \"infer_sps\": %.1f, \"valid_sps\": %.1f, "
+                "\"peak_rss_kb\": %ld, \"accuracy\": %.6f}%s\n",
+                results[i].topology,
+                results[i].train_sps,
+                results[i].infer_sps,
+                results[i].valid_sps,
+                results[i].peak_rss_kb,
+                results[i].accuracy,
+                (i + 1 < len) ? "," : "");
+    }
+
+    fprintf(file, "  ]\n");
+    fprintf(file, "}\n");
+
+    return fclose(file) == 0;
+}
+
+static bool __json_number(const char *line, const char *key, double *value) {
+    char pattern[64];
+    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+
+    const char *ptr = strstr(line, pattern);
+    if (ptr == NULL) {
+        return false;
+    }
+
+    char *end;
+    *value = strtod(ptr + strlen(pattern), &end);
+
+    return end != ptr + strlen(pattern);
+}
+
+// finds the result of a topology in a file written by __write_json
+static bool __read_baseline(const char *filename, const char *topology, e2e_result_t *baseline) {
+    FILE *file = fopen(filename, "r");
+    if (file == NULL) {
+        return false;
+    }
+
+    const size_t len = strlen(topology) + sizeof("\"topology\": \"\"");
+
+    char *pattern = malloc(len);
+    if (pattern == NULL) {
+        fclose(file);
+        return false;
+    }
+
+    snprintf(pattern, len, "\"topology\": \"%s\"", topology);
+
+    char line[1024];
+    bool rvalue = false;
+
+    while (!rvalue && (fgets(line, sizeof(line), file) != NULL)) {
+        if (strstr(line, pattern) != NULL) {
+            double rss = 0.0;
+
+            rvalue = __json_number(line, "train_sps", &baseline->train_sps);
+            rvalue = rvalue && __json_number(line, "infer_sps", &baseline->infer_sps);
+            rvalue = rvalue && __json_number(line, "valid_sps", &baseline->valid_sps);
+            rvalue = rvalue && __json_number(line, "peak_rss_kb", &rss);
+            rvalue = rvalue && __json_number(line, "accuracy", &baseline->accuracy);
+
+            baseline->peak_rss_kb = (long)rss;
+        }
+    }
+
+    free(pattern);
+    fclose(file);
+
+    return rvalue;
+}
+
+static bool __check_rate(const char *topology, const char *what, double value, double base, double tolerance) {
+    const bool rvalue = value >= base * (1.0 - tolerance);
+
+    if (!rvalue) {
+        printf("[ERROR] %s: %s %.1f samples/s, baseline %.1f (-%.1f%%)\n",
+               topology,
+               what,
+               value,
+               base,
+               100.0 * (1.0 - value / base));
+    }
+
+    return rvalue;
+}
+
+static bool __compare(const e2e_config_t *cfg, const e2e_result_t *result) {
+    e2e_result_t base;
+    memset(&base, 0, sizeof(base));
+
+    if (!__read_baseline(cfg->baseline, result->topology, &base)) {
+        printf("[ALERT] %s: not in the baseline '%s'\n", result->topology, cfg->baseline);
+        return true;
+    }
+
+    const char *name = result->topology;
+
+    bool rvalue = true;
+
+    rvalue = __check_rate(name, "training", result->train_sps, base.train_sps, cfg->tolerance) && rvalue;
+    rvalue = __check_rate(name, "inference", result->infer_sps, base.infer_sps, cfg->tolerance) && rvalue;
+    rvalue = __check_rate(name, "validation", result->valid_sps, base.valid_sps, cfg->tolerance) && rvalue;
+
+    if (result->peak_rss_kb > base.peak_rss_kb * (1.0 + cfg->rss_tolerance)) {
+        printf("[ERROR] %s: peak RSS %ld kB, baseline %ld kB\n", name, result->peak_rss_kb, base.peak_rss_kb);
+        rvalue = false;
+    }
+
+    if (result->accuracy < base.accuracy - cfg->accuracy_tolerance) {
+        printf("[ERROR] %s: accuracy %.2f%%, baseline %.2f%%\n", name, 100.0 * result->accuracy, 100.0 * base.accuracy);
+        rvalue = false;
+    }
+
+    return rvalue;
+}
+
+// -----------------------------------------------------------------------------
+// Main Entry Point
+// -----------------------------------------------------------------------------
+
+static void __usage(const char *name) {
+    fprintf(stderr, "Usage: %s [options]\n", name);
+    fprintf(stderr, "Options:\n");
+    fprintf(stderr, "  --topologies <t,...>        Layer sizes, e.g. 7-20-20-10 (default: 7-20-20-10,32-64-32-10,128-128-10)\n");
+    fprintf(stderr, "  --train-samples <n>         Training set size (default: 20000)\n");
+    fprintf(stderr, "  --valid-samples <n>         Held-out set size (default: 5000)\n");
+    fprintf(stderr, "  --epochs <n>                Training epochs (default: 2)\n");
+    fprintf(stderr, "  --noise <sd>                Noise around the class prototypes (default: 0.15)\n");
+    fprintf(stderr, "  --seed <n>                  Dataset and weights seed (default: 1)\n");
+    fprintf(stderr, "  --threads <n>               Validation threads (default: 1)\n");
+    fprintf(stderr, "  --write-sets <prefix>       Also write the sets of the first topology as text\n");
+    fprintf(stderr, "  --json <path>               Write the results as JSON\n");
+    fprintf(stderr, "  --baseline <path>           Compare with a JSON written by --json\n");
+    fprintf(stderr, "  --tolerance <r>             Relative throughput band, 1: any (default: 0.15)\n");
+    fprintf(stderr, "  --rss-tolerance <r>         Relative peak RSS band (default: 0.15)\n");
+    fprintf(stderr, "  --accuracy-tolerance <a>    Absolute accuracy band (default: 0.02)\n");
+}
+
+int main(int argc, char *argv[]) {
+    e2e_config_t cfg;
+    memset(&cfg, 0, sizeof(cfg));
+
+    cfg.train_samples      = 20000;
+    cfg.valid_samples      = 5000;
+    cfg.epochs             = 2;
+    cfg.noise              = 0.15f;
+    cfg.seed               = 1;
+    cfg.threads            = 1;
+    cfg.tolerance          = 0.15;
+    cfg.rss_tolerance      = 0.15;
+    cfg.accuracy_tolerance = 0.02;
+
+    for (size_t i = 0; i < sizeof(__default_topologies) / sizeof(__default_topologies[0]); ++i) {
+        strncpy(cfg.topologies[cfg.topologies_len++], __default_topologies[i], E2E_NAME_LEN - 1);
+    }
+
+    for (int i = 1; i < argc; i++) {
+        const bool has_value = i + 1 < argc;
+
+        bool ok = has_value;
+
+        if (has_value && (strcmp(argv[i], "--topologies") == 0)) {
+            cfg.topologies_len = 0;
+            for (char *tok = strtok(argv[++i], ","); (tok != NULL) && ok; tok = strtok(NULL, ",")) {
+                // a truncated name would be looked up wrongly in the baseline
+                ok = (cfg.topologies_len < E2E_MAX_TOPOS) && (strlen(tok) < E2E_NAME_LEN);
+                if (ok) {
+                    strncpy(cfg.topologies[cfg.topologies_len++], tok, E2E_NAME_LEN - 1);
+                }
+            }
+            ok = ok && (cfg.topologies_len > 0);
+        } else if (has_value && (strcmp(argv[i], "--train-samples") == 0)) {
+            cfg.train_samples = strtol(argv[++i], NULL, 10);
+            ok                = cfg.train_samples > 0;
+        } else if (has_value && (strcmp(argv[i], "--valid-samples") == 0)) {
+            cfg.valid_samples = strtol(argv[++i], NULL, 10);
+            ok                = cfg.valid_samples > 0;
+        } else if (has_value && (strcmp(argv[i], "--epochs") == 0)) {
+            cfg.epochs = atoi(argv[++i]);
+            ok         = cfg.epochs > 0;
+        } else if (has_value && (strcmp(argv[i], "--noise") == 0)) {
+            cfg.noise = (float)atof(argv[++i]);
+            ok        = cfg.noise >= 0.0f;
+        } else if (has_value && (strcmp(argv[i], "--seed") == 0)) {
+            cfg.seed = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (has_value && (strcmp(argv[i], "--threads") == 0)) {
+            cfg.threads = atoi(argv[++i]);
+            ok          = cfg.threads > 0;
+        } else if (has_value && (strcmp(argv[i], "--write-sets") == 0)) {
+            cfg.sets = argv[++i];
+        } else if (has_value && (strcmp(argv[i], "--json") == 0)) {
+            cfg.json = argv[++i];
+        } else if (has_value && (strcmp(argv[i], "--baseline") == 0)) {
+            cfg.baseline = argv[++i];
+        } else if (has_value && (strcmp(argv[i], "--tolerance") == 0)) {
+            cfg.tolerance = atof(argv[++i]);
+            ok            = cfg.tolerance >= 0.0;
+        } else if (has_value && (strcmp(argv[i], "--rss-tolerance") == 0)) {
+            cfg.rss_tolerance = atof(argv[++i]);
+            ok                = cfg.rss_tolerance >= 0.0;
+        } else if (has_value && (strcmp(argv[i], "--accuracy-tolerance") == 0)) {
+            cfg.accuracy_tolerance = atof(argv[++i]);
+            ok                     = cfg.accuracy_tolerance >= 0.0;
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            __usage(argv[0]);
+            return 1;
+        }
+    }
+
+    e2e_result_t results[E2E_MAX_TOPOS];
+
+    bool rvalue = true;
+
+    for (int k = 0; k < cfg.topologies_len; ++k) {
+        e2e_result_t *result = &results[k];
+
+        if (!__run_isolated(&cfg, cfg.topologies[k], (k == 0) && (cfg.sets != NULL), result)) {
+            printf("[ERROR] Topology '%s' failed\n", cfg.topologies[k]);
+            return 1;
+        }
+
+        if (!result->agree) {
+            printf("[ERROR] %s: inference and validation disagree on the hits\n", result->topology);
+            rvalue = false;
+        }
+
+        printf("[INFO] %-16s train %10.1f  infer %10.1f  valid %10.1f samples/s  RSS %7ld kB  accuracy %6.2f%%\n",
+               result->topology,
+               result->train_sps,
+               result->infer_sps,
+               result->valid_sps,
+               result->peak_rss_kb,
+               100.0 * result->accuracy);
+
+        if (cfg.baseline != NULL) {
+            rvalue = __compare(&cfg, result) && rvalue;
+        }
+    }
+
+    if (cfg.json != NULL) {
+        rvalue = __write_json(&cfg, results, cfg.topologies_len) && rvalue;
+    }
+
+    if (cfg.baseline != NULL) {
+        printf("[INFO] Baseline '%s': %s\n", cfg.baseline, rvalue ? "no regression" : "REGRESSION");
+    }
+
+    return rvalue ? 0 : 1;
+}
+
+// -----------------------------------------------------------------------------
+// End of File
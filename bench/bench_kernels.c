@@ -0,0 +1,674 @@
+// -----------------------------------------------------------------------------
+// @file bench_kernels.c
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#include <stdbool.h>  // bool
+#include <stdio.h>    // FILE, fopen, fclose, fprintf, printf, remove
+#include <stdlib.h>   // atoi, calloc, free, malloc, qsort, realloc, strtol
+#include <string.h>   // memset, strcmp, strncpy, strtok
+#include <sys/stat.h> // stat
+#include <time.h>     // clock_gettime, time, CLOCK_MONOTONIC
+
+#include "data_reader.h"
+#include "data_writer.h"
+#include "g_layer.h"
+#include "g_random.h"
+
+// -----------------------------------------------------------------------------
+/*
+ * Kernel microbenchmarks:
+ *
+ *   - Step_Forward, Step_Errors, Step_Backward and Step_Adjust of one layer,
+ *     over a grid of (inputs, neurons, activation) shapes; the error pass
+ *     reads a next layer as wide as the measured one
+ *   - data_writer_next_values and data_reader_next_values on a text file
+ *
+ * Every measurement is calibrated to at least --min-time per repetition,
+ * warmed up, then repeated; the median and the best repetition are reported
+ * with the GFLOP/s and GB/s of the nominal work (weights streamed once, bias
+ * included). Step_Backward runs plain SGD with a zero rate, so the weights
+ * stay put between repetitions.
+ */
+
+#define BENCH_SCHEMA   1
+#define BENCH_MAX_GRID 16   // values per grid axis
+#define BENCH_MAX_REPS 100  // repetitions kept for the statistics
+#define BENCH_MAX_COLS 1024 // reader/writer values per row
+
+typedef struct bench_config_t {
+    int inputs[BENCH_MAX_GRID];
+    int inputs_len;
+    int neurons[BENCH_MAX_GRID];
+    int neurons_len;
+
+    g_act_func_type_t activations[BENCH_MAX_GRID];
+    int               activations_len;
+
+    int    reps;     // timed repetitions
+    double warmup;   // seconds of untimed calls
+    double min_time; // seconds per repetition
+    int    rows;     // reader/writer shape
+    int    cols;
+
+    const char *json; // NULL: no JSON
+    const char *file; // reader/writer scratch file
+} bench_config_t;
+
+typedef struct bench_result_t {
+    char   kernel[32];
+    char   activation[16];
+    int    inputs;
+    int    neurons;
+    long   ops;       // calls (kernels) or values (reader/writer) per repetition
+    double ns_median; // per op
+    double ns_min;    // per op
+    double flops;     // per op, 0: not meaningful
+    double bytes;     // per op
+} bench_result_t;
+
+typedef struct bench_results_t {
+    bench_result_t *ptr;
+    int             len;
+    int             cap;
+} bench_results_t;
+
+// measured layer and the next one, read by the error pass
+typedef struct bench_case_t {
+    g_page_t  page[2];
+    g_layer_t layer[2];
+    float    *block;
+} bench_case_t;
+
+typedef void (*bench_call_t)(bench_case_t *c);
+
+// -----------------------------------------------------------------------------
+
+static const struct {
+    const char       *name;
+    g_act_func_type_t type;
+} __activations[] = {
+    {"linear", LINEAR},
+    {"tanh", TANH},
+    {"relu", RELU},
+    {"leaky_relu", LEAKY_RELU},
+    {"prelu", PRELU},
+    {"swish", SWISH},
+    {"elu", ELU},
+    {"softplus", SOFTPLUS},
+    {"sigmoid", SIGMOID},
+    {"softmax", SOFTMAX},
+};
+
+static const char *__activation_name(g_act_func_type_t type) {
+    for (size_t i = 0; i < sizeof(__activations) / sizeof(__activations[0]); ++i) {
+        if (__activations[i].type == type) {
+            return __activations[i].name;
+        }
+    }
+    return "unknown";
+}
+
+static double __now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static int __compare_doubles(const void *a, const void *b) {
+    const double x = *(const double *)a;
+    const double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static bool __push(bench_results_t *results, const bench_result_t *result) {
+    if (results->len == results->cap) {
+        const int cap = results->cap > 0 ? 2 * results->cap : 64;
+
+        bench_result_t *ptr = realloc(results->ptr, cap * sizeof(bench_result_t));
+        if (ptr == NULL) {
+            return false;
+        }
+
+        results->ptr = ptr;
+        results->cap = cap;
+    }
+
+    results->ptr[results->len++] = *result;
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Layer Kernels
+// -----------------------------------------------------------------------------
+
+static void __case_free(bench_case_t *c) {
+    for (int k = 0; k < 2; ++k) {
+        if (c->layer[k].Destroy != NULL) {
+            c->layer[k].Destroy(&c->layer[k]);
+        }
+    }
+
+    free(c->block);
+    c->block = NULL;
+}
+
+static bool __case_init(bench_case_t *c, int N, int P, g_act_func_type_t type, g_random_t *random) {
+    const int Q = P; // next layer
+
+    // x, w, z, y, dy_dz, de_dy, af_args of both layers in one block
+    size_t floats = (size_t)N;
+    floats += (size_t)P * (N + 1) + 4 * (size_t)P + 2;
+    floats += (size_t)Q * (P + 1) + 4 * (size_t)Q + 2;
+
+    memset(c, 0, sizeof(*c));
+
+    c->block = calloc(floats, sizeof(float));
+    if (c->block == NULL) {
+        return false;
+    }
+
+    float *ptr = c->block;
+
+    const int               x_len[2]   = {N, P};
+    const int               y_len[2]   = {P, Q};
+    const g_act_func_type_t af_type[2] = {type, SIGMOID};
+
+    for (int k = 0; k < 2; ++k) {
+        g_page_t *page = &c->page[k];
+
+        g_page_reset(page);
+
+        page->l_id = 0;
+
+        if (k == 0) {
+            page->x.ptr = ptr;
+            ptr += N;
+        } else {
+            page->x.ptr = c->page[0].y.ptr;
+        }
+
+        page->x.len = x_len[k];
+        page->w.ptr = ptr;
+        page->w.row = y_len[k];
+        page->w.col = x_len[k] + 1;
+        ptr += (size_t)y_len[k] * (x_len[k] + 1);
+
+        page->z.ptr     = ptr;
+        page->z.len     = y_len[k];
+        page->y.ptr     = (ptr += y_len[k]);
+        page->y.len     = y_len[k];
+        page->dy_dz.ptr = (ptr += y_len[k]);
+        page->dy_dz.len = y_len[k];
+        page->de_dy.ptr = (ptr += y_len[k]);
+        page->de_dy.len = y_len[k];
+        ptr += y_len[k];
+
+        // softmax keeps two values, the parametric ones a slope
+        page->af_type        = af_type[k];
+        page->af_args.ptr    = ptr;
+        page->af_args.len    = (af_type[k] == SOFTMAX) ? 2 : 1;
+        page->af_args.ptr[0] = (af_type[k] == SOFTMAX) ? 0.0f : 0.01f;
+        ptr += 2;
+
+        page->lr      = 0.0f; // the update runs, the weights stay put
+        page->op_type = SGD;
+
+        g_random_fill_uniform(random, page->w.ptr, (size_t)page->w.row * page->w.col, -0.1f, 0.1f);
+        g_random_fill_uniform(random, page->de_dy.ptr, page->de_dy.len, -0.1f, 0.1f);
+    }
+
+    g_random_fill_uniform(random, c->page[0].x.ptr, N, 0.0f, 1.0f);
+
+    bool rvalue = true;
+
+    for (int k = 0; (k < 2) && rvalue; ++k) {
+        g_layer_link(&c->layer[k]);
+
+        rvalue = c->layer[k].Create(&c->layer[k], &c->page[k], 0);
+    }
+
+    if (rvalue) {
+        // dY/dZ and dE/dY as a training step leaves them
+        c->layer[0].Step_Forward(&c->layer[0]);
+        c->layer[1].Step_Forward(&c->layer[1]);
+        c->layer[0].Step_Errors(&c->layer[0], &c->layer[1]);
+    } else {
+        __case_free(c);
+    }
+
+    return rvalue;
+}
+
+static void __run_forward(bench_case_t *c) {
+    c->layer[0].Step_Forward(&c->layer[0]);
+}
+
+static void __run_errors(bench_case_t *c) {
+    c->layer[0].Step_Errors(&c->layer[0], &c->layer[1]);
+}
+
+static void __run_backward(bench_case_t *c) {
+    c->layer[0].Step_Backward(&c->layer[0]);
+}
+
+static void __run_adjust(bench_case_t *c) {
+    c->layer[0].Step_Adjust(&c->layer[0]);
+}
+
+// ns per call: calibrated, warmed up and repeated
+static void __measure(const bench_config_t *cfg, bench_call_t call, bench_case_t *c, bench_result_t *result) {
+    long iters = 1;
+
+    // calibrate: double the calls until a repetition lasts min_time
+    while (true) {
+        const double t0 = __now();
+        for (long i = 0; i < iters; ++i) {
+            call(c);
+        }
+        const double dt = __now() - t0;
+
+        if ((dt >= cfg->min_time) || (iters >= (1L << 40))) {
+            break;
+        }
+
+        iters *= 2;
+    }
+
+    const double end = __now() + cfg->warmup;
+    while (__now() < end) {
+        for (long i = 0; i < iters; ++i) {
+            call(c);
+        }
+    }
+
+    double samples[BENCH_MAX_REPS];
+
+    for (int r = 0; r < cfg->reps; ++r) {
+        const double t0 = __now();
+        for (long i = 0; i < iters; ++i) {
+            call(c);
+        }
+        samples[r] = (__now() - t0) * 1e9 / iters;
+    }
+
+    qsort(samples, cfg->reps, sizeof(double), __compare_doubles);
+
+    result->ops       = iters;
+    result->ns_median = samples[cfg->reps / 2];
+    result->ns_min    = samples[0];
+}
+
+static bool __bench_layers(const bench_config_t *cfg, bench_results_t *results) {
+    g_random_t random;
+    g_random_init(&random, 12345u, 0);
+
+    for (int a = 0; a < cfg->activations_len; ++a) {
+        for (int n = 0; n < cfg->inputs_len; ++n) {
+            for (int p = 0; p < cfg->neurons_len; ++p) {
+                const int N = cfg->inputs[n];
+                const int P = cfg->neurons[p];
+                const int Q = P;
+
+                bench_case_t c;
+                if (!__case_init(&c, N, P, cfg->activations[a], &random)) {
+                    printf("[ERROR] Unable to create a %d x %d layer\n", N, P);
+                    return false;
+                }
+
+                const double W = (double)P * (N + 1); // weights of the layer
+                const double V = (double)Q * (P + 1); // weights of the next layer
+
+                const struct {
+                    const char  *kernel;
+                    bench_call_t call;
+                    double       flops;
+                    double       bytes;
+                } kernels[] = {
+                    // multiply-add per weight; weights, inputs, Z and Y
+                    {"Step_Forward", __run_forward, 2.0 * W, 4.0 * (W + N + 2.0 * P)},
+                    // dE/dY . dY/dZ . W per next weight; its weights and vectors
+                    {"Step_Errors", __run_errors, 3.0 * Q * P + 2.0 * P, 4.0 * (V + 2.0 * Q + P)},
+                    // gradient and update per weight; weights read and written
+                    {"Step_Backward", __run_backward, 2.0 * W + P, 4.0 * (2.0 * W + N + 2.0 * P)},
+                    // learning rate bookkeeping, constant cost
+                    {"Step_Adjust", __run_adjust, 0.0, 0.0},
+                };
+
+                for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); ++k) {
+                    bench_result_t result;
+                    memset(&result, 0, sizeof(result));
+
+                    strncpy(result.kernel, kernels[k].kernel, sizeof(result.kernel) - 1);
+                    strncpy(result.activation, __activation_name(cfg->activations[a]), sizeof(result.activation) - 1);
+
+                    result.inputs  = N;
+                    result.neurons = P;
+                    result.flops   = kernels[k].flops;
+                    result.bytes   = kernels[k].bytes;
+
+                    __measure(cfg, kernels[k].call, &c, &result);
+
+                    printf("[INFO] %-14s %-10s %6d x %-6d %12.1f ns/op %8.2f GFLOP/s %8.2f GB/s\n",
+                           result.kernel,
+                           result.activation,
+                           N,
+                           P,
+                           result.ns_median,
+                           result.flops / result.ns_median,
+                           result.bytes / result.ns_median);
+
+                    if (!__push(results, &result)) {
+                        __case_free(&c);
+                        return false;
+                    }
+                }
+
+                __case_free(&c);
+            }
+        }
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Reader & Writer
+// -----------------------------------------------------------------------------
+
+static bool __bench_io(const bench_config_t *cfg, bench_results_t *results) {
+    const int R = cfg->rows;
+    const int C = cfg->cols;
+
+    float *values = malloc(sizeof(float) * (size_t)R * C);
+    if (values == NULL) {
+        return false;
+    }
+
+    g_random_t random;
+    g_random_init(&random, 12345u, 1);
+    g_random_fill_uniform(&random, values, (size_t)R * C, -1.0f, 1.0f);
+
+    double writer[BENCH_MAX_REPS];
+    double reader[BENCH_MAX_REPS];
+
+    bool rvalue = true;
+
+    // one untimed round trip warms the page cache
+    for (int r = -1; (r < cfg->reps) && rvalue; ++r) {
+        const double t0 = __now();
+
+        data_writer_t *file = data_writer_open(cfg->file);
+        rvalue = file != NULL;
+
+        for (int i = 0; (i < R) && rvalue; ++i) {
+            rvalue = data_writer_next_values(file, &values[(size_t)i * C], C);
+        }
+
+        data_writer_close(&file);
+
+        const double t1 = __now();
+
+        data_reader_t *read = rvalue ? data_reader_open(cfg->file) : NULL;
+        rvalue = read != NULL;
+
+        float row[BENCH_MAX_COLS];
+        int   rows = 0;
+
+        while (rvalue && data_reader_next_values(read, row, C)) {
+            rows++;
+        }
+
+        data_reader_close(&read);
+
+        const double t2 = __now();
+
+        if (rvalue && (rows != R)) {
+            printf("[ERROR] Read %d rows back, %d written\n", rows, R);
+            rvalue = false;
+        }
+
+        if (r >= 0) {
+            writer[r] = (t1 - t0) * 1e9 / ((double)R * C);
+            reader[r] = (t2 - t1) * 1e9 / ((double)R * C);
+        }
+    }
+
+    struct stat st;
+    const double bytes = (rvalue && (stat(cfg->file, &st) == 0)) ? (double)st.st_size / ((double)R * C) : 0.0;
+
+    remove(cfg->file);
+    free(values);
+
+    const char   *kernels[2] = {"data_writer_next_values", "data_reader_next_values"};
+    double *const samples[2] = {writer, reader};
+
+    for (int k = 0; (k < 2) && rvalue; ++k) {
+        bench_result_t result;
+        memset(&result, 0, sizeof(result));
+
+        qsort(samples[k], cfg->reps, sizeof(double), __compare_doubles);
+
+        strncpy(result.kernel, kernels[k], sizeof(result.kernel) - 1);
+
+        result.inputs    = C;
+        result.ops       = (long)R * C;
+        result.ns_median = samples[k][cfg->reps / 2];
+        result.ns_min    = samples[k][0];
+        result.bytes     = bytes; // text bytes per value
+
+        printf("[INFO] %-24s %6d x %-6d %12.2f ns/value %8.3f GB/s\n",
+               result.kernel,
+               R,
+               C,
+               result.ns_median,
+               result.bytes / result.ns_median);
+
+        rvalue = __push(results, &result);
+    }
+
+    return rvalue;
+}
+
+// -----------------------------------------------------------------------------
+// JSON Report
+// -----------------------------------------------------------------------------
+
+static bool __write_json(const bench_config_t *cfg, const bench_results_t *results) {
+    FILE *file = fopen(cfg->json, "w");
+    if (file == NULL) {
+        printf("[ERROR] Unable to create '%s'\n", cfg->json);
+        return false;
+    }
+
+    fprintf(file, "{\n");
+    fprintf(file, "  \"benchmark\": \"g_fnn_bench\",\n");
+    fprintf(file, "  \"schema\": %d,\n", BENCH_SCHEMA);
+    fprintf(file, "  \"timestamp\": %ld,\n", (long)time(NULL));
+    fprintf(file, "  \"compiler\": \"%s\",\n", __VERSION__);
+    fprintf(file,
+            "  \"config\": {\"reps\": %d, \"warmup_s\": %g, \"min_time_s\": %g},\n",
+            cfg->reps,
+            cfg->warmup,
+            cfg->min_time);
+    fprintf(file, "  \"results\": [\n");
+
+    for (int i = 0; i < results->len; ++i) {
+        const bench_result_t *r = &results->ptr[i];
+
+        fprintf(file, "    {\"kernel\": \"%s\", ", r->kernel);
+
+        if (r->activation[0] != '\0') {
+            fprintf(file, "\"activation\": \"%s\", \"inputs\": %d, \"neurons\": %d, ", r->activation, r->inputs, r->neurons);
+        } else {
+            fprintf(file, "\"values\": %ld, \"cols\": %d, ", r->ops, r->inputs);
+        }
+
+        fprintf(file, "\"ns_per_op\": %.3f, \"ns_per_op_min\": %.3f, ", r->ns_median, r->ns_min);
+
+        if (r->flops > 0.0) {
+            fprintf(file, "\"gflops\": %.4f, ", r->flops / r->ns_median);
+        } else {
+            fprintf(file, "\"gflops\": null, ");
+        }
+
+        if (r->bytes > 0.0) {
+            fprintf(file, "\"gbs\": %.4f}", r->bytes / r->ns_median);
+        } else {
+            fprintf(file, "\"gbs\": null}");
+        }
+
+        fprintf(file, "%s\n", (i + 1 < results->len) ? "," : "");
+    }
+
+    fprintf(file, "  ]\n");
+    fprintf(file, "}\n");
+
+    return fclose(file) == 0;
+}
+
+// -----------------------------------------------------------------------------
+// Argument Processing
+// -----------------------------------------------------------------------------
+
+static bool __parse_ints(char *arg, int *ptr, int *len) {
+    *len = 0;
+
+    for (char *tok = strtok(arg, ","); tok != NULL; tok = strtok(NULL, ",")) {
+        const long value = strtol(tok, NULL, 10);
+
+        if ((value <= 0) || (*len == BENCH_MAX_GRID)) {
+            return false;
+        }
+
+        ptr[(*len)++] = (int)value;
+    }
+
+    return *len > 0;
+}
+
+static bool __parse_activations(char *arg, g_act_func_type_t *ptr, int *len) {
+    *len = 0;
+
+    for (char *tok = strtok(arg, ","); tok != NULL; tok = strtok(NULL, ",")) {
+        bool found = false;
+
+        for (size_t i = 0; (i < sizeof(__activations) / sizeof(__activations[0])) && !found; ++i) {
+            if ((strcmp(tok, __activations[i].name) == 0) && (*len < BENCH_MAX_GRID)) {
+                ptr[(*len)++] = __activations[i].type;
+                found         = true;
+            }
+        }
+
+        if (!found) {
+            return false;
+        }
+    }
+
+    return *len > 0;
+}
+
+static void __usage(const char *name) {
+    fprintf(stderr, "Usage: %s [options]\n", name);
+    fprintf(stderr, "Options:\n");
+    fprintf(stderr, "  --inputs <n,...>       Inputs per layer (default: 16,64,256,1024)\n");
+    fprintf(stderr, "  --neurons <n,...>      Neurons per layer (default: 16,64,256)\n");
+    fprintf(stderr, "  --activations <a,...>  Activations, or 'all' (default: relu,sigmoid,softmax)\n");
+    fprintf(stderr, "  --reps <n>             Timed repetitions, median reported (default: 7)\n");
+    fprintf(stderr, "  --warmup <ms>          Untimed calls before timing (default: 50)\n");
+    fprintf(stderr, "  --min-time <ms>        Shortest repetition (default: 20)\n");
+    fprintf(stderr, "  --rows <n>             Reader/writer rows (default: 100000)\n");
+    fprintf(stderr, "  --cols <n>             Reader/writer values per row (default: 16)\n");
+    fprintf(stderr, "  --file <path>          Reader/writer scratch file (default: g_fnn_bench.set)\n");
+    fprintf(stderr, "  --json <path>          Also write the results as JSON\n");
+}
+
+// -----------------------------------------------------------------------------
+// Main Entry Point
+// -----------------------------------------------------------------------------
+
+int main(int argc, char *argv[]) {
+    bench_config_t cfg = {
+        .inputs          = {16, 64, 256, 1024},
+        .inputs_len      = 4,
+        .neurons         = {16, 64, 256},
+        .neurons_len     = 3,
+        .activations     = {RELU, SIGMOID, SOFTMAX},
+        .activations_len = 3,
+        .reps            = 7,
+        .warmup          = 0.050,
+        .min_time        = 0.020,
+        .rows            = 100000,
+        .cols            = 16,
+        .json            = NULL,
+        .file            = "g_fnn_bench.set",
+    };
+
+    for (int i = 1; i < argc; i++) {
+        const bool has_value = i + 1 < argc;
+
+        bool ok = has_value;
+
+        if (has_value && (strcmp(argv[i], "--inputs") == 0)) {
+            ok = __parse_ints(argv[++i], cfg.inputs, &cfg.inputs_len);
+        } else if (has_value && (strcmp(argv[i], "--neurons") == 0)) {
+            ok = __parse_ints(argv[++i], cfg.neurons, &cfg.neurons_len);
+        } else if (has_value && (strcmp(argv[i], "--activations") == 0)) {
+            if (strcmp(argv[++i], "all") == 0) {
+                cfg.activations_len = sizeof(__activations) / sizeof(__activations[0]);
+                for (int a = 0; a < cfg.activations_len; ++a) {
+                    cfg.activations[a] = __activations[a].type;
+                }
+            } else {
+                ok = __parse_activations(argv[i], cfg.activations, &cfg.activations_len);
+            }
+        } else if (has_value && (strcmp(argv[i], "--reps") == 0)) {
+            cfg.reps = atoi(argv[++i]);
+            ok       = (cfg.reps > 0) && (cfg.reps <= BENCH_MAX_REPS);
+        } else if (has_value && (strcmp(argv[i], "--warmup") == 0)) {
+            cfg.warmup = atoi(argv[++i]) * 1e-3;
+            ok         = cfg.warmup >= 0.0;
+        } else if (has_value && (strcmp(argv[i], "--min-time") == 0)) {
+            cfg.min_time = atoi(argv[++i]) * 1e-3;
+            ok           = cfg.min_time > 0.0;
+        } else if (has_value && (strcmp(argv[i], "--rows") == 0)) {
+            cfg.rows = atoi(argv[++i]);
+            ok       = cfg.rows > 0;
+        } else if (has_value && (strcmp(argv[i], "--cols") == 0)) {
+            cfg.cols = atoi(argv[++i]);
+            ok       = (cfg.cols > 0) && (cfg.cols <= BENCH_MAX_COLS);
+        } else if (has_value && (strcmp(argv[i], "--file") == 0)) {
+            cfg.file = argv[++i];
+        } else if (has_value && (strcmp(argv[i], "--json") == 0)) {
+            cfg.json = argv[++i];
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            __usage(argv[0]);
+            return 1;
+        }
+    }
+
+    bench_results_t results = {NULL, 0, 0};
+
+    bool rvalue = __bench_layers(&cfg, &results);
+
+    rvalue = rvalue && __bench_io(&cfg, &results);
+
+    if (rvalue && (cfg.json != NULL)) {
+        rvalue = __write_json(&cfg, &results);
+    }
+
+    free(results.ptr);
+
+    return rvalue ? 0 : 1;
+}
+
+// -----------------------------------------------------------------------------
+// End of File
@@ -0,0 +1,221 @@
+// -----------------------------------------------------------------------------
+// @file bench_parse.c
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#include <ctype.h>   // isdigit
+#include <stdbool.h> // bool
+#include <stdio.h>   // FILE, fopen, fclose, fprintf, fscanf, fgetc, printf, remove
+#include <stdlib.h>  // atoi, exit, malloc, free
+#include <string.h>  // strcmp
+#include <time.h>    // clock_gettime, CLOCK_MONOTONIC
+
+#include "data_reader.h"
+
+// -----------------------------------------------------------------------------
+// Reference: the original stdio-based reader (fscanf/fgetc per value)
+// -----------------------------------------------------------------------------
+
+static void __legacy_skip_invalid_chars(FILE *file) {
+    int c;
+    while ((c = fgetc(file)) != EOF) {
+        if (c == '#') {
+            while ((c = fgetc(file)) != EOF && c != '\n') {
+            }
+            continue;
+        }
+
+        if (isdigit(c) || c == '.' || c == '-' || c == ',' || c == 'e' || c == 'E') {
+            ungetc(c, file);
+            break;
+        }
+    }
+}
+
+static bool __legacy_next_values(FILE *file, float *values_ptr, const int values_len) {
+    __legacy_skip_invalid_chars(file);
+
+    int items_read = 0;
+    for (int i = 0; i < values_len; i++) {
+        if (fscanf(file, "%f", &values_ptr[i]) != 1) {
+            break;
+        }
+        items_read++;
+        if (i < values_len - 1) {
+            int c = fgetc(file);
+            if (c != ',' && c != EOF) {
+                ungetc(c, file);
+            }
+        }
+    }
+
+    if (items_read != values_len) {
+        return false;
+    }
+
+    int c;
+    while ((c = fgetc(file)) != EOF && c != '\n') {
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+static double __now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+typedef struct bench_format_t {
+    const char *name;
+    const char *value_fmt; // printf format of a value followed by a separator
+    const char *last_fmt;  // printf format of the last value of a line
+    bool        unsigned_values;
+} bench_format_t;
+
+static const bench_format_t __formats[] = {
+    {"dataset (%.4f)", "%.4f, ", "%.4f\n", true},       // fnn_dataset.set
+    {"weights (%14.6e)", "%14.6e,", "%14.6e\n", false}, // fnn_weights.out
+};
+
+static void __generate(const char *filename, const bench_format_t *format, int rows, int cols) {
+    FILE *file = fopen(filename, "w");
+    if (file == NULL) {
+        fprintf(stderr, "Error: Unable to create '%s'\n", filename);
+        exit(1);
+    }
+
+    fprintf(file, "# synthetic dataset: %d rows, %d columns\n", rows, cols);
+
+    unsigned seed = 12345u;
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            seed = seed * 1664525u + 1013904223u;
+
+            float value = (float)(seed >> 8) / (float)(1u << 24);
+
+            if (!format->unsigned_values) {
+                value = value * 2.0f - 1.0f;
+            }
+
+            fprintf(file, (c < cols - 1) ? format->value_fmt : format->last_fmt, value);
+        }
+    }
+
+    fclose(file);
+}
+
+static double __checksum(const float *values, int len) {
+    double sum = 0.0;
+    for (int i = 0; i < len; ++i) {
+        sum += values[i];
+    }
+    return sum;
+}
+
+// -----------------------------------------------------------------------------
+// Main Entry Point
+// -----------------------------------------------------------------------------
+
+int main(int argc, char *argv[]) {
+    const char *filename = "g_fnn_bench_parse.set";
+
+    int rows = 200000;
+    int cols = 16;
+
+    for (int i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "--rows") == 0) && (i + 1 < argc)) {
+            rows = atoi(argv[++i]);
+        } else if ((strcmp(argv[i], "--cols") == 0) && (i + 1 < argc)) {
+            cols = atoi(argv[++i]);
+        } else if ((strcmp(argv[i], "--file") == 0) && (i + 1 < argc)) {
+            filename = argv[++i];
+        } else {
+            fprintf(stderr, "Usage: %s [--rows <n>] [--cols <n>] [--file <path>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (rows <= 0 || cols <= 0) {
+        fprintf(stderr, "Error: Invalid shape\n");
+        return 1;
+    }
+
+    float *values = malloc(sizeof(float) * cols);
+    if (values == NULL) {
+        return 1;
+    }
+
+    int rvalue = 0;
+
+    for (size_t f = 0; f < sizeof(__formats) / sizeof(__formats[0]); ++f) {
+        __generate(filename, &__formats[f], rows, cols);
+
+        // legacy reader
+        double legacy_sum  = 0.0;
+        int    legacy_rows = 0;
+
+        FILE *file = fopen(filename, "r");
+        if (file == NULL) {
+            rvalue = 1;
+            break;
+        }
+
+        const double t0 = __now();
+        while (__legacy_next_values(file, values, cols)) {
+            legacy_sum += __checksum(values, cols);
+            legacy_rows++;
+        }
+        const double t1 = __now();
+
+        fclose(file);
+
+        // buffered reader
+        double reader_sum  = 0.0;
+        int    reader_rows = 0;
+
+        data_reader_t *reader = data_reader_open(filename);
+        if (reader == NULL) {
+            rvalue = 1;
+            break;
+        }
+
+        const double t2 = __now();
+        while (data_reader_next_values(reader, values, cols)) {
+            reader_sum += __checksum(values, cols);
+            reader_rows++;
+        }
+        const double t3 = __now();
+
+        data_reader_close(&reader);
+
+        const double total    = (double)rows * cols;
+        const double legacy   = total / (t1 - t0);
+        const double buffered = total / (t3 - t2);
+
+        printf("[INFO] Format: %s\n", __formats[f].name);
+        printf("[INFO]   Values parsed:   %.0f (%d x %d)\n", total, rows, cols);
+        printf("[INFO]   Legacy reader:   %12.3e values/s\n", legacy);
+        printf("[INFO]   Buffered reader: %12.3e values/s\n", buffered);
+        printf("[INFO]   Speedup:         %.1fx\n", buffered / legacy);
+
+        if ((legacy_rows != reader_rows) || (legacy_sum != reader_sum)) {
+            printf("[ERROR] Readers disagree (rows %d vs %d)\n", legacy_rows, reader_rows);
+            rvalue = 1;
+        }
+    }
+
+    remove(filename);
+
+    free(values);
+
+    return rvalue;
+}
+
+// -----------------------------------------------------------------------------
+// End of File
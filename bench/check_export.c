@@ -0,0 +1,393 @@
+// -----------------------------------------------------------------------------
+// @file check_export.c
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#include <math.h>    // fabs, sqrtf
+#include <stdbool.h> // bool
+#include <stdio.h>   // FILE, fclose, fopen, fprintf, fread, fwrite, printf, remove, snprintf
+#include <stdlib.h>  // atoi, calloc, free, getenv, mkdtemp, strtoul, system
+#include <string.h>  // memcmp, memcpy, memset, strcmp, strlen
+#include <unistd.h>  // rmdir
+
+#include "data_export.h"
+#include "g_network.h"
+#include "g_random.h"
+
+// -----------------------------------------------------------------------------
+/*
+ * Round trip of data_export_c on Linux. Every trial draws a network (2 to 5
+ * layers, 1 to 32 neurons each, the output cycling through all ten
+ * activations, any activation in the hidden layers), exports it, compiles
+ * the source with a small driver (-Wall -Wextra -pedantic -Werror, so the
+ * emitted code must be warning free), runs it over random samples and
+ * compares every output with Step_Forward of the runtime. The outputs are
+ * expected bit for bit; a difference within the tolerance is reported but
+ * passes, since another compiler or libm may round transcendentals apart.
+ */
+
+#define CHECK_MAX_LAYERS 5
+#define CHECK_MAX_WIDTH  32
+#define CHECK_PATH_MAX   512
+#define CHECK_TOL_ABS    1e-6
+#define CHECK_TOL_REL    1e-5
+
+typedef struct check_config_t {
+    int         trials;
+    int         samples; // per trial
+    uint32_t    seed;
+    const char *cc;   // compiler of the exported source
+    bool        keep; // leave the last trial's files in place
+} check_config_t;
+
+typedef struct check_net_t {
+    int layers;
+    int width[CHECK_MAX_LAYERS + 1]; // inputs, then neurons per layer
+
+    g_page_t    page[CHECK_MAX_LAYERS];
+    g_pages_t   pages;
+    g_network_t network;
+    float      *block;
+} check_net_t;
+
+static const char *__driver_source =
+    "#include <stdio.h>\n"
+    "\n"
+    "#include \"net.h\"\n"
+    "\n"
+    "int main(int argc, char *argv[]) {\n"
+    "    FILE *in  = (argc == 3) ? fopen(argv[1], \"rb\") : NULL;\n"
+    "    FILE *out = (argc == 3) ? fopen(argv[2], \"wb\") : NULL;\n"
+    "\n"
+    "    if ((in == NULL) || (out == NULL)) {\n"
+    "        return 1;\n"
+    "    }\n"
+    "\n"
+    "    float x[NET_INPUTS];\n"
+    "    float y[NET_OUTPUTS];\n"
+    "\n"
+    "    while (fread(x, sizeof(float), NET_INPUTS, in) == NET_INPUTS) {\n"
+    "        net_forward(x, y);\n"
+    "        fwrite(y, sizeof(float), NET_OUTPUTS, out);\n"
+    "    }\n"
+    "\n"
+    "    fclose(in);\n"
+    "    return (fclose(out) == 0) ? 0 : 1;\n"
+    "}\n";
+
+// -----------------------------------------------------------------------------
+
+static int __draw_int(g_random_t *random, int min, int max) {
+    return min + (int)(g_random_draw(random) % (uint32_t)(max - min + 1));
+}
+
+static void __net_free(check_net_t *net) {
+    if (net->network.Destroy != NULL) {
+        net->network.Destroy(&net->network);
+    }
+
+    free(net->block);
+    net->block = NULL;
+}
+
+static bool __net_init(check_net_t *net, int trial, g_random_t *random) {
+    memset(net, 0, sizeof(*net));
+
+    net->layers = __draw_int(random, 2, CHECK_MAX_LAYERS);
+
+    for (int k = 0; k <= net->layers; ++k) {
+        net->width[k] = __draw_int(random, 1, CHECK_MAX_WIDTH);
+    }
+
+    const int L = net->layers;
+
+    // x, then w, z, y, dy_dz, de_dy and af_args of every layer
+    size_t floats = (size_t)net->width[0];
+    for (int k = 0; k < L; ++k) {
+        floats += (size_t)net->width[k + 1] * (net->width[k] + 1) + 5 * (size_t)net->width[k + 1] + 2;
+    }
+
+    net->block = calloc(floats, sizeof(float));
+    if (net->block == NULL) {
+        printf("[ERROR] Unable to allocate a check network\n");
+        return false;
+    }
+
+    float *ptr = net->block;
+
+    for (int k = 0; k < L; ++k) {
+        g_page_t *page = &net->page[k];
+
+        const int N = net->width[k];
+        const int P = net->width[k + 1];
+
+        g_page_reset(page);
+
+        page->l_id = k;
+
+        if (k == 0) {
+            page->x.ptr = ptr;
+            ptr += N;
+        } else {
+            page->x.ptr = net->page[k - 1].y.ptr;
+        }
+
+        page->x.len = N;
+        page->w.ptr = ptr;
+        page->w.row = P;
+        page->w.col = N + 1;
+        ptr += (size_t)P * (N + 1);
+
+        page->z.ptr     = ptr;
+        page->z.len     = P;
+        page->y.ptr     = (ptr += P);
+        page->y.len     = P;
+        page->dy_dz.ptr = (ptr += P);
+        page->dy_dz.len = P;
+        page->de_dy.ptr = (ptr += P);
+        page->de_dy.len = P;
+        ptr += P;
+
+        // the output cycles through all activations
+        page->af_type     = (k == L - 1) ? (g_act_func_type_t)(trial % 10) : (g_act_func_type_t)__draw_int(random, 0, 9);
+        page->af_args.ptr = ptr;
+        page->af_args.len = (page->af_type == PRELU) ? P : (page->af_type == SOFTMAX) ? 2 : 1;
+        ptr += P + 2;
+
+        if (page->af_type == PRELU) {
+            g_random_fill_uniform(random, page->af_args.ptr, P, 0.05f, 0.5f);
+        } else {
+            g_random_fill_uniform(random, page->af_args.ptr, 1, 0.01f, 1.5f);
+        }
+
+        const float scale = 2.0f / sqrtf((float)(N + 1));
+        g_random_fill_uniform(random, page->w.ptr, (size_t)P * (N + 1), -scale, scale);
+    }
+
+    net->pages.ptr = net->page;
+    net->pages.len = L;
+
+    g_network_link(&net->network);
+
+    if (!net->network.Create(&net->network, &net->pages)) {
+        printf("[ERROR] Unable to create the network of trial %d\n", trial);
+        __net_free(net);
+        return false;
+    }
+
+    return true;
+}
+
+static bool __write_bytes(const char *path, const void *ptr, size_t len) {
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        printf("[ERROR] Unable to open file '%s'\n", path);
+        return false;
+    }
+
+    bool rvalue = fwrite(ptr, 1, len, file) == len;
+
+    rvalue = (fclose(file) == 0) && rvalue;
+
+    return rvalue;
+}
+
+static bool __read_bytes(const char *path, void *ptr, size_t len) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        printf("[ERROR] Unable to open file '%s'\n", path);
+        return false;
+    }
+
+    const bool rvalue = fread(ptr, 1, len, file) == len;
+
+    fclose(file);
+
+    return rvalue;
+}
+
+// -----------------------------------------------------------------------------
+
+static bool __run_trial(const check_config_t *cfg, const char *dir, int trial, g_random_t *random, long *identical,
+                        long *values) {
+    check_net_t net;
+
+    if (!__net_init(&net, trial, random)) {
+        return false;
+    }
+
+    const int N = net.width[0];
+    const int P = net.width[net.layers];
+    const int S = cfg->samples;
+
+    float *x = calloc((size_t)S * N, sizeof(float));
+    float *y = calloc((size_t)S * P, sizeof(float));
+
+    char base[CHECK_PATH_MAX];
+    char path_in[CHECK_PATH_MAX];
+    char path_out[CHECK_PATH_MAX];
+    char path_driver[CHECK_PATH_MAX];
+    char command[4 * CHECK_PATH_MAX];
+
+    snprintf(base, sizeof(base), "%s/net", dir);
+    snprintf(path_in, sizeof(path_in), "%s/in.bin", dir);
+    snprintf(path_out, sizeof(path_out), "%s/out.bin", dir);
+    snprintf(path_driver, sizeof(path_driver), "%s/driver.c", dir);
+
+    bool rvalue = (x != NULL) && (y != NULL);
+
+    if (rvalue) {
+        g_random_fill_uniform(random, x, (size_t)S * N, -1.0f, 1.0f);
+
+        rvalue = data_export_c(&net.pages, base);
+        rvalue = rvalue && __write_bytes(path_driver, __driver_source, strlen(__driver_source));
+        rvalue = rvalue && __write_bytes(path_in, x, sizeof(float) * S * N);
+    }
+
+    if (rvalue) {
+        snprintf(command, sizeof(command), "%s -std=c11 -O2 -Wall -Wextra -pedantic -Werror -o %s %s.c %s -lm",
+                 cfg->cc, base, base, path_driver);
+
+        rvalue = system(command) == 0;
+        if (!rvalue) {
+            printf("[ERROR] Trial %d: the exported source does not compile: %s\n", trial, command);
+        }
+    }
+
+    if (rvalue) {
+        snprintf(command, sizeof(command), "%s %s %s", base, path_in, path_out);
+
+        rvalue = (system(command) == 0) && __read_bytes(path_out, y, sizeof(float) * S * P);
+        if (!rvalue) {
+            printf("[ERROR] Trial %d: the exported network did not run\n", trial);
+        }
+    }
+
+    const float *Y = net.page[net.layers - 1].y.ptr;
+
+    for (int n = 0; rvalue && (n < S); ++n) {
+        memcpy(net.page[0].x.ptr, &x[(size_t)n * N], sizeof(float) * N);
+
+        net.network.Step_Forward(&net.network);
+
+        for (int j = 0; j < P; ++j) {
+            const float  a     = y[(size_t)n * P + j];
+            const double error = fabs((double)a - Y[j]);
+
+            *values += 1;
+            *identical += memcmp(&a, &Y[j], sizeof(float)) == 0;
+
+            if (!(error <= CHECK_TOL_ABS + CHECK_TOL_REL * fabs(Y[j]))) {
+                printf("[ERROR] Trial %d, sample %d [%d]: exported %.9g, runtime %.9g\n", trial, n, j, a, Y[j]);
+                rvalue = false;
+                break;
+            }
+        }
+    }
+
+    if (!cfg->keep || (trial < cfg->trials - 1)) {
+        char path[CHECK_PATH_MAX + 4];
+
+        snprintf(path, sizeof(path), "%s.c", base);
+        remove(path);
+        snprintf(path, sizeof(path), "%s.h", base);
+        remove(path);
+        remove(base);
+        remove(path_in);
+        remove(path_out);
+        remove(path_driver);
+    }
+
+    free(x);
+    free(y);
+    __net_free(&net);
+
+    return rvalue;
+}
+
+static void __usage(const char *name) {
+    fprintf(stderr, "Usage: %s [options]\n", name);
+    fprintf(stderr, "Options:\n");
+    fprintf(stderr, "  --trials <n>   Random networks exported (default: 20)\n");
+    fprintf(stderr, "  --samples <n>  Samples compared per network (default: 100)\n");
+    fprintf(stderr, "  --seed <n>     Seed of the draws (default: 12345)\n");
+    fprintf(stderr, "  --cc <path>    Compiler of the exported source (default: $CC or cc)\n");
+    fprintf(stderr, "  --keep         Keep the files of the last trial\n");
+}
+
+// -----------------------------------------------------------------------------
+// Main Entry Point
+// -----------------------------------------------------------------------------
+
+int main(int argc, char *argv[]) {
+    check_config_t cfg = {
+        .trials  = 20,
+        .samples = 100,
+        .seed    = 12345u,
+        .cc      = (getenv("CC") != NULL) ? getenv("CC") : "cc",
+        .keep    = false,
+    };
+
+    for (int i = 1; i < argc; i++) {
+        const bool has_value = i + 1 < argc;
+
+        bool ok = true;
+
+        if (strcmp(argv[i], "--keep") == 0) {
+            cfg.keep = true;
+        } else if (has_value && (strcmp(argv[i], "--trials") == 0)) {
+            cfg.trials = atoi(argv[++i]);
+            ok         = cfg.trials > 0;
+        } else if (has_value && (strcmp(argv[i], "--samples") == 0)) {
+            cfg.samples = atoi(argv[++i]);
+            ok          = cfg.samples > 0;
+        } else if (has_value && (strcmp(argv[i], "--seed") == 0)) {
+            cfg.seed = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (has_value && (strcmp(argv[i], "--cc") == 0)) {
+            cfg.cc = argv[++i];
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            __usage(argv[0]);
+            return 1;
+        }
+    }
+
+    char dir[] = "/tmp/g_fnn_export.XXXXXX";
+
+    if (mkdtemp(dir) == NULL) {
+        printf("[ERROR] Unable to create a scratch directory\n");
+        return 1;
+    }
+
+    g_random_t random;
+    g_random_init(&random, cfg.seed, 0);
+
+    bool rvalue = true;
+
+    long identical = 0;
+    long values    = 0;
+
+    for (int trial = 0; trial < cfg.trials; ++trial) {
+        rvalue = __run_trial(&cfg, dir, trial, &random, &identical, &values) && rvalue;
+    }
+
+    if (cfg.keep) {
+        printf("[INFO] Files of the last trial kept in %s\n", dir);
+    } else {
+        rmdir(dir);
+    }
+
+    printf("[INFO] %ld outputs compared, %ld bit for bit identical\n", values, identical);
+    printf("%s\n", rvalue ? "[INFO] All checks passed" : "[ERROR] Some checks failed");
+
+    return rvalue ? 0 : 1;
+}
+
+// -----------------------------------------------------------------------------
+// End of File
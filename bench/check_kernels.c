@@ -0,0 +1,1094 @@
+// -----------------------------------------------------------------------------
+// @file check_kernels.c
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#include <math.h>    // INFINITY, exp, expm1, fabs, log, log1p, sqrt, tanh
+#include <stdbool.h> // bool
+#include <stdio.h>   // fprintf, printf
+#include <stdlib.h>  // atoi, calloc, free, strtoul
+#include <string.h>  // memcpy, memset, strcmp
+
+#include "g_network.h"
+#include "g_random.h"
+#include "g_validator.h"
+
+// -----------------------------------------------------------------------------
+/*
+ * Kernel equivalence and numerical checks. Every trial draws a topology
+ * (2 to 4 layers, 1 to 24 neurons each), the activations, an optimizer, a
+ * loss and the inputs, then runs them through the runtime (g_network_t on
+ * g_layer/g_neuron, float) and through a double precision reference written
+ * here from the definitions:
+ *
+ *   - forward:  Y and dY/dZ of every layer
+ *   - errors:   dE/dZ of the output layer and dE/dY of the hidden ones
+ *   - gradient: runtime dE/dW against central differences of the reference
+ *               loss, for a few weights per layer
+ *   - update:   W after two training steps with the drawn optimizer
+ *   - clone:    the forward pass on g_pages_clone pages, bit for bit
+ *   - fused:    the fused sigmoid + BCE gradient against the unfused kernel
+ *   - threads:  g_validator (threaded, cloned pages) predictions and loss
+ *               against the network, over several batches
+ *
+ * Every comparison passes when |a - b| <= abs + rel * |b|, with tolerances
+ * per kernel (per activation for the forward pass, per optimizer for the
+ * update). The output layer cycles through all ten activations; softmax
+ * only appears there, paired with CCE, since elsewhere its dY/dZ is the
+ * diagonal of the Jacobian and by design not a true gradient. Inputs that
+ * bring a piecewise activation within CHECK_KINK of its break are drawn
+ * again, so the branches taken never depend on rounding.
+ *
+ * A new kernel (SIMD, batched, threaded) gets its own check here, against
+ * the same reference, before it replaces the scalar one.
+ */
+
+#define CHECK_MAX_LAYERS  4
+#define CHECK_MAX_WIDTH   24
+#define CHECK_MAX_REPORTS 10   // mismatches printed per check
+#define CHECK_FD_WEIGHTS  6    // weights per layer checked by finite differences
+#define CHECK_FD_STEP     1e-6 // central difference step
+#define CHECK_KINK        1e-3 // closest Z allowed to a piecewise break
+#define CHECK_DRAWS       20   // input draws before a trial is skipped
+#define CHECK_SAMPLES     600  // validator samples, over several batches
+#define CHECK_STEPS       2    // training steps before the weights are compared
+
+typedef enum check_kind_t {
+    CHECK_FORWARD,
+    CHECK_ERRORS,
+    CHECK_GRADIENT,
+    CHECK_UPDATE,
+    CHECK_CLONE,
+    CHECK_FUSED,
+    CHECK_THREADS,
+    CHECK_KINDS
+} check_kind_t;
+
+typedef struct check_tol_t {
+    double abs;
+    double rel;
+} check_tol_t;
+
+typedef struct check_stat_t {
+    long   values;
+    long   failures;
+    double worst; // largest |a - b| / (abs + rel * |b|)
+} check_stat_t;
+
+typedef struct check_config_t {
+    int      trials;
+    uint32_t seed;
+    int      threads; // validator workers
+    bool     verbose; // one line per trial
+} check_config_t;
+
+// one random network, its pages in a single block
+typedef struct check_net_t {
+    int               layers;
+    int               width[CHECK_MAX_LAYERS + 1]; // inputs, then neurons per layer
+    g_act_func_type_t af_type[CHECK_MAX_LAYERS];
+    g_optim_type_t    op_type;
+    g_loss_type_t     loss_type;
+
+    g_page_t    page[CHECK_MAX_LAYERS];
+    g_pages_t   pages;
+    g_network_t network;
+    float      *block;
+    float       targets[CHECK_MAX_WIDTH];
+} check_net_t;
+
+// the same network in double precision
+typedef struct check_ref_t {
+    double w[CHECK_MAX_LAYERS][CHECK_MAX_WIDTH][CHECK_MAX_WIDTH + 1];
+    double m[CHECK_MAX_LAYERS][CHECK_MAX_WIDTH][CHECK_MAX_WIDTH + 1];
+    double v[CHECK_MAX_LAYERS][CHECK_MAX_WIDTH][CHECK_MAX_WIDTH + 1];
+
+    double x[CHECK_MAX_LAYERS + 1][CHECK_MAX_WIDTH]; // inputs, then Y of every layer
+    double z[CHECK_MAX_LAYERS][CHECK_MAX_WIDTH];
+    double dy_dz[CHECK_MAX_LAYERS][CHECK_MAX_WIDTH];
+    double de_dy[CHECK_MAX_LAYERS][CHECK_MAX_WIDTH];
+    double de_dz[CHECK_MAX_LAYERS][CHECK_MAX_WIDTH];
+
+    double beta_1_t[CHECK_MAX_LAYERS];
+    double beta_2_t[CHECK_MAX_LAYERS];
+} check_ref_t;
+
+// samples bound by the validator
+typedef struct check_samples_t {
+    float *x;
+    float *t;
+    int    N;
+    int    P;
+} check_samples_t;
+
+// -----------------------------------------------------------------------------
+
+static const char *__kind_names[CHECK_KINDS] = {
+    "forward", "errors", "gradient", "update", "clone", "fused", "threads",
+};
+
+static const char *__activation_names[] = {
+    "linear", "tanh", "relu", "leaky_relu", "prelu", "swish", "elu", "softplus", "sigmoid", "softmax",
+};
+
+static const char *__optimizer_names[] = {"sgd", "momentum", "nesterov", "rmsprop", "adam"};
+
+static const char *__loss_names[] = {"mse", "bce", "cce"};
+
+// forward pass, by activation: float transcendentals and float accumulation
+static const check_tol_t __tol_forward[] = {
+    [LINEAR] = {1e-5, 1e-5},   [TANH] = {2e-5, 2e-5},    [RELU] = {1e-5, 1e-5},     [LEAKY_RELU] = {1e-5, 1e-5},
+    [PRELU] = {1e-5, 1e-5},    [SWISH] = {2e-5, 2e-5},   [ELU] = {2e-5, 2e-5},      [SOFTPLUS] = {2e-5, 2e-5},
+    [SIGMOID] = {2e-5, 2e-5},  [SOFTMAX] = {2e-5, 2e-5},
+};
+
+// weight update, by optimizer: adaptive steps divide by the gradient scale
+static const check_tol_t __tol_update[] = {
+    [SGD] = {2e-6, 1e-3}, [MOMENTUM] = {2e-6, 1e-3}, [NESTEROV] = {2e-6, 1e-3}, [RMSPROP] = {1e-5, 1e-3},
+    [ADAM] = {1e-5, 1e-3},
+};
+
+static const check_tol_t __tol_errors   = {5e-5, 1e-4};
+static const check_tol_t __tol_gradient = {1e-4, 1e-3};
+static const check_tol_t __tol_fused    = {1e-5, 1e-4};
+static const check_tol_t __tol_threads  = {1e-9, 1e-9};
+
+static check_stat_t __stats[CHECK_KINDS];
+
+static long __coverage[10]; // trials per activation
+
+// -----------------------------------------------------------------------------
+
+static int __draw_int(g_random_t *random, int min, int max) {
+    return min + (int)(g_random_draw(random) % (uint32_t)(max - min + 1));
+}
+
+static float __draw_float(g_random_t *random, float min, float max) {
+    float value;
+    g_random_fill_uniform(random, &value, 1, min, max);
+    return value;
+}
+
+static bool __compare(check_kind_t kind, int trial, const char *what, int layer, int index, double a, double b,
+                      check_tol_t tol) {
+    check_stat_t *stat = &__stats[kind];
+
+    const double bound = tol.abs + tol.rel * fabs(b);
+    const double error = fabs(a - b);
+    const bool   ok    = error <= bound; // false on NaN
+
+    stat->values++;
+    stat->worst = (error / bound > stat->worst) ? error / bound : stat->worst;
+
+    if (!ok) {
+        if (stat->failures < CHECK_MAX_REPORTS) {
+            printf("[ERROR] %s trial %d, %s layer %d [%d]: %.9g, expected %.9g (|diff| %.3g > %.3g)\n",
+                   __kind_names[kind], trial, what, layer, index, a, b, error, bound);
+        }
+
+        stat->failures++;
+    }
+
+    return ok;
+}
+
+static bool __is_piecewise(g_act_func_type_t af_type) {
+    return (af_type == RELU) || (af_type == LEAKY_RELU) || (af_type == PRELU) || (af_type == ELU);
+}
+
+static bool __is_fused(const check_net_t *net) {
+    const g_act_func_type_t af_type = net->af_type[net->layers - 1];
+
+    return ((af_type == SIGMOID) && (net->loss_type == BCE)) || ((af_type == SOFTMAX) && (net->loss_type == CCE));
+}
+
+static g_optim_args_t __optimizer_args(g_optim_type_t op_type) {
+    g_optim_args_t op_args = {0};
+
+    // a larger epsilon than training keeps the adaptive steps well conditioned
+    switch (op_type) {
+        case MOMENTUM:
+        case NESTEROV:
+            op_args.beta_1 = 0.9f;
+            break;
+        case RMSPROP:
+            op_args.beta_2  = 0.9f;
+            op_args.epsilon = 1e-3f;
+            break;
+        case ADAM:
+            op_args.beta_1  = 0.9f;
+            op_args.beta_2  = 0.999f;
+            op_args.epsilon = 1e-3f;
+            break;
+        default:
+            break;
+    }
+
+    return op_args;
+}
+
+// -----------------------------------------------------------------------------
+// Random Networks
+// -----------------------------------------------------------------------------
+
+static void __net_free(check_net_t *net) {
+    if (net->network.Destroy != NULL) {
+        net->network.Destroy(&net->network);
+    }
+
+    free(net->block);
+    net->block = NULL;
+}
+
+static bool __net_init(check_net_t *net, int trial, g_random_t *random) {
+    memset(net, 0, sizeof(*net));
+
+    net->layers = __draw_int(random, 2, CHECK_MAX_LAYERS);
+
+    for (int k = 0; k <= net->layers; ++k) {
+        net->width[k] = __draw_int(random, 1, CHECK_MAX_WIDTH);
+    }
+
+    // the output cycles through all activations, hidden layers draw any but softmax
+    const int L = net->layers;
+
+    for (int k = 0; k < L - 1; ++k) {
+        net->af_type[k] = (g_act_func_type_t)__draw_int(random, LINEAR, SIGMOID);
+    }
+
+    net->af_type[L - 1] = (g_act_func_type_t)(trial % 10);
+    net->op_type        = (g_optim_type_t)((trial / 10) % 5);
+
+    switch (net->af_type[L - 1]) {
+        case SOFTMAX: {
+            net->loss_type = CCE;
+            net->width[L]  = (net->width[L] < 2) ? 2 : net->width[L];
+        } break;
+
+        case SIGMOID: {
+            net->loss_type = (g_random_draw(random) & 1) ? BCE : MSE;
+        } break;
+
+        default: {
+            net->loss_type = MSE;
+        } break;
+    }
+
+    // x, then w, m, v, z, y, dy_dz, de_dy and af_args of every layer
+    size_t floats = (size_t)net->width[0];
+    for (int k = 0; k < L; ++k) {
+        const size_t N = (size_t)net->width[k];
+        const size_t P = (size_t)net->width[k + 1];
+
+        floats += 3 * P * (N + 1) + 4 * P + P + 2;
+    }
+
+    net->block = calloc(floats, sizeof(float));
+    if (net->block == NULL) {
+        printf("[ERROR] Unable to allocate a check network\n");
+        return false;
+    }
+
+    float *ptr = net->block;
+
+    for (int k = 0; k < L; ++k) {
+        g_page_t *page = &net->page[k];
+
+        const int N = net->width[k];
+        const int P = net->width[k + 1];
+
+        g_page_reset(page);
+
+        page->l_id = k;
+
+        if (k == 0) {
+            page->x.ptr = ptr;
+            ptr += N;
+        } else {
+            page->x.ptr = net->page[k - 1].y.ptr;
+        }
+
+        page->x.len = N;
+
+        f_matrix_t *matrices[3] = {&page->w, &page->m, &page->v};
+        for (int b = 0; b < 3; ++b) {
+            matrices[b]->ptr = ptr;
+            matrices[b]->row = P;
+            matrices[b]->col = N + 1;
+            ptr += (size_t)P * (N + 1);
+        }
+
+        page->z.ptr     = ptr;
+        page->z.len     = P;
+        page->y.ptr     = (ptr += P);
+        page->y.len     = P;
+        page->dy_dz.ptr = (ptr += P);
+        page->dy_dz.len = P;
+        page->de_dy.ptr = (ptr += P);
+        page->de_dy.len = P;
+        ptr += P;
+
+        // a slope per neuron for prelu, two values for softmax, one otherwise
+        page->af_type     = net->af_type[k];
+        page->af_args.ptr = ptr;
+        page->af_args.len = (page->af_type == PRELU) ? P : (page->af_type == SOFTMAX) ? 2 : 1;
+        ptr += P + 2;
+
+        if (page->af_type == PRELU) {
+            g_random_fill_uniform(random, page->af_args.ptr, P, 0.05f, 0.5f);
+        } else if (page->af_type == LEAKY_RELU) {
+            page->af_args.ptr[0] = __draw_float(random, 0.01f, 0.3f);
+        } else if (page->af_type == ELU) {
+            page->af_args.ptr[0] = __draw_float(random, 0.5f, 1.5f);
+        }
+
+        page->lr = __draw_float(random, 0.001f, 0.05f);
+
+        const float scale = 1.0f / sqrtf((float)(N + 1));
+        g_random_fill_uniform(random, page->w.ptr, (size_t)P * (N + 1), -2.0f * scale, 2.0f * scale);
+    }
+
+    net->pages.ptr = net->page;
+    net->pages.len = L;
+
+    g_network_link(&net->network);
+
+    bool rvalue = net->network.Create(&net->network, &net->pages);
+
+    rvalue = rvalue && net->network.Set_Optimizer(&net->network, net->op_type, __optimizer_args(net->op_type));
+    rvalue = rvalue && net->network.Set_Loss(&net->network, net->loss_type);
+
+    if (!rvalue) {
+        printf("[ERROR] Unable to create the network of trial %d\n", trial);
+        __net_free(net);
+    }
+
+    return rvalue;
+}
+
+static void __net_draw_sample(check_net_t *net, float *x, float *t, g_random_t *random) {
+    const int N = net->width[0];
+    const int P = net->width[net->layers];
+
+    g_random_fill_uniform(random, x, N, -1.0f, 1.0f);
+
+    if (net->loss_type == CCE) {
+        memset(t, 0, sizeof(float) * P);
+        t[__draw_int(random, 0, P - 1)] = 1.0f;
+    } else if (net->af_type[net->layers - 1] == SIGMOID) {
+        g_random_fill_uniform(random, t, P, 0.0f, 1.0f);
+    } else {
+        g_random_fill_uniform(random, t, P, -1.0f, 1.0f);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Reference
+// -----------------------------------------------------------------------------
+
+static void __ref_load(check_ref_t *ref, const check_net_t *net) {
+    memset(ref, 0, sizeof(*ref));
+
+    for (int k = 0; k < net->layers; ++k) {
+        const g_page_t *page = &net->page[k];
+
+        for (int j = 0; j < page->w.row; ++j) {
+            for (int i = 0; i < page->w.col; ++i) {
+                ref->w[k][j][i] = page->w.ptr[j * page->w.col + i];
+            }
+        }
+
+        ref->beta_1_t[k] = 1.0;
+        ref->beta_2_t[k] = 1.0;
+    }
+}
+
+static void __ref_forward(check_ref_t *ref, const check_net_t *net) {
+    for (int i = 0; i < net->width[0]; ++i) {
+        ref->x[0][i] = net->page[0].x.ptr[i];
+    }
+
+    for (int k = 0; k < net->layers; ++k) {
+        const g_page_t *page = &net->page[k];
+
+        const int N = net->width[k];
+        const int P = net->width[k + 1];
+
+        const double *X = ref->x[k];
+        double       *Y = ref->x[k + 1];
+        double       *Z = ref->z[k];
+        double       *D = ref->dy_dz[k];
+
+        for (int j = 0; j < P; ++j) {
+            Z[j] = ref->w[k][j][N];
+
+            for (int i = 0; i < N; ++i) {
+                Z[j] += ref->w[k][j][i] * X[i];
+            }
+        }
+
+        double z_max = Z[0];
+        for (int j = 1; j < P; ++j) {
+            z_max = (Z[j] > z_max) ? Z[j] : z_max;
+        }
+
+        double sum_exp = 0.0;
+        for (int j = 0; j < P; ++j) {
+            sum_exp += exp(Z[j] - z_max);
+        }
+
+        for (int j = 0; j < P; ++j) {
+            const double z     = Z[j];
+            const double alpha = (page->af_type == PRELU) ? page->af_args.ptr[j] : page->af_args.ptr[0];
+            const double sigma = 1.0 / (1.0 + exp(-z));
+
+            switch (page->af_type) {
+                case TANH: {
+                    Y[j] = tanh(z);
+                    D[j] = 1.0 - Y[j] * Y[j];
+                } break;
+
+                case RELU: {
+                    Y[j] = (z > 0.0) ? z : 0.0;
+                    D[j] = (z > 0.0) ? 1.0 : 0.0;
+                } break;
+
+                case LEAKY_RELU:
+                case PRELU: {
+                    Y[j] = (z > 0.0) ? z : alpha * z;
+                    D[j] = (z > 0.0) ? 1.0 : alpha;
+                } break;
+
+                case SWISH: {
+                    Y[j] = z * sigma;
+                    D[j] = sigma + z * sigma * (1.0 - sigma);
+                } break;
+
+                case ELU: {
+                    Y[j] = (z > 0.0) ? z : alpha * expm1(z);
+                    D[j] = (z > 0.0) ? 1.0 : alpha * exp(z);
+                } break;
+
+                case SOFTPLUS: {
+                    Y[j] = log1p(exp(z));
+                    D[j] = sigma;
+                } break;
+
+                case SIGMOID: {
+                    Y[j] = sigma;
+                    D[j] = sigma * (1.0 - sigma);
+                } break;
+
+                case SOFTMAX: {
+                    // the runtime keeps the diagonal of the Jacobian
+                    Y[j] = exp(z - z_max) / sum_exp;
+                    D[j] = Y[j] * (1.0 - Y[j]);
+                } break;
+
+                default: {
+                    Y[j] = z;
+                    D[j] = 1.0;
+                } break;
+            }
+        }
+    }
+}
+
+static double __ref_loss(const check_ref_t *ref, const check_net_t *net) {
+    const int     L = net->layers;
+    const int     P = net->width[L];
+    const double *Y = ref->x[L];
+    const float  *T = net->targets;
+
+    // summed over the outputs, as the runtime's dE/dY is
+    double loss = 0.0;
+
+    for (int j = 0; j < P; ++j) {
+        switch (net->loss_type) {
+            case BCE: {
+                loss -= T[j] * log(Y[j]) + (1.0 - T[j]) * log(1.0 - Y[j]);
+            } break;
+
+            case CCE: {
+                loss -= T[j] * log(Y[j]);
+            } break;
+
+            default: {
+                loss += (Y[j] - T[j]) * (Y[j] - T[j]);
+            } break;
+        }
+    }
+
+    return loss;
+}
+
+static void __ref_errors(check_ref_t *ref, const check_net_t *net) {
+    const int L = net->layers;
+
+    for (int j = 0; j < net->width[L]; ++j) {
+        const double e = ref->x[L][j] - net->targets[j];
+
+        // fused: softmax + CCE or sigmoid + BCE reduce to Y - T
+        ref->de_dy[L - 1][j] = __is_fused(net) ? e : 2.0 * e;
+        ref->de_dz[L - 1][j] = __is_fused(net) ? e : 2.0 * e * ref->dy_dz[L - 1][j];
+    }
+
+    for (int k = L - 2; k >= 0; --k) {
+        for (int j = 0; j < net->width[k + 1]; ++j) {
+            double de_dy = 0.0;
+
+            for (int i = 0; i < net->width[k + 2]; ++i) {
+                de_dy += ref->de_dz[k + 1][i] * ref->w[k + 1][i][j];
+            }
+
+            ref->de_dy[k][j] = de_dy;
+            ref->de_dz[k][j] = de_dy * ref->dy_dz[k][j];
+        }
+    }
+}
+
+static void __ref_update(check_ref_t *ref, const check_net_t *net) {
+    for (int k = 0; k < net->layers; ++k) {
+        const g_page_t *page = &net->page[k];
+
+        const int N = net->width[k];
+
+        const double lr  = page->lr;
+        const double b1  = page->op_args.beta_1;
+        const double b2  = page->op_args.beta_2;
+        const double eps = page->op_args.epsilon;
+
+        ref->beta_1_t[k] *= b1;
+        ref->beta_2_t[k] *= b2;
+
+        for (int j = 0; j < net->width[k + 1]; ++j) {
+            for (int i = 0; i <= N; ++i) {
+                const double g = ref->de_dz[k][j] * ((i < N) ? ref->x[k][i] : 1.0);
+
+                double *W = &ref->w[k][j][i];
+                double *M = &ref->m[k][j][i];
+                double *V = &ref->v[k][j][i];
+
+                switch (net->op_type) {
+                    case MOMENTUM: {
+                        *M = b1 * *M + g;
+                        *W -= lr * *M;
+                    } break;
+
+                    case NESTEROV: {
+                        *M = b1 * *M + g;
+                        *W -= lr * (g + b1 * *M);
+                    } break;
+
+                    case RMSPROP: {
+                        *V = b2 * *V + (1.0 - b2) * g * g;
+                        *W -= lr * g / (sqrt(*V) + eps);
+                    } break;
+
+                    case ADAM: {
+                        *M = b1 * *M + (1.0 - b1) * g;
+                        *V = b2 * *V + (1.0 - b2) * g * g;
+                        *W -= lr / (1.0 - ref->beta_1_t[k]) * *M / (sqrt(*V / (1.0 - ref->beta_2_t[k])) + eps);
+                    } break;
+
+                    default: {
+                        *W -= lr * g;
+                    } break;
+                }
+            }
+        }
+    }
+}
+
+// smallest distance of a piecewise activation input from its break
+static double __ref_kink(const check_ref_t *ref, const check_net_t *net) {
+    double rvalue = INFINITY;
+
+    for (int k = 0; k < net->layers; ++k) {
+        if (__is_piecewise(net->af_type[k])) {
+            for (int j = 0; j < net->width[k + 1]; ++j) {
+                rvalue = (fabs(ref->z[k][j]) < rvalue) ? fabs(ref->z[k][j]) : rvalue;
+            }
+        }
+    }
+
+    return rvalue;
+}
+
+// -----------------------------------------------------------------------------
+// Checks
+// -----------------------------------------------------------------------------
+
+static bool __check_forward(const check_net_t *net, const check_ref_t *ref, int trial) {
+    bool rvalue = true;
+
+    for (int k = 0; k < net->layers; ++k) {
+        const g_page_t   *page = &net->page[k];
+        const check_tol_t tol  = __tol_forward[page->af_type];
+
+        for (int j = 0; j < page->y.len; ++j) {
+            rvalue = __compare(CHECK_FORWARD, trial, "Y", k, j, page->y.ptr[j], ref->x[k + 1][j], tol) && rvalue;
+            rvalue = __compare(CHECK_FORWARD, trial, "dY/dZ", k, j, page->dy_dz.ptr[j], ref->dy_dz[k][j], tol) && rvalue;
+        }
+    }
+
+    return rvalue;
+}
+
+static bool __check_errors(const check_net_t *net, const check_ref_t *ref, int trial) {
+    bool rvalue = true;
+
+    const int L = net->layers;
+
+    // the output layer as dE/dZ, fused kernels fold dY/dZ into dE/dY
+    const g_page_t *out = &net->page[L - 1];
+
+    for (int j = 0; j < out->y.len; ++j) {
+        const double de_dz = (double)out->de_dy.ptr[j] * out->dy_dz.ptr[j];
+
+        rvalue = __compare(CHECK_ERRORS, trial, "dE/dZ", L - 1, j, de_dz, ref->de_dz[L - 1][j], __tol_errors) && rvalue;
+    }
+
+    for (int k = 0; k < L - 1; ++k) {
+        const g_page_t *page = &net->page[k];
+
+        for (int j = 0; j < page->y.len; ++j) {
+            rvalue = __compare(CHECK_ERRORS, trial, "dE/dY", k, j, page->de_dy.ptr[j], ref->de_dy[k][j], __tol_errors) &&
+                     rvalue;
+        }
+    }
+
+    return rvalue;
+}
+
+static bool __check_gradient(const check_net_t *net, check_ref_t *ref, int trial, g_random_t *random) {
+    bool rvalue = true;
+
+    for (int k = 0; k < net->layers; ++k) {
+        const g_page_t *page = &net->page[k];
+
+        const int N = net->width[k];
+        const int P = net->width[k + 1];
+
+        for (int n = 0; n < CHECK_FD_WEIGHTS; ++n) {
+            const int j = __draw_int(random, 0, P - 1);
+            const int i = __draw_int(random, 0, N); // N: the bias
+
+            // what the runtime's update uses: dE/dZ times the input
+            const double x_i      = (i < N) ? page->x.ptr[i] : 1.0;
+            const double analytic = (double)page->de_dy.ptr[j] * page->dy_dz.ptr[j] * x_i;
+
+            double      *w      = &ref->w[k][j][i];
+            const double w_orig = *w;
+
+            *w = w_orig + CHECK_FD_STEP;
+            __ref_forward(ref, net);
+            const double loss_plus = __ref_loss(ref, net);
+
+            *w = w_orig - CHECK_FD_STEP;
+            __ref_forward(ref, net);
+            const double loss_minus = __ref_loss(ref, net);
+
+            *w = w_orig;
+
+            const double numeric = (loss_plus - loss_minus) / (2.0 * CHECK_FD_STEP);
+
+            rvalue = __compare(CHECK_GRADIENT, trial, "dE/dW", k, j * (N + 1) + i, analytic, numeric, __tol_gradient) &&
+                     rvalue;
+        }
+    }
+
+    __ref_forward(ref, net);
+
+    return rvalue;
+}
+
+static bool __check_update(const check_net_t *net, const check_ref_t *ref, const float *w_start, int trial) {
+    bool rvalue = true;
+
+    const check_tol_t tol = __tol_update[net->op_type];
+
+    for (int k = 0; k < net->layers; ++k) {
+        const g_page_t *page = &net->page[k];
+
+        const int C = page->w.col;
+
+        for (int j = 0; j < page->w.row; ++j) {
+            for (int i = 0; i < C; ++i) {
+                // relative to the distance travelled, not to the weight
+                const double start = *w_start++;
+                const double moved = (double)page->w.ptr[j * C + i] - start;
+
+                rvalue = __compare(CHECK_UPDATE, trial, "W", k, j * C + i, moved, ref->w[k][j][i] - start, tol) && rvalue;
+            }
+        }
+    }
+
+    return rvalue;
+}
+
+static bool __check_clone(check_net_t *net, int trial) {
+    g_pages_t clone = {NULL, 0};
+
+    if (!g_pages_clone(&clone, &net->pages)) {
+        printf("[ERROR] Unable to clone the pages of trial %d\n", trial);
+        return false;
+    }
+
+    g_network_t network;
+    g_network_link(&network);
+
+    bool rvalue = network.Create(&network, &clone);
+
+    if (rvalue) {
+        memcpy(clone.ptr[0].x.ptr, net->page[0].x.ptr, sizeof(float) * net->width[0]);
+
+        net->network.Step_Forward(&net->network);
+        network.Step_Forward(&network);
+
+        // same code on the same weights: the same bits
+        const check_tol_t exact = {0.0, 0.0};
+
+        for (int k = 0; k < net->layers; ++k) {
+            for (int j = 0; j < net->width[k + 1]; ++j) {
+                rvalue = __compare(CHECK_CLONE, trial, "Y", k, j, clone.ptr[k].y.ptr[j], net->page[k].y.ptr[j], exact) &&
+                         rvalue;
+            }
+        }
+
+        network.Destroy(&network);
+    } else {
+        printf("[ERROR] Unable to create a network on the cloned pages of trial %d\n", trial);
+    }
+
+    g_pages_free(&clone);
+
+    return rvalue;
+}
+
+static bool __check_fused(check_net_t *net, int trial) {
+    const int L = net->layers;
+    const int P = net->width[L];
+
+    g_page_t *out = &net->page[L - 1];
+
+    f_vector_t targets = {net->targets, P};
+
+    float fused[CHECK_MAX_LAYERS][CHECK_MAX_WIDTH];
+
+    net->network.Step_Forward(&net->network);
+    net->network.Step_Errors(&net->network, &targets);
+
+    for (int j = 0; j < P; ++j) {
+        fused[L - 1][j] = out->de_dy.ptr[j] * out->dy_dz.ptr[j];
+    }
+
+    for (int k = 0; k < L - 1; ++k) {
+        memcpy(fused[k], net->page[k].de_dy.ptr, sizeof(float) * net->width[k + 1]);
+    }
+
+    // the loss is linked by output activation: hide the sigmoid to get the plain BCE kernel
+    out->af_type = LINEAR;
+    net->network.Set_Loss(&net->network, BCE);
+    out->af_type = SIGMOID;
+
+    net->network.Step_Forward(&net->network);
+    net->network.Step_Errors(&net->network, &targets);
+
+    bool rvalue = true;
+
+    for (int j = 0; j < P; ++j) {
+        const double de_dz = (double)out->de_dy.ptr[j] * out->dy_dz.ptr[j];
+
+        rvalue = __compare(CHECK_FUSED, trial, "dE/dZ", L - 1, j, fused[L - 1][j], de_dz, __tol_fused) && rvalue;
+    }
+
+    for (int k = 0; k < L - 1; ++k) {
+        for (int j = 0; j < net->width[k + 1]; ++j) {
+            rvalue = __compare(CHECK_FUSED, trial, "dE/dY", k, j, fused[k][j], net->page[k].de_dy.ptr[j], __tol_fused) &&
+                     rvalue;
+        }
+    }
+
+    net->network.Set_Loss(&net->network, BCE);
+
+    return rvalue;
+}
+
+static bool __bind_sample(void *ctx, long index, f_vector_t *inputs, f_vector_t *targets) {
+    const check_samples_t *samples = ctx;
+
+    inputs->ptr  = &samples->x[index * samples->N];
+    targets->ptr = &samples->t[index * samples->P];
+
+    return true;
+}
+
+static bool __check_threads(check_net_t *net, const check_config_t *cfg, int trial, g_random_t *random) {
+    const int N = net->width[0];
+    const int P = net->width[net->layers];
+
+    check_samples_t samples = {
+        .x = calloc((size_t)CHECK_SAMPLES * N, sizeof(float)),
+        .t = calloc((size_t)CHECK_SAMPLES * P, sizeof(float)),
+        .N = N,
+        .P = P,
+    };
+
+    int32_t *predicted = calloc(CHECK_SAMPLES, sizeof(int32_t));
+
+    bool rvalue = (samples.x != NULL) && (samples.t != NULL) && (predicted != NULL);
+
+    g_validator_t validator;
+    g_validator_link(&validator);
+
+    if (rvalue) {
+        for (long n = 0; n < CHECK_SAMPLES; ++n) {
+            __net_draw_sample(net, &samples.x[n * N], &samples.t[n * P], random);
+        }
+
+        rvalue = validator.Create(&validator, &net->pages, cfg->threads, 1);
+        rvalue = rvalue && validator.Run(&validator, __bind_sample, &samples, CHECK_SAMPLES, predicted);
+    }
+
+    if (rvalue) {
+        const float *Y = net->page[net->layers - 1].y.ptr;
+
+        double loss = 0.0;
+
+        // the validator's metrics, one sample at a time on the network
+        for (long n = 0; n < CHECK_SAMPLES; ++n) {
+            const float *T = &samples.t[n * P];
+
+            memcpy(net->page[0].x.ptr, &samples.x[n * N], sizeof(float) * N);
+
+            net->network.Step_Forward(&net->network);
+
+            int   y_max  = 0;
+            float sample = 0.0f;
+
+            for (int j = 0; j < P; ++j) {
+                const float e = Y[j] - T[j];
+
+                y_max = (Y[j] > Y[y_max]) ? j : y_max;
+                sample += e * e;
+            }
+
+            loss += sample / P;
+
+            const check_tol_t exact = {0.0, 0.0};
+
+            rvalue = __compare(CHECK_THREADS, trial, "class", net->layers - 1, (int)n, predicted[n], y_max, exact) && rvalue;
+        }
+
+        loss /= CHECK_SAMPLES;
+
+        rvalue = __compare(CHECK_THREADS, trial, "loss", net->layers - 1, 0, validator.loss, loss, __tol_threads) && rvalue;
+        rvalue = __compare(CHECK_THREADS, trial, "samples", net->layers - 1, 0, validator.samples, CHECK_SAMPLES,
+                           __tol_threads) &&
+                 rvalue;
+    } else {
+        printf("[ERROR] Unable to run the validator of trial %d\n", trial);
+    }
+
+    validator.Destroy(&validator);
+
+    free(samples.x);
+    free(samples.t);
+    free(predicted);
+
+    return rvalue;
+}
+
+// -----------------------------------------------------------------------------
+
+static bool __run_trial(const check_config_t *cfg, int trial, g_random_t *random, check_ref_t *ref, float *w_start) {
+    check_net_t net;
+
+    if (!__net_init(&net, trial, random)) {
+        return false;
+    }
+
+    const int   L = net.layers;
+    f_vector_t  targets = {net.targets, net.width[L]};
+
+    // inputs away from the breaks of the piecewise activations
+    __ref_load(ref, &net);
+
+    int draws = 0;
+    do {
+        __net_draw_sample(&net, net.page[0].x.ptr, net.targets, random);
+        __ref_forward(ref, &net);
+    } while ((__ref_kink(ref, &net) < CHECK_KINK) && (++draws < CHECK_DRAWS));
+
+    if (draws == CHECK_DRAWS) {
+        if (cfg->verbose) {
+            printf("[INFO] trial %d skipped, no input away from the activation breaks\n", trial);
+        }
+
+        __net_free(&net);
+        return true;
+    }
+
+    __coverage[net.af_type[L - 1]]++;
+
+    bool rvalue = true;
+
+    rvalue = __check_clone(&net, trial) && rvalue;
+
+    if ((net.af_type[L - 1] == SIGMOID) && (net.loss_type == BCE)) {
+        rvalue = __check_fused(&net, trial) && rvalue;
+    }
+
+    rvalue = __check_threads(&net, cfg, trial, random) && rvalue;
+
+    // the sample drawn above, the validator check overwrote the inputs
+    for (int i = 0; i < net.width[0]; ++i) {
+        net.page[0].x.ptr[i] = (float)ref->x[0][i];
+    }
+
+    size_t len = 0;
+    for (int k = 0; k < L; ++k) {
+        memcpy(&w_start[len], net.page[k].w.ptr, sizeof(float) * net.page[k].w.row * net.page[k].w.col);
+        len += (size_t)net.page[k].w.row * net.page[k].w.col;
+    }
+
+    bool compare_update = true;
+
+    for (int step = 0; step < CHECK_STEPS; ++step) {
+        net.network.Step_Forward(&net.network);
+        __ref_forward(ref, &net);
+
+        // an update can move a piecewise input onto its break
+        compare_update = compare_update && (__ref_kink(ref, &net) >= CHECK_KINK * 1e-2);
+
+        if (step == 0) {
+            rvalue = __check_forward(&net, ref, trial) && rvalue;
+        }
+
+        net.network.Step_Errors(&net.network, &targets);
+        __ref_errors(ref, &net);
+
+        if (step == 0) {
+            rvalue = __check_errors(&net, ref, trial) && rvalue;
+            rvalue = __check_gradient(&net, ref, trial, random) && rvalue;
+        }
+
+        net.network.Step_Backward(&net.network);
+        __ref_update(ref, &net);
+    }
+
+    if (compare_update) {
+        rvalue = __check_update(&net, ref, w_start, trial) && rvalue;
+    }
+
+    if (cfg->verbose) {
+        printf("[INFO] trial %3d: %d layers", trial, L);
+        for (int k = 0; k < L; ++k) {
+            printf(" %d:%s", net.width[k + 1], __activation_names[net.af_type[k]]);
+        }
+        printf(" (%d inputs), %s, %s: %s\n", net.width[0], __optimizer_names[net.op_type], __loss_names[net.loss_type],
+               rvalue ? "ok" : "FAILED");
+    }
+
+    __net_free(&net);
+
+    return rvalue;
+}
+
+static void __usage(const char *name) {
+    fprintf(stderr, "Usage: %s [options]\n", name);
+    fprintf(stderr, "Options:\n");
+    fprintf(stderr, "  --trials <n>   Random networks checked (default: 200)\n");
+    fprintf(stderr, "  --seed <n>     Seed of the draws (default: 12345)\n");
+    fprintf(stderr, "  --threads <n>  Validator workers (default: 4)\n");
+    fprintf(stderr, "  --verbose      One line per trial\n");
+}
+
+// -----------------------------------------------------------------------------
+// Main Entry Point
+// -----------------------------------------------------------------------------
+
+int main(int argc, char *argv[]) {
+    check_config_t cfg = {
+        .trials  = 200,
+        .seed    = 12345u,
+        .threads = 4,
+        .verbose = false,
+    };
+
+    for (int i = 1; i < argc; i++) {
+        const bool has_value = i + 1 < argc;
+
+        bool ok = true;
+
+        if (strcmp(argv[i], "--verbose") == 0) {
+            cfg.verbose = true;
+        } else if (has_value && (strcmp(argv[i], "--trials") == 0)) {
+            cfg.trials = atoi(argv[++i]);
+            ok         = cfg.trials > 0;
+        } else if (has_value && (strcmp(argv[i], "--seed") == 0)) {
+            cfg.seed = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (has_value && (strcmp(argv[i], "--threads") == 0)) {
+            cfg.threads = atoi(argv[++i]);
+            ok          = cfg.threads > 0;
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            __usage(argv[0]);
+            return 1;
+        }
+    }
+
+    check_ref_t *ref = calloc(1, sizeof(check_ref_t));
+
+    // weights of a whole network before training
+    float *w_start = calloc((size_t)CHECK_MAX_LAYERS * CHECK_MAX_WIDTH * (CHECK_MAX_WIDTH + 1), sizeof(float));
+
+    if ((ref == NULL) || (w_start == NULL)) {
+        printf("[ERROR] Unable to allocate the reference\n");
+        free(ref);
+        free(w_start);
+        return 1;
+    }
+
+    g_random_t random;
+    g_random_init(&random, cfg.seed, 0);
+
+    bool rvalue = true;
+
+    for (int trial = 0; trial < cfg.trials; ++trial) {
+        rvalue = __run_trial(&cfg, trial, &random, ref, w_start) && rvalue;
+    }
+
+    for (int kind = 0; kind < CHECK_KINDS; ++kind) {
+        const check_stat_t *stat = &__stats[kind];
+
+        printf("[INFO] %-8s %9ld values, %6ld mismatches, worst %.3f of the tolerance\n",
+               __kind_names[kind],
+               stat->values,
+               stat->failures,
+               stat->worst);
+    }
+
+    printf("[INFO] Output activations:");
+    for (int a = 0; a < 10; ++a) {
+        printf(" %s %ld", __activation_names[a], __coverage[a]);
+    }
+    printf("\n");
+
+    printf("%s\n", rvalue ? "[INFO] All checks passed" : "[ERROR] Some checks failed");
+
+    free(ref);
+    free(w_start);
+
+    return rvalue ? 0 : 1;
+}
+
+// -----------------------------------------------------------------------------
+// End of File
@@ -0,0 +1,191 @@
+// -----------------------------------------------------------------------------
+// @file data_cache.c
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#include "data_cache.h"
+
+#include <errno.h>    // errno
+#include <limits.h>   // PATH_MAX
+#include <stdio.h>    // FILE, fflush, fileno, fopen, fwrite, printf, remove, rename, snprintf
+#include <stdlib.h>   // free, malloc, mkstemp, realpath
+#include <string.h>   // memcmp, memcpy, memset, strerror, strlen
+#include <sys/stat.h> // fchmod, stat
+#include <unistd.h>   // close, fsync
+
+#include "data_reader.h"
+#include "data_writer.h"
+
+// -----------------------------------------------------------------------------
+
+static bool __source_key(const char *filename, int values_len, data_cache_key_t *key) {
+    struct stat st;
+    if (stat(filename, &st) != 0) {
+        return false;
+    }
+
+    char path[PATH_MAX];
+    if (realpath(filename, path) == NULL) {
+        return false;
+    }
+
+    // FNV-1a, 64-bit
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (const char *p = path; *p != '\0'; ++p) {
+        hash ^= (unsigned char)*p;
+        hash *= 0x100000001B3ull;
+    }
+
+    memset(key, 0, sizeof(*key));
+    memcpy(key->magic, DATA_CACHE_MAGIC, sizeof(key->magic));
+
+    key->version     = DATA_CACHE_VERSION;
+    key->values_len  = (uint32_t)values_len;
+    key->path_hash   = hash;
+    key->source_size = (uint64_t)st.st_size;
+    key->source_sec  = (int64_t)st.st_mtim.tv_sec;
+    key->source_nsec = (int64_t)st.st_mtim.tv_nsec;
+
+    return true;
+}
+
+static bool __cache_check(data_mapper_t *map, const data_cache_key_t *key) {
+    const size_t records = map->header.data_offset + map->header.samples * map->header.stride;
+
+    if ((map->header.x_len != key->values_len) || (map->header.t_len != 0)) {
+        return false;
+    }
+
+    // the key trails the records
+    if (records + sizeof(data_cache_key_t) != map->size) {
+        return false;
+    }
+
+    return memcmp(map->base + records, key, sizeof(data_cache_key_t)) == 0;
+}
+
+static bool __cache_build(const char *filename, const char *cache_filename, const data_cache_key_t *key) {
+    const int values_len = (int)key->values_len;
+
+    const size_t tmp_len = strlen(cache_filename) + sizeof(".XXXXXX");
+    char        *tmp     = malloc(tmp_len);
+    float       *values  = malloc(sizeof(float) * values_len);
+
+    if (tmp == NULL || values == NULL) {
+        free(tmp);
+        free(values);
+        return false;
+    }
+
+    // written next to the final name and renamed, readers never see a partial
+    // cache; the name is unique, so concurrent builders never share the file
+    snprintf(tmp, tmp_len, "%s.XXXXXX", cache_filename);
+
+    const int fd = mkstemp(tmp);
+    if (fd < 0) {
+        printf("[ERROR] Unable to create file '%s': %s\n", tmp, strerror(errno));
+        free(tmp);
+        free(values);
+        return false;
+    }
+
+    (void)fchmod(fd, 0644); // mkstemp creates it private
+    close(fd);
+
+    data_reader_t *reader = data_reader_open(filename);
+    data_writer_t *writer = data_writer_open_binary(tmp, values_len);
+
+    bool rvalue = (reader != NULL) && (writer != NULL);
+
+    while (rvalue && data_reader_next_values(reader, values, values_len)) {
+        rvalue = data_writer_next_values(writer, values, values_len);
+    }
+
+    // a malformed line stops the loop like the end of the file does
+    if (rvalue && !data_reader_at_end(reader)) {
+        printf("[ERROR] Dataset cache not built, '%s' is malformed\n", filename);
+        rvalue = false;
+    }
+
+    rvalue = rvalue && data_writer_flush(writer);
+
+    data_writer_close(&writer);
+    data_reader_close(&reader);
+
+    if (rvalue) {
+        FILE *file = fopen(tmp, "ab");
+
+        rvalue = (file != NULL) && (fwrite(key, sizeof(data_cache_key_t), 1, file) == 1);
+        rvalue = rvalue && (fflush(file) == 0) && (fsync(fileno(file)) == 0);
+
+        if (file != NULL) {
+            rvalue = (fclose(file) == 0) && rvalue;
+        }
+    }
+
+    if (rvalue && rename(tmp, cache_filename) != 0) {
+        printf("[ERROR] Unable to rename '%s': %s\n", tmp, strerror(errno));
+        rvalue = false;
+    }
+
+    if (!rvalue) {
+        remove(tmp);
+    }
+
+    free(tmp);
+    free(values);
+
+    return rvalue;
+}
+
+bool data_cache_open(data_mapper_t *map, const char *filename, int values_len) {
+    if (map == NULL || filename == NULL || values_len <= 0) {
+        printf("[ERROR] Invalid arguments for cache open\n");
+        return false;
+    }
+
+    memset(map, 0, sizeof(*map));
+    map->fd = -1;
+
+    data_cache_key_t key;
+    if (!__source_key(filename, values_len, &key)) {
+        return false;
+    }
+
+    const size_t len            = strlen(filename) + sizeof(DATA_CACHE_SUFFIX);
+    char        *cache_filename = malloc(len);
+
+    if (cache_filename == NULL) {
+        return false;
+    }
+
+    snprintf(cache_filename, len, "%s%s", filename, DATA_CACHE_SUFFIX);
+
+    bool rvalue = data_mapper_probe(cache_filename) //
+                  && data_mapper_open(map, cache_filename)
+                  && __cache_check(map, &key);
+
+    if (!rvalue) {
+        data_mapper_close(map);
+
+        printf("[ALERT] Building dataset cache '%s'...\n", cache_filename);
+
+        rvalue = __cache_build(filename, cache_filename, &key) //
+                 && data_mapper_open(map, cache_filename)
+                 && __cache_check(map, &key);
+
+        if (!rvalue) {
+            data_mapper_close(map);
+        }
+    }
+
+    free(cache_filename);
+
+    return rvalue;
+}
+
+// -----------------------------------------------------------------------------
+// End of File
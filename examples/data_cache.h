@@ -0,0 +1,49 @@
+// -----------------------------------------------------------------------------
+// @file data_cache.h
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#ifndef DATA_CACHE_H
+#define DATA_CACHE_H
+
+#include <stdbool.h> // bool
+#include <stdint.h>  // int64_t, uint32_t, uint64_t
+
+#include "data_mapper.h" // data_mapper_t
+
+// -----------------------------------------------------------------------------
+/*
+ * Sidecar "<file>.cache" holding the parsed floats of a text file as a
+ * binary dataset (inputs only), followed by a key that identifies the source:
+ *
+ *   [data_mapper image][data_cache_key_t]
+ *
+ * The cache is reused only when path, size, mtime and vector length all
+ * match; otherwise it is rebuilt from the text file.
+ */
+
+#define DATA_CACHE_MAGIC   "GFNNCKEY"
+#define DATA_CACHE_VERSION 1
+#define DATA_CACHE_SUFFIX  ".cache"
+
+typedef struct data_cache_key_t {
+    char     magic[8];    // DATA_CACHE_MAGIC
+    uint32_t version;     // DATA_CACHE_VERSION
+    uint32_t values_len;  // floats per line
+    uint64_t path_hash;   // FNV-1a of the resolved source path
+    uint64_t source_size; // bytes of the source file
+    int64_t  source_sec;  // mtime of the source file (seconds)
+    int64_t  source_nsec; // mtime of the source file (nanoseconds)
+} data_cache_key_t;
+
+// -----------------------------------------------------------------------------
+
+bool data_cache_open(data_mapper_t *map, const char *filename, int values_len);
+
+#endif // DATA_CACHE_H
+
+// -----------------------------------------------------------------------------
+// End of File
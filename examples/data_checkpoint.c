@@ -0,0 +1,347 @@
+// -----------------------------------------------------------------------------
+// @file data_checkpoint.c
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#include "data_checkpoint.h"
+
+#include <errno.h>  // errno, EINTR
+#include <fcntl.h>  // open, O_CREAT, O_RDONLY, O_TRUNC, O_WRONLY
+#include <stdio.h>  // printf, remove, rename, snprintf
+#include <stdlib.h> // free, malloc, realloc
+#include <string.h> // memcmp, memcpy, memset, strerror, strlen
+#include <unistd.h> // close, fsync, read, write
+
+#include "g_trace.h" // G_TRACE_BEGIN, G_TRACE_END, g_trace_thread_name
+
+// -----------------------------------------------------------------------------
+
+static uint64_t __checksum(const unsigned char *ptr, size_t len) {
+    // FNV-1a, 64-bit
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < len; ++i) {
+        hash ^= ptr[i];
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+static bool __write_all(int fd, const void *ptr, size_t len) {
+    const char *p = ptr;
+
+    while (len > 0) {
+        const ssize_t n = write(fd, p, len);
+
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+
+        p += n;
+        len -= (size_t)n;
+    }
+
+    return true;
+}
+
+static bool __read_all(int fd, void *ptr, size_t len) {
+    char *p = ptr;
+
+    while (len > 0) {
+        const ssize_t n = read(fd, p, len);
+
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+
+        p += n;
+        len -= (size_t)n;
+    }
+
+    return true;
+}
+
+static bool __write_file(data_checkpoint_t *cp) {
+    data_checkpoint_header_t header;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, DATA_CHECKPOINT_MAGIC, sizeof(header.magic));
+
+    header.version      = DATA_CHECKPOINT_VERSION;
+    header.payload_size = cp->stage_len;
+    header.checksum     = __checksum(cp->stage, cp->stage_len);
+
+    const int fd = open(cp->tmp_filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        printf("[ERROR] Unable to open file '%s': %s\n", cp->tmp_filename, strerror(errno));
+        return false;
+    }
+
+    bool rvalue = __write_all(fd, &header, sizeof(header)) && __write_all(fd, cp->stage, cp->stage_len);
+
+    // durable before it replaces the previous checkpoint
+    rvalue = rvalue && (fsync(fd) == 0);
+    rvalue = (close(fd) == 0) && rvalue;
+
+    if (rvalue && rename(cp->tmp_filename, cp->filename) != 0) {
+        printf("[ERROR] Unable to rename '%s': %s\n", cp->tmp_filename, strerror(errno));
+        rvalue = false;
+    }
+
+    if (!rvalue) {
+        remove(cp->tmp_filename);
+    }
+
+    return rvalue;
+}
+
+static void *__writer(void *arg) {
+    data_checkpoint_t *cp = arg;
+
+    g_trace_thread_name("checkpoint");
+
+    pthread_mutex_lock(&cp->lock);
+
+    while (true) {
+        while (!cp->pending && !cp->stop) {
+            pthread_cond_wait(&cp->cond, &cp->lock);
+        }
+
+        if (!cp->pending) {
+            break; // stop, nothing left to write
+        }
+
+        // the stage buffer is not touched by the compute loop while pending
+        pthread_mutex_unlock(&cp->lock);
+
+        G_TRACE_BEGIN(t0);
+
+        const bool rvalue = __write_file(cp);
+
+        G_TRACE_END(t0, "checkpoint write", "checkpoint");
+
+        pthread_mutex_lock(&cp->lock);
+
+        if (rvalue) {
+            cp->written++;
+        } else {
+            atomic_store(&cp->failed, true);
+        }
+
+        cp->pending = false;
+        pthread_cond_broadcast(&cp->cond);
+    }
+
+    pthread_mutex_unlock(&cp->lock);
+
+    return NULL;
+}
+
+bool data_checkpoint_open(data_checkpoint_t *cp, const char *filename) {
+    if (cp == NULL || filename == NULL) {
+        printf("[ERROR] Invalid arguments for checkpoint open\n");
+        return false;
+    }
+
+    memset(cp, 0, sizeof(*cp));
+
+    atomic_init(&cp->failed, false);
+
+    const size_t len = strlen(filename);
+
+    cp->filename     = malloc(len + 1);
+    cp->tmp_filename = malloc(len + 5);
+
+    if (cp->filename == NULL || cp->tmp_filename == NULL) {
+        printf("[ERROR] Unable to allocate checkpoint '%s'\n", filename);
+        free(cp->filename);
+        free(cp->tmp_filename);
+        cp->filename     = NULL;
+        cp->tmp_filename = NULL;
+        return false;
+    }
+
+    memcpy(cp->filename, filename, len + 1);
+    snprintf(cp->tmp_filename, len + 5, "%s.tmp", filename);
+
+    pthread_mutex_init(&cp->lock, NULL);
+    pthread_cond_init(&cp->cond, NULL);
+
+    cp->thread_ok = pthread_create(&cp->thread, NULL, __writer, cp) == 0;
+    if (!cp->thread_ok) {
+        printf("[ERROR] Unable to start checkpoint thread\n");
+        data_checkpoint_close(cp);
+        return false;
+    }
+
+    return true;
+}
+
+bool data_checkpoint_close(data_checkpoint_t *cp) {
+    if (cp == NULL || cp->filename == NULL) {
+        return false;
+    }
+
+    if (cp->thread_ok) {
+        pthread_mutex_lock(&cp->lock);
+        cp->stop = true;
+        pthread_cond_signal(&cp->cond);
+        pthread_mutex_unlock(&cp->lock);
+
+        pthread_join(cp->thread, NULL);
+
+        cp->thread_ok = false;
+    }
+
+    pthread_mutex_destroy(&cp->lock);
+    pthread_cond_destroy(&cp->cond);
+
+    free(cp->filename);
+    free(cp->tmp_filename);
+    free(cp->build);
+    free(cp->stage);
+
+    cp->filename     = NULL;
+    cp->tmp_filename = NULL;
+    cp->build        = NULL;
+    cp->stage        = NULL;
+
+    return !atomic_load(&cp->failed);
+}
+
+void data_checkpoint_begin(data_checkpoint_t *cp) {
+    if (cp != NULL) {
+        cp->build_len = 0;
+    }
+}
+
+bool data_checkpoint_append(data_checkpoint_t *cp, const void *ptr, size_t len) {
+    if (cp == NULL || (ptr == NULL && len > 0)) {
+        printf("[ERROR] Invalid arguments for checkpoint append\n");
+        return false;
+    }
+
+    if (cp->build_cap - cp->build_len < len) {
+        size_t cap = cp->build_cap > 0 ? cp->build_cap : 4096;
+        while (cap - cp->build_len < len) {
+            cap *= 2;
+        }
+
+        unsigned char *build = realloc(cp->build, cap);
+        if (build == NULL) {
+            printf("[ERROR] Unable to allocate checkpoint buffer\n");
+            return false;
+        }
+
+        cp->build     = build;
+        cp->build_cap = cap;
+    }
+
+    memcpy(cp->build + cp->build_len, ptr, len);
+    cp->build_len += len;
+
+    return true;
+}
+
+bool data_checkpoint_commit(data_checkpoint_t *cp, bool wait) {
+    if (cp == NULL || !cp->thread_ok) {
+        printf("[ERROR] Invalid arguments for checkpoint commit\n");
+        return false;
+    }
+
+    pthread_mutex_lock(&cp->lock);
+
+    while (wait && cp->pending) {
+        pthread_cond_wait(&cp->cond, &cp->lock);
+    }
+
+    if (cp->pending) {
+        cp->skipped++; // the compute loop does not wait for the disk
+    } else {
+        unsigned char *ptr = cp->stage;
+        const size_t   cap = cp->stage_cap;
+
+        cp->stage     = cp->build;
+        cp->stage_len = cp->build_len;
+        cp->stage_cap = cp->build_cap;
+
+        cp->build     = ptr;
+        cp->build_len = 0;
+        cp->build_cap = cap;
+
+        cp->pending = true;
+        pthread_cond_signal(&cp->cond);
+    }
+
+    pthread_mutex_unlock(&cp->lock);
+
+    return !atomic_load(&cp->failed);
+}
+
+bool data_checkpoint_load(data_checkpoint_view_t *view, const char *filename) {
+    if (view == NULL || filename == NULL) {
+        printf("[ERROR] Invalid arguments for checkpoint load\n");
+        return false;
+    }
+
+    memset(view, 0, sizeof(*view));
+
+    const int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        printf("[ERROR] Unable to open file '%s': %s\n", filename, strerror(errno));
+        return false;
+    }
+
+    data_checkpoint_header_t header;
+
+    bool rvalue = __read_all(fd, &header, sizeof(header));
+
+    rvalue = rvalue && (memcmp(header.magic, DATA_CHECKPOINT_MAGIC, sizeof(header.magic)) == 0);
+    rvalue = rvalue && (header.version == DATA_CHECKPOINT_VERSION);
+
+    if (rvalue) {
+        view->ptr = malloc(header.payload_size > 0 ? header.payload_size : 1);
+        view->len = header.payload_size;
+
+        rvalue = (view->ptr != NULL) && __read_all(fd, view->ptr, view->len);
+        rvalue = rvalue && (__checksum(view->ptr, view->len) == header.checksum);
+    }
+
+    close(fd);
+
+    if (!rvalue) {
+        printf("[ERROR] Invalid checkpoint '%s'\n", filename);
+        data_checkpoint_release(view);
+    }
+
+    return rvalue;
+}
+
+bool data_checkpoint_read(data_checkpoint_view_t *view, void *ptr, size_t len) {
+    if (view == NULL || view->ptr == NULL || view->len - view->off < len) {
+        return false;
+    }
+
+    memcpy(ptr, view->ptr + view->off, len);
+    view->off += len;
+
+    return true;
+}
+
+void data_checkpoint_release(data_checkpoint_view_t *view) {
+    if (view != NULL) {
+        free(view->ptr);
+        memset(view, 0, sizeof(*view));
+    }
+}
+
+// -----------------------------------------------------------------------------
+// End of File
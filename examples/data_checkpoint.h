@@ -0,0 +1,97 @@
+// -----------------------------------------------------------------------------
+// @file data_checkpoint.h
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#ifndef DATA_CHECKPOINT_H
+#define DATA_CHECKPOINT_H
+
+#include <pthread.h>   // pthread_cond_t, pthread_mutex_t, pthread_t
+#include <stdatomic.h> // atomic_bool
+#include <stdbool.h>   // bool
+#include <stddef.h>    // size_t
+#include <stdint.h>    // uint32_t, uint64_t
+
+// -----------------------------------------------------------------------------
+/*
+ * Crash-safe checkpoint file:
+ *
+ *   [data_checkpoint_header_t][payload]
+ *
+ * The compute loop serializes its state into an in-memory payload (Begin,
+ * Append) and Commit hands it to a writer thread by swapping two buffers. The
+ * thread writes "<file>.tmp", syncs it and renames it over the checkpoint, so
+ * the file on disk is always the last complete one. A commit made while the
+ * previous one is still being written is dropped (counted in skipped) unless
+ * the caller asks to wait, as for the last one of a run. The payload layout
+ * belongs to the caller; a checksum rejects torn or foreign files on load.
+ */
+
+#define DATA_CHECKPOINT_MAGIC   "GFNNCKPT"
+#define DATA_CHECKPOINT_VERSION 1
+
+typedef struct data_checkpoint_header_t {
+    char     magic[8];     // DATA_CHECKPOINT_MAGIC
+    uint32_t version;      // DATA_CHECKPOINT_VERSION
+    uint32_t reserved;     // zero
+    uint64_t payload_size; // bytes after the header
+    uint64_t checksum;     // FNV-1a of the payload
+} data_checkpoint_header_t;
+
+typedef struct data_checkpoint_t {
+    char *filename;
+    char *tmp_filename;
+
+    // payload being serialized by the compute loop
+    unsigned char *build;
+    size_t         build_len;
+    size_t         build_cap;
+
+    // payload owned by the writer thread while pending
+    unsigned char *stage;
+    size_t         stage_len;
+    size_t         stage_cap;
+
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+    pthread_t       thread;
+    bool            thread_ok;
+    bool            pending;
+    bool            stop;
+    atomic_bool     failed;
+
+    long written; // checkpoints on disk
+    long skipped; // commits dropped while busy
+} data_checkpoint_t;
+
+typedef struct data_checkpoint_view_t {
+    unsigned char *ptr; // payload, owned
+    size_t         len;
+    size_t         off; // next byte to read
+} data_checkpoint_view_t;
+
+// -----------------------------------------------------------------------------
+
+bool data_checkpoint_open(data_checkpoint_t *cp, const char *filename);
+
+bool data_checkpoint_close(data_checkpoint_t *cp);
+
+void data_checkpoint_begin(data_checkpoint_t *cp);
+
+bool data_checkpoint_append(data_checkpoint_t *cp, const void *ptr, size_t len);
+
+bool data_checkpoint_commit(data_checkpoint_t *cp, bool wait);
+
+bool data_checkpoint_load(data_checkpoint_view_t *view, const char *filename);
+
+bool data_checkpoint_read(data_checkpoint_view_t *view, void *ptr, size_t len);
+
+void data_checkpoint_release(data_checkpoint_view_t *view);
+
+#endif // DATA_CHECKPOINT_H
+
+// -----------------------------------------------------------------------------
+// End of File
@@ -0,0 +1,390 @@
+// -----------------------------------------------------------------------------
+// @file data_export.c
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#include "data_export.h"
+
+#include <ctype.h>  // isalnum, isdigit, toupper
+#include <errno.h>  // errno
+#include <math.h>   // isfinite
+#include <stdio.h>  // FILE, fclose, ferror, fopen, fprintf, printf, snprintf
+#include <stdlib.h> // free, malloc
+#include <string.h> // strerror, strlen, strpbrk, strrchr
+#include <time.h>   // localtime, strftime, time
+
+// -----------------------------------------------------------------------------
+
+static const char *__activation_names[] = {
+    "linear", "tanh", "relu", "leaky_relu", "prelu", "swish", "elu", "softplus", "sigmoid", "softmax",
+};
+
+// float literal that reads back as the same float
+static const char *__literal(char *text, size_t len, float value) {
+    int n = snprintf(text, len - 3, "%.9g", value);
+
+    if (strpbrk(text, ".e") == NULL) {
+        text[n++] = '.';
+        text[n++] = '0';
+    }
+
+    text[n++] = 'f';
+    text[n]   = '\0';
+
+    return text;
+}
+
+static bool __check_pages(const g_pages_t *pages) {
+    if ((pages == NULL) || (pages->ptr == NULL) || (pages->len < 1)) {
+        printf("[ERROR] Invalid pages for export\n");
+        return false;
+    }
+
+    for (int k = 0; k < pages->len; ++k) {
+        const g_page_t *page = &pages->ptr[k];
+
+        const size_t W = (size_t)page->w.row * page->w.col;
+
+        if ((page->w.ptr == NULL) || (page->w.col != page->x.len + 1) || (page->w.row != page->y.len) ||
+            (page->af_type < LINEAR) || (page->af_type > SOFTMAX)) {
+            printf("[ERROR] Layer %d can not be exported\n", k);
+            return false;
+        }
+
+        if (((page->af_type == LEAKY_RELU) || (page->af_type == ELU)) && (page->af_args.len < 1)) {
+            printf("[ERROR] Layer %d has no activation slope\n", k);
+            return false;
+        }
+
+        if ((page->af_type == PRELU) && (page->af_args.len != page->y.len)) {
+            printf("[ERROR] Layer %d has no slope per neuron\n", k);
+            return false;
+        }
+
+        for (size_t i = 0; i < W; ++i) {
+            if (!isfinite(page->w.ptr[i])) {
+                printf("[ERROR] Layer %d has a non-finite weight\n", k);
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// file name of base, without directories, as a C identifier
+static void __symbol_name(char *name, char *macro, const char *base) {
+    const char *file = strrchr(base, '/');
+    file             = (file != NULL) ? file + 1 : base;
+
+    int n = 0;
+
+    if (isdigit((unsigned char)file[0])) {
+        name[n++] = '_';
+    }
+
+    for (; (*file != '\0') && (n < DATA_EXPORT_NAME_MAX - 1); ++file) {
+        name[n++] = isalnum((unsigned char)*file) ? *file : '_';
+    }
+
+    if (n == 0) {
+        name[n++] = '_';
+    }
+
+    name[n] = '\0';
+
+    for (int i = 0; i <= n; ++i) {
+        macro[i] = (char)toupper((unsigned char)name[i]);
+    }
+}
+
+static void __write_banner(FILE *file, const char *filename) {
+    char date[32] = {0};
+
+    const time_t now = time(NULL);
+    strftime(date, sizeof(date), "%B, %Y", localtime(&now));
+
+    fprintf(file, "// -----------------------------------------------------------------------------\n");
+    fprintf(file, "// @file %s\n", filename);
+    fprintf(file, "//\n");
+    fprintf(file, "// @date %s\n", date);
+    fprintf(file, "//\n");
+    fprintf(file, "// @author Generated by data_export_c\n");
+    fprintf(file, "// -----------------------------------------------------------------------------\n\n");
+}
+
+static void __write_trailer(FILE *file) {
+    fprintf(file, "\n// -----------------------------------------------------------------------------\n");
+    fprintf(file, "// End of File\n");
+}
+
+static void __write_header(FILE *file, const g_pages_t *pages, const char *filename, const char *name,
+                           const char *macro) {
+    __write_banner(file, filename);
+
+    fprintf(file, "#ifndef %s_H\n", macro);
+    fprintf(file, "#define %s_H\n\n", macro);
+
+    fprintf(file, "#define %s_INPUTS  %d\n", macro, pages->ptr[0].x.len);
+    fprintf(file, "#define %s_OUTPUTS %d\n\n", macro, pages->ptr[pages->len - 1].y.len);
+
+    fprintf(file, "#ifdef __cplusplus\n");
+    fprintf(file, "extern \"C\" {\n");
+    fprintf(file, "#endif\n\n");
+
+    fprintf(file, "// no allocation and no global state: reentrant\n");
+    fprintf(file, "void %s_forward(const float x[%s_INPUTS], float y[%s_OUTPUTS]);\n\n", name, macro, macro);
+
+    fprintf(file, "#ifdef __cplusplus\n");
+    fprintf(file, "}\n");
+    fprintf(file, "#endif\n\n");
+
+    fprintf(file, "#endif // %s_H\n", macro);
+
+    __write_trailer(file);
+}
+
+static void __write_weights(FILE *file, const g_page_t *page, const char *name, int k) {
+    char text[48];
+
+    fprintf(file, "// layer %d: %d -> %d, %s\n", k, page->x.len, page->y.len, __activation_names[page->af_type]);
+    fprintf(file, "static const float %s_w%d[%d][%d] = {\n", name, k, page->w.row, page->w.col);
+
+    for (int j = 0; j < page->w.row; ++j) {
+        const float *W = page->w.ptr + (size_t)j * page->w.col;
+
+        fprintf(file, "    {");
+        for (int i = 0; i < page->w.col; ++i) {
+            fprintf(file, "%s%s", (i > 0) ? ", " : "", __literal(text, sizeof(text), W[i]));
+        }
+        fprintf(file, "},\n");
+    }
+
+    fprintf(file, "};\n");
+
+    if (page->af_type == PRELU) {
+        fprintf(file, "static const float %s_a%d[%d] = {", name, k, page->y.len);
+        for (int j = 0; j < page->y.len; ++j) {
+            fprintf(file, "%s%s", (j > 0) ? ", " : "", __literal(text, sizeof(text), page->af_args.ptr[j]));
+        }
+        fprintf(file, "};\n");
+    }
+
+    fprintf(file, "\n");
+}
+
+// the runtime's expression of every activation, on the local z
+static void __write_activation(FILE *file, const g_page_t *page, const char *name, int k, const char *dst) {
+    char alpha[48] = "0.0f";
+
+    if (page->af_args.len > 0) {
+        __literal(alpha, sizeof(alpha), page->af_args.ptr[0]);
+    }
+
+    switch (page->af_type) {
+        case TANH: {
+            fprintf(file, "        %s[j] = tanhf(z);\n", dst);
+        } break;
+
+        case RELU: {
+            fprintf(file, "        %s[j] = (z > 0.0f) ? z : 0.0f;\n", dst);
+        } break;
+
+        case LEAKY_RELU: {
+            fprintf(file, "        %s[j] = (z > 0.0f) ? z : %s * z;\n", dst, alpha);
+        } break;
+
+        case PRELU: {
+            fprintf(file, "        %s[j] = (z > 0.0f) ? z : %s_a%d[j] * z;\n", dst, name, k);
+        } break;
+
+        case SWISH: {
+            fprintf(file, "        %s[j] = z * (1.0f / (1.0f + expf(-z)));\n", dst);
+        } break;
+
+        case ELU: {
+            fprintf(file, "        %s[j] = (z > 0.0f) ? z : %s * (expf(z) - 1.0f);\n", dst, alpha);
+        } break;
+
+        case SOFTPLUS: {
+            fprintf(file, "        %s[j] = logf(1.0f + expf(z));\n", dst);
+        } break;
+
+        case SIGMOID: {
+            fprintf(file, "        %s[j] = 1.0f / (1.0f + expf(-z));\n", dst);
+        } break;
+
+        default: { // linear, and softmax normalized after the loop
+            fprintf(file, "        %s[j] = z;\n", dst);
+        } break;
+    }
+}
+
+static void __write_source(FILE *file, const g_pages_t *pages, const char *filename, const char *header,
+                           const char *name, const char *macro) {
+    const int L = pages->len;
+
+    bool uses_exp  = false;
+    bool uses_tanh = false;
+    bool uses_log  = false;
+
+    for (int k = 0; k < L; ++k) {
+        const g_act_func_type_t af_type = pages->ptr[k].af_type;
+
+        uses_exp  = uses_exp || (af_type == SWISH) || (af_type == ELU) || (af_type == SOFTPLUS) ||
+                   (af_type == SIGMOID) || (af_type == SOFTMAX);
+        uses_tanh = uses_tanh || (af_type == TANH);
+        uses_log  = uses_log || (af_type == SOFTPLUS);
+    }
+
+    __write_banner(file, filename);
+
+    fprintf(file, "#include \"%s\"\n\n", header);
+
+    if (uses_exp || uses_tanh || uses_log) {
+        fprintf(file, "#include <math.h> //%s%s%s\n\n", uses_exp ? " expf" : "", uses_log ? " logf" : "",
+                uses_tanh ? " tanhf" : "");
+    }
+
+    fprintf(file, "// -----------------------------------------------------------------------------\n\n");
+
+    for (int k = 0; k < L; ++k) {
+        __write_weights(file, &pages->ptr[k], name, k);
+    }
+
+    fprintf(file, "// -----------------------------------------------------------------------------\n\n");
+
+    fprintf(file, "void %s_forward(const float x[%s_INPUTS], float y[%s_OUTPUTS]) {\n", name, macro, macro);
+
+    // hidden layers on the stack
+    for (int k = 0; k < L - 1; ++k) {
+        fprintf(file, "    float h%d[%d];\n", k, pages->ptr[k].y.len);
+    }
+
+    for (int k = 0; k < L; ++k) {
+        const g_page_t *page = &pages->ptr[k];
+
+        const int N = page->x.len;
+        const int P = page->y.len;
+
+        // inputs, hidden layers, outputs
+        char src[16] = "x";
+        char dst[16] = "y";
+
+        if (k > 0) {
+            snprintf(src, sizeof(src), "h%d", k - 1);
+        }
+
+        if (k < L - 1) {
+            snprintf(dst, sizeof(dst), "h%d", k);
+        }
+
+        fprintf(file, "\n    // layer %d: %s\n", k, __activation_names[page->af_type]);
+        fprintf(file, "    for (int j = 0; j < %d; ++j) {\n", P);
+        fprintf(file, "        float z = %s_w%d[j][%d];\n\n", name, k, N);
+        fprintf(file, "        for (int i = 0; i < %d; ++i) {\n", N);
+        fprintf(file, "            z += %s_w%d[j][i] * %s[i];\n", name, k, src);
+        fprintf(file, "        }\n\n");
+
+        __write_activation(file, page, name, k, dst);
+
+        fprintf(file, "    }\n");
+
+        // a scope per softmax layer, the names repeat
+        if (page->af_type == SOFTMAX) {
+            fprintf(file, "\n    {\n");
+            fprintf(file, "        float z_max = %s[0];\n", dst);
+            fprintf(file, "        for (int j = 1; j < %d; ++j) {\n", P);
+            fprintf(file, "            z_max = (%s[j] > z_max) ? %s[j] : z_max;\n", dst, dst);
+            fprintf(file, "        }\n\n");
+            fprintf(file, "        float sum_exp = expf(%s[0] - z_max);\n", dst);
+            fprintf(file, "        for (int j = 1; j < %d; ++j) {\n", P);
+            fprintf(file, "            sum_exp += expf(%s[j] - z_max);\n", dst);
+            fprintf(file, "        }\n\n");
+            fprintf(file, "        for (int j = 0; j < %d; ++j) {\n", P);
+            fprintf(file, "            %s[j] = expf(%s[j] - z_max) / sum_exp;\n", dst, dst);
+            fprintf(file, "        }\n");
+            fprintf(file, "    }\n");
+        }
+    }
+
+    fprintf(file, "}\n");
+
+    __write_trailer(file);
+}
+
+static bool __write_file(const char *path, const char *filename, const g_pages_t *pages, const char *header,
+                         const char *name, const char *macro) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        printf("[ERROR] Unable to open file '%s': %s\n", path, strerror(errno));
+        return false;
+    }
+
+    if (header == NULL) {
+        __write_header(file, pages, filename, name, macro);
+    } else {
+        __write_source(file, pages, filename, header, name, macro);
+    }
+
+    bool rvalue = ferror(file) == 0;
+
+    rvalue = (fclose(file) == 0) && rvalue;
+
+    if (!rvalue) {
+        printf("[ERROR] Unable to write file '%s'\n", path);
+    }
+
+    return rvalue;
+}
+
+// -----------------------------------------------------------------------------
+
+bool data_export_c(const g_pages_t *pages, const char *base) {
+    if ((base == NULL) || (base[0] == '\0')) {
+        printf("[ERROR] Invalid export name\n");
+        return false;
+    }
+
+    if (!__check_pages(pages)) {
+        return false;
+    }
+
+    char name[DATA_EXPORT_NAME_MAX];
+    char macro[DATA_EXPORT_NAME_MAX];
+    __symbol_name(name, macro, base);
+
+    const size_t len = strlen(base) + 3; // ".c" or ".h"
+
+    char *path_h = malloc(len);
+    char *path_c = malloc(len);
+
+    bool rvalue = (path_h != NULL) && (path_c != NULL);
+
+    if (rvalue) {
+        snprintf(path_h, len, "%s.h", base);
+        snprintf(path_c, len, "%s.c", base);
+
+        // the source includes the header by file name, both side by side
+        const char *file_h = strrchr(path_h, '/');
+        const char *file_c = strrchr(path_c, '/');
+        file_h             = (file_h != NULL) ? file_h + 1 : path_h;
+        file_c             = (file_c != NULL) ? file_c + 1 : path_c;
+
+        rvalue = __write_file(path_h, file_h, pages, NULL, name, macro);
+        rvalue = rvalue && __write_file(path_c, file_c, pages, file_h, name, macro);
+    } else {
+        printf("[ERROR] Unable to allocate export paths\n");
+    }
+
+    free(path_h);
+    free(path_c);
+
+    return rvalue;
+}
+
+// -----------------------------------------------------------------------------
+// End of File
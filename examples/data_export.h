@@ -0,0 +1,41 @@
+// -----------------------------------------------------------------------------
+// @file data_export.h
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#ifndef DATA_EXPORT_H
+#define DATA_EXPORT_H
+
+#include <stdbool.h> // bool
+
+#include "g_page.h" // g_pages_t
+
+// -----------------------------------------------------------------------------
+/*
+ * Standalone C inference source for a trained network: "<base>.h" declares
+ *
+ *     void <name>_forward(const float x[<NAME>_INPUTS], float y[<NAME>_OUTPUTS]);
+ *
+ * and "<base>.c" defines it over const weight arrays (read-only data, flash
+ * on a microcontroller), with the activations written inline and the hidden
+ * layers on the stack: no allocation, no global state, no dependency on
+ * g_fnn, and libm only for the activations that need it. The operations run
+ * in the runtime's order, so the outputs match Step_Forward bit for bit
+ * when both are built with the same compiler and libm.
+ *
+ * <name> is the file name of base, made a C identifier.
+ */
+
+#define DATA_EXPORT_NAME_MAX 64 // longest symbol prefix
+
+// -----------------------------------------------------------------------------
+
+bool data_export_c(const g_pages_t *pages, const char *base);
+
+#endif // DATA_EXPORT_H
+
+// -----------------------------------------------------------------------------
+// End of File
@@ -0,0 +1,321 @@
+// -----------------------------------------------------------------------------
+// @file data_index.c
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#include "data_index.h"
+
+#include <errno.h>    // errno, EINTR
+#include <fcntl.h>    // open, O_RDONLY
+#include <stdio.h>    // FILE, fdopen, fflush, fileno, fwrite, fseek, printf, rename, remove, snprintf
+#include <stdlib.h>   // calloc, free, malloc, mkstemp
+#include <string.h>   // memcmp, memcpy, memset, strerror, strlen
+#include <sys/mman.h> // mmap, munmap
+#include <sys/stat.h> // fchmod, fstat, stat
+#include <unistd.h>   // close, fsync, read
+
+// -----------------------------------------------------------------------------
+
+static void __source_identity(const struct stat *st, data_index_header_t *header) {
+    header->source_size = (uint64_t)st->st_size;
+    header->source_sec  = (int64_t)st->st_mtim.tv_sec;
+    header->source_nsec = (int64_t)st->st_mtim.tv_nsec;
+}
+
+static bool __header_check(const data_index_header_t *header, const struct stat *st, size_t size) {
+    data_index_header_t source;
+    __source_identity(st, &source);
+
+    bool rvalue = memcmp(header->magic, DATA_INDEX_MAGIC, sizeof(header->magic)) == 0;
+
+    rvalue = rvalue && (header->version == DATA_INDEX_VERSION);
+    rvalue = rvalue && (header->source_size == source.source_size);
+    rvalue = rvalue && (header->source_sec == source.source_sec);
+    rvalue = rvalue && (header->source_nsec == source.source_nsec);
+    rvalue = rvalue && (sizeof(data_index_header_t) + (header->lines + 1) * sizeof(uint64_t) == size);
+
+    return rvalue;
+}
+
+static char *__index_filename(const char *filename) {
+    const size_t len  = strlen(filename) + sizeof(DATA_INDEX_SUFFIX);
+    char        *name = malloc(len);
+
+    if (name != NULL) {
+        snprintf(name, len, "%s%s", filename, DATA_INDEX_SUFFIX);
+    }
+
+    return name;
+}
+
+static bool __map_index(data_index_t *index, const char *index_filename, const struct stat *source) {
+    index->fd = open(index_filename, O_RDONLY);
+    if (index->fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(index->fd, &st) != 0 || (size_t)st.st_size < sizeof(data_index_header_t)) {
+        return false;
+    }
+
+    index->size = (size_t)st.st_size;
+    index->base = mmap(NULL, index->size, PROT_READ, MAP_PRIVATE, index->fd, 0);
+
+    if (index->base == MAP_FAILED) {
+        index->base = NULL;
+        return false;
+    }
+
+    memcpy(&index->header, index->base, sizeof(data_index_header_t));
+
+    index->offsets = (const uint64_t *)((const char *)index->base + sizeof(data_index_header_t));
+
+    return __header_check(&index->header, source, index->size);
+}
+
+static void __unmap_index(data_index_t *index) {
+    if (index->base != NULL) {
+        munmap(index->base, index->size);
+    }
+
+    if (index->fd >= 0) {
+        close(index->fd);
+    }
+
+    index->fd      = -1;
+    index->base    = NULL;
+    index->size    = 0;
+    index->offsets = NULL;
+}
+
+bool data_index_build(const char *filename, const char *index_filename) {
+    if (filename == NULL || index_filename == NULL) {
+        printf("[ERROR] Invalid arguments for index build\n");
+        return false;
+    }
+
+    const int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        printf("[ERROR] Unable to open file '%s': %s\n", filename, strerror(errno));
+        return false;
+    }
+
+    data_index_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, DATA_INDEX_MAGIC, sizeof(header.magic));
+    header.version = DATA_INDEX_VERSION;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        printf("[ERROR] Unable to stat file '%s': %s\n", filename, strerror(errno));
+        close(fd);
+        return false;
+    }
+    __source_identity(&st, &header);
+
+    // written next to the final name and renamed, readers never see a partial
+    // index; the name is unique, so concurrent builders never share the file
+    const size_t tmp_len = strlen(index_filename) + sizeof(".XXXXXX");
+    char        *tmp     = malloc(tmp_len);
+    char        *buf     = malloc(DATA_READER_BLOCK_SIZE);
+    FILE        *file    = NULL;
+
+    bool rvalue = (tmp != NULL) && (buf != NULL);
+
+    if (rvalue) {
+        snprintf(tmp, tmp_len, "%s.XXXXXX", index_filename);
+
+        const int tmp_fd = mkstemp(tmp);
+
+        if (tmp_fd >= 0) {
+            (void)fchmod(tmp_fd, 0644); // mkstemp creates it private
+
+            file = fdopen(tmp_fd, "wb");
+            if (file == NULL) {
+                close(tmp_fd);
+            }
+        }
+
+        if (file == NULL) {
+            printf("[ERROR] Unable to create file '%s': %s\n", tmp, strerror(errno));
+            rvalue = false;
+        }
+    }
+
+    // room for the header, rewritten with the line count at the end
+    rvalue = rvalue && (fwrite(&header, sizeof(header), 1, file) == 1);
+
+    uint64_t offset     = 0;    // file offset of buf[0]
+    uint64_t line_start = 0;    // offset of the current line
+    bool     line_head  = true; // only blanks seen so far on this line
+    bool     line_done  = false;
+
+    while (rvalue) {
+        const ssize_t n = read(fd, buf, DATA_READER_BLOCK_SIZE);
+
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (n < 0) {
+            printf("[ERROR] Unable to read file '%s': %s\n", filename, strerror(errno));
+            rvalue = false;
+            break;
+        }
+
+        if (n == 0) {
+            break;
+        }
+
+        for (ssize_t i = 0; i < n && rvalue; ++i) {
+            const char c = buf[i];
+
+            if (c == '\n') {
+                line_start = offset + (uint64_t)i + 1;
+                line_head  = true;
+                line_done  = false;
+                continue;
+            }
+
+            if (!line_head || line_done || c == ' ' || c == '\t' || c == '\r') {
+                continue;
+            }
+
+            // first visible character decides: comment or data line
+            line_head = false;
+            line_done = true;
+
+            if (c != '#') {
+                rvalue = fwrite(&line_start, sizeof(uint64_t), 1, file) == 1;
+                header.lines++;
+            }
+        }
+
+        offset += (uint64_t)n;
+    }
+
+    // end marker: the last line runs up to the end of the file
+    rvalue = rvalue && (fwrite(&offset, sizeof(uint64_t), 1, file) == 1);
+
+    rvalue = rvalue && (fseek(file, 0, SEEK_SET) == 0);
+    rvalue = rvalue && (fwrite(&header, sizeof(header), 1, file) == 1);
+    rvalue = rvalue && (fflush(file) == 0) && (fsync(fileno(file)) == 0);
+
+    if (file != NULL) {
+        rvalue = (fclose(file) == 0) && rvalue;
+    }
+
+    if (rvalue && offset != header.source_size) {
+        printf("[ERROR] File '%s' changed while indexing\n", filename);
+        rvalue = false;
+    }
+
+    if (rvalue && rename(tmp, index_filename) != 0) {
+        printf("[ERROR] Unable to rename '%s': %s\n", tmp, strerror(errno));
+        rvalue = false;
+    }
+
+    if (!rvalue && file != NULL) { // the temporary file was created
+        remove(tmp);
+    }
+
+    free(buf);
+    free(tmp);
+    close(fd);
+
+    return rvalue;
+}
+
+bool data_index_open(data_index_t *index, const char *filename, int values_len) {
+    if (index == NULL || filename == NULL || values_len <= 0) {
+        printf("[ERROR] Invalid arguments for index open\n");
+        return false;
+    }
+
+    memset(index, 0, sizeof(*index));
+    index->fd         = -1;
+    index->values_len = values_len;
+
+    struct stat st;
+    if (stat(filename, &st) != 0) {
+        printf("[ERROR] Unable to stat file '%s': %s\n", filename, strerror(errno));
+        return false;
+    }
+
+    char *index_filename = __index_filename(filename);
+    if (index_filename == NULL) {
+        return false;
+    }
+
+    bool rvalue = __map_index(index, index_filename, &st);
+
+    if (!rvalue) {
+        __unmap_index(index);
+
+        printf("[ALERT] Building line index '%s'...\n", index_filename);
+
+        rvalue = data_index_build(filename, index_filename) && __map_index(index, index_filename, &st);
+    }
+
+    if (!rvalue) {
+        printf("[ERROR] Invalid line index '%s'\n", index_filename);
+    }
+
+    free(index_filename);
+
+    if (rvalue) {
+        index->reader = data_reader_open(filename);
+        index->values = calloc(values_len, sizeof(float));
+
+        rvalue = (index->reader != NULL) && (index->values != NULL);
+    }
+
+    if (!rvalue) {
+        data_index_close(index);
+    }
+
+    return rvalue;
+}
+
+void data_index_close(data_index_t *index) {
+    if (index != NULL) {
+        __unmap_index(index);
+
+        data_reader_close(&index->reader);
+
+        free(index->values);
+        index->values = NULL;
+    }
+}
+
+bool data_index_read_values(data_index_t *index, long sample, float *values_ptr, const int values_len) {
+    if (index == NULL || index->offsets == NULL || sample < 0 || (uint64_t)sample >= index->header.lines) {
+        return false;
+    }
+
+    const uint64_t begin = index->offsets[sample];
+    const uint64_t end   = index->offsets[sample + 1];
+
+    return data_reader_read_at(index->reader, (off_t)begin, (size_t)(end - begin), values_ptr, values_len);
+}
+
+bool data_index_bind_sample(data_index_t *index, long sample, f_vector_t *vector_ptr) {
+    if (index == NULL || vector_ptr == NULL || vector_ptr->len != index->values_len) {
+        return false;
+    }
+
+    if (!data_index_read_values(index, sample, index->values, index->values_len)) {
+        return false;
+    }
+
+    vector_ptr->ptr = index->values;
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// End of File
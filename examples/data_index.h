@@ -0,0 +1,70 @@
+// -----------------------------------------------------------------------------
+// @file data_index.h
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#ifndef DATA_INDEX_H
+#define DATA_INDEX_H
+
+#include <stdbool.h> // bool
+#include <stddef.h>  // size_t
+#include <stdint.h>  // int64_t, uint32_t, uint64_t
+
+#include "data_reader.h" // data_reader_t
+#include "g_page.h"      // f_vector_t
+
+// -----------------------------------------------------------------------------
+/*
+ * Sidecar file "<dataset>.idx" holding the byte offset of every data line of
+ * a text dataset ('#' comments and blank lines are skipped), followed by the
+ * source size as an end marker. The index records the size and mtime of the
+ * source and is rebuilt when they no longer match.
+ *
+ * File layout:
+ *   [data_index_header_t][uint64_t offsets[lines + 1]]
+ */
+
+#define DATA_INDEX_MAGIC   "GFNNLIDX"
+#define DATA_INDEX_VERSION 1
+#define DATA_INDEX_SUFFIX  ".idx"
+
+typedef struct data_index_header_t {
+    char     magic[8];    // DATA_INDEX_MAGIC
+    uint32_t version;     // DATA_INDEX_VERSION
+    uint32_t reserved;    // zero
+    uint64_t source_size; // bytes of the indexed file
+    int64_t  source_sec;  // mtime of the indexed file (seconds)
+    int64_t  source_nsec; // mtime of the indexed file (nanoseconds)
+    uint64_t lines;       // number of data lines
+} data_index_header_t;
+
+typedef struct data_index_t {
+    data_reader_t      *reader;  // source file, used through pread
+    int                 fd;      // index file
+    void               *base;    // mapping of the index file
+    size_t              size;    // bytes mapped
+    const uint64_t     *offsets; // [lines + 1]
+    data_index_header_t header;
+    float              *values;  // scratch row for bind_sample
+    int                 values_len;
+} data_index_t;
+
+// -----------------------------------------------------------------------------
+
+bool data_index_build(const char *filename, const char *index_filename);
+
+bool data_index_open(data_index_t *index, const char *filename, int values_len);
+
+void data_index_close(data_index_t *index);
+
+bool data_index_read_values(data_index_t *index, long sample, float *values_ptr, const int values_len);
+
+bool data_index_bind_sample(data_index_t *index, long sample, f_vector_t *vector_ptr);
+
+#endif // DATA_INDEX_H
+
+// -----------------------------------------------------------------------------
+// End of File
@@ -0,0 +1,279 @@
+// -----------------------------------------------------------------------------
+// @file data_mapper.c
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#include "data_mapper.h"
+
+#include <errno.h>    // errno
+#include <fcntl.h>    // open, O_RDONLY
+#include <stdio.h>    // FILE, fopen, fread, fwrite, fseek, printf
+#include <string.h>   // memcmp, memcpy, memset, strerror
+#include <sys/mman.h> // mmap, munmap, madvise
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // close
+
+// -----------------------------------------------------------------------------
+
+static uint64_t __align_up(uint64_t value, uint64_t align) {
+    return (value + align - 1) / align * align;
+}
+
+// the header is untrusted: every bound is checked without overflow
+static bool __header_check(const data_mapper_header_t *header, size_t size) {
+    const uint64_t F = sizeof(float);
+
+    bool rvalue = memcmp(header->magic, DATA_MAPPER_MAGIC, sizeof(header->magic)) == 0;
+
+    rvalue = rvalue && (header->version == DATA_MAPPER_VERSION);
+    rvalue = rvalue && (header->align > 0);
+    rvalue = rvalue && (header->x_len > 0);
+    rvalue = rvalue && (header->stride > 0);
+
+    // X and T inside the record
+    rvalue = rvalue && (header->x_offset <= header->stride);
+    rvalue = rvalue && (header->x_len * F <= header->stride - header->x_offset);
+    rvalue = rvalue && (header->t_offset <= header->stride);
+    rvalue = rvalue && (header->t_len * F <= header->stride - header->t_offset);
+
+    // float pointers into the (page-aligned) mapping
+    rvalue = rvalue && (header->stride % F == 0);
+    rvalue = rvalue && (header->x_offset % F == 0);
+    rvalue = rvalue && (header->t_offset % F == 0);
+    rvalue = rvalue && (header->data_offset % F == 0);
+    rvalue = rvalue && (header->data_offset % header->align == 0);
+
+    // every record inside the file
+    rvalue = rvalue && (header->data_offset >= sizeof(data_mapper_header_t));
+    rvalue = rvalue && (header->data_offset <= size);
+    rvalue = rvalue && (header->samples <= (size - header->data_offset) / header->stride);
+
+    return rvalue;
+}
+
+bool data_mapper_probe(const char *filename) {
+    if (filename == NULL) {
+        return false;
+    }
+
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL) {
+        return false;
+    }
+
+    char magic[8] = {0};
+
+    const bool rvalue = (fread(magic, 1, sizeof(magic), file) == sizeof(magic)) //
+                        && (memcmp(magic, DATA_MAPPER_MAGIC, sizeof(magic)) == 0);
+
+    fclose(file);
+
+    return rvalue;
+}
+
+bool data_mapper_open(data_mapper_t *map, const char *filename) {
+    if (map == NULL || filename == NULL) {
+        printf("[ERROR] Invalid arguments for mapper open\n");
+        return false;
+    }
+
+    memset(map, 0, sizeof(*map));
+    map->fd = -1;
+
+    map->fd = open(filename, O_RDONLY);
+    if (map->fd < 0) {
+        printf("[ERROR] Unable to open file '%s': %s\n", filename, strerror(errno));
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(map->fd, &st) != 0 || (size_t)st.st_size < sizeof(data_mapper_header_t)) {
+        printf("[ERROR] Invalid binary dataset '%s'\n", filename);
+        data_mapper_close(map);
+        return false;
+    }
+
+    map->size = (size_t)st.st_size;
+    map->base = mmap(NULL, map->size, PROT_READ, MAP_PRIVATE, map->fd, 0);
+    if (map->base == MAP_FAILED) {
+        printf("[ERROR] Unable to map file '%s': %s\n", filename, strerror(errno));
+        map->base = NULL;
+        data_mapper_close(map);
+        return false;
+    }
+
+    memcpy(&map->header, map->base, sizeof(map->header));
+
+    if (!__header_check(&map->header, map->size)) {
+        printf("[ERROR] Invalid binary dataset header '%s'\n", filename);
+        data_mapper_close(map);
+        return false;
+    }
+
+    // samples are usually streamed front to back
+    (void)madvise(map->base, map->size, MADV_SEQUENTIAL);
+
+    return true;
+}
+
+void data_mapper_close(data_mapper_t *map) {
+    if (map != NULL) {
+        if (map->base != NULL) {
+            munmap(map->base, map->size);
+            map->base = NULL;
+        }
+        if (map->fd >= 0) {
+            close(map->fd);
+            map->fd = -1;
+        }
+        map->size = 0;
+    }
+}
+
+float *data_mapper_inputs(data_mapper_t *map, long index) {
+    float *rvalue = NULL;
+
+    if ((map != NULL) && (map->base != NULL)) {
+        const data_mapper_header_t *h = &map->header;
+
+        if ((index >= 0) && ((uint64_t)index < h->samples)) {
+            rvalue = (float *)(map->base + h->data_offset + index * h->stride + h->x_offset);
+        }
+    }
+
+    return rvalue;
+}
+
+float *data_mapper_targets(data_mapper_t *map, long index) {
+    float *rvalue = NULL;
+
+    if ((map != NULL) && (map->base != NULL) && (map->header.t_len > 0)) {
+        const data_mapper_header_t *h = &map->header;
+
+        if ((index >= 0) && ((uint64_t)index < h->samples)) {
+            rvalue = (float *)(map->base + h->data_offset + index * h->stride + h->t_offset);
+        }
+    }
+
+    return rvalue;
+}
+
+bool data_mapper_bind_sample(data_mapper_t *map, long index, f_vector_t *inputs, f_vector_t *targets) {
+    float *x_ptr = data_mapper_inputs(map, index);
+
+    if (x_ptr == NULL) {
+        return false;
+    }
+
+    if (inputs != NULL) {
+        inputs->ptr = x_ptr; // zero-copy: points into the mapping
+    }
+
+    if (targets != NULL) {
+        float *t_ptr = data_mapper_targets(map, index);
+
+        if (t_ptr == NULL) {
+            return false;
+        }
+
+        targets->ptr = t_ptr; // zero-copy: points into the mapping
+    }
+
+    return true;
+}
+
+bool data_mapper_header_init(data_mapper_header_t *header, int x_len, int t_len) {
+    if (header == NULL || x_len <= 0 || t_len < 0) {
+        printf("[ERROR] Invalid arguments for mapper header\n");
+        return false;
+    }
+
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, DATA_MAPPER_MAGIC, sizeof(header->magic));
+
+    const uint64_t x_bytes = (uint64_t)x_len * sizeof(float);
+    const uint64_t t_bytes = (uint64_t)t_len * sizeof(float);
+
+    header->version     = DATA_MAPPER_VERSION;
+    header->align       = DATA_MAPPER_ALIGN;
+    header->samples     = 0;
+    header->x_len       = (uint32_t)x_len;
+    header->t_len       = (uint32_t)t_len;
+    header->x_offset    = 0;
+    header->t_offset    = __align_up(x_bytes, 16); // keep T vector-aligned
+    header->stride      = __align_up(header->t_offset + t_bytes, DATA_MAPPER_ALIGN);
+    header->data_offset = __align_up(sizeof(data_mapper_header_t), DATA_MAPPER_ALIGN);
+
+    return true;
+}
+
+bool data_mapper_write_header(FILE *file, data_mapper_header_t *header) {
+    if (file == NULL || header == NULL) {
+        printf("[ERROR] Invalid arguments for mapper header\n");
+        return false;
+    }
+
+    unsigned char block[DATA_MAPPER_ALIGN * 4] = {0};
+
+    if (header->data_offset > sizeof(block)) {
+        return false;
+    }
+
+    memcpy(block, header, sizeof(*header));
+
+    if (fseek(file, 0, SEEK_SET) != 0) {
+        return false;
+    }
+
+    return fwrite(block, 1, header->data_offset, file) == header->data_offset;
+}
+
+bool data_mapper_write_sample(FILE *file, data_mapper_header_t *header, const float *x_ptr, const float *t_ptr) {
+    if (file == NULL || header == NULL || x_ptr == NULL) {
+        printf("[ERROR] Invalid arguments for mapper sample\n");
+        return false;
+    }
+
+    if (header->t_len > 0 && t_ptr == NULL) {
+        printf("[ERROR] Missing targets for mapper sample\n");
+        return false;
+    }
+
+    static const unsigned char padding[DATA_MAPPER_ALIGN] = {0};
+
+    const uint64_t x_bytes = header->x_len * sizeof(float);
+    const uint64_t t_bytes = header->t_len * sizeof(float);
+
+    bool rvalue = fwrite(x_ptr, 1, x_bytes, file) == x_bytes;
+
+    uint64_t offset = header->x_offset + x_bytes;
+
+    if (rvalue && (header->t_len > 0)) {
+        const uint64_t gap = header->t_offset - offset;
+
+        rvalue = rvalue && (fwrite(padding, 1, gap, file) == gap);
+        rvalue = rvalue && (fwrite(t_ptr, 1, t_bytes, file) == t_bytes);
+
+        offset = header->t_offset + t_bytes;
+    }
+
+    if (rvalue) {
+        const uint64_t gap = header->stride - offset;
+
+        rvalue = fwrite(padding, 1, gap, file) == gap;
+    }
+
+    if (!rvalue) {
+        return false;
+    }
+
+    header->samples++;
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// End of File
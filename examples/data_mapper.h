@@ -0,0 +1,80 @@
+// -----------------------------------------------------------------------------
+// @file data_mapper.h
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#ifndef DATA_MAPPER_H
+#define DATA_MAPPER_H
+
+#include <stdbool.h> // bool
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint32_t, uint64_t
+#include <stdio.h>   // FILE
+
+#include "g_page.h" // f_vector_t
+
+// -----------------------------------------------------------------------------
+/*
+ * Binary dataset layout (native byte order):
+ *
+ *   [header][pad to align][sample 0][sample 1]...[sample N-1]
+ *
+ * Every sample record is "stride" bytes long and starts on an "align" byte
+ * boundary. The inputs X are stored at "x_offset" and the targets T at
+ * "t_offset" inside the record, so a sample is fetched with a single pointer
+ * arithmetic and no parsing.
+ */
+
+#define DATA_MAPPER_MAGIC   "GFNNBSET"
+#define DATA_MAPPER_VERSION 1
+#define DATA_MAPPER_ALIGN   64
+
+typedef struct data_mapper_header_t {
+    char     magic[8];    // DATA_MAPPER_MAGIC
+    uint32_t version;     // DATA_MAPPER_VERSION
+    uint32_t align;       // alignment of records (bytes)
+    uint64_t samples;     // number of sample records
+    uint32_t x_len;       // number of inputs per sample
+    uint32_t t_len;       // number of targets per sample (0 if none)
+    uint64_t stride;      // bytes per sample record
+    uint64_t x_offset;    // offset of X inside the record (bytes)
+    uint64_t t_offset;    // offset of T inside the record (bytes)
+    uint64_t data_offset; // offset of the first record in the file (bytes)
+} data_mapper_header_t;
+
+typedef struct data_mapper_t {
+    int                  fd;
+    unsigned char       *base; // read-only mapping of the whole file
+    size_t               size;
+    data_mapper_header_t header;
+} data_mapper_t;
+
+// -----------------------------------------------------------------------------
+
+bool data_mapper_probe(const char *filename);
+
+bool data_mapper_open(data_mapper_t *map, const char *filename);
+
+void data_mapper_close(data_mapper_t *map);
+
+float *data_mapper_inputs(data_mapper_t *map, long index);
+
+float *data_mapper_targets(data_mapper_t *map, long index);
+
+bool data_mapper_bind_sample(data_mapper_t *map, long index, f_vector_t *inputs, f_vector_t *targets);
+
+// -----------------------------------------------------------------------------
+
+bool data_mapper_header_init(data_mapper_header_t *header, int x_len, int t_len);
+
+bool data_mapper_write_header(FILE *file, data_mapper_header_t *header);
+
+bool data_mapper_write_sample(FILE *file, data_mapper_header_t *header, const float *x_ptr, const float *t_ptr);
+
+#endif // DATA_MAPPER_H
+
+// -----------------------------------------------------------------------------
+// End of File
@@ -0,0 +1,413 @@
+// -----------------------------------------------------------------------------
+// @file data_metrics.c
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#include "data_metrics.h"
+
+#include <errno.h>        // errno
+#include <poll.h>         // poll, pollfd, POLLIN
+#include <stdarg.h>       // va_end, va_list, va_start
+#include <stdio.h>        // fclose, fflush, fileno, fopen, fscanf, fwrite, printf, rename, snprintf, vsnprintf
+#include <stdlib.h>       // free, malloc
+#include <string.h>       // memset, strcpy, strerror, strlen
+#include <sys/resource.h> // getrusage, rusage, RUSAGE_SELF
+#include <sys/socket.h>   // accept, bind, listen, send, socket, AF_UNIX, MSG_NOSIGNAL, SOCK_STREAM
+#include <sys/un.h>       // sockaddr_un
+#include <time.h>         // clock_gettime, nanosleep, CLOCK_MONOTONIC
+#include <unistd.h>       // close, fsync, sysconf, unlink, _SC_PAGESIZE
+
+// -----------------------------------------------------------------------------
+
+#define DATA_METRICS_TEXT 16384 // exposition buffer, bytes
+#define DATA_METRICS_POLL 100   // longest sleep of the exporter, ms
+
+static double __now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static char *__strdup(const char *str, const char *suffix) {
+    char *rvalue = malloc(strlen(str) + strlen(suffix) + 1);
+
+    if (rvalue != NULL) {
+        strcpy(rvalue, str);
+        strcpy(rvalue + strlen(str), suffix);
+    }
+
+    return rvalue;
+}
+
+static void __append(char *text, size_t *len, const char *format, ...) {
+    if (*len >= DATA_METRICS_TEXT) {
+        return;
+    }
+
+    va_list args;
+    va_start(args, format);
+
+    const int n = vsnprintf(text + *len, DATA_METRICS_TEXT - *len, format, args);
+
+    va_end(args);
+
+    *len = (n > 0) ? *len + (size_t)n : *len;
+    *len = (*len < DATA_METRICS_TEXT) ? *len : DATA_METRICS_TEXT - 1;
+}
+
+static void __header(char *text, size_t *len, const char *name, const char *type, const char *help) {
+    __append(text, len, "# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+}
+
+// current and peak resident set, bytes
+static void __memory(double *resident, double *peak) {
+    *resident = 0.0;
+    *peak     = 0.0;
+
+    FILE *statm = fopen("/proc/self/statm", "r");
+    if (statm != NULL) {
+        unsigned long size  = 0;
+        unsigned long pages = 0;
+
+        if (fscanf(statm, "%lu %lu", &size, &pages) == 2) {
+            *resident = (double)pages * (double)sysconf(_SC_PAGESIZE);
+        }
+
+        fclose(statm);
+    }
+
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        *peak = (double)usage.ru_maxrss * 1024.0;
+    }
+}
+
+static size_t __render(data_metrics_t *m, char *text) {
+    size_t len = 0;
+
+    __header(text, &len, "g_fnn_epoch", "gauge", "Current training epoch.");
+    __append(text, &len, "g_fnn_epoch %d\n", atomic_load_explicit(&m->epoch, memory_order_relaxed));
+
+    __header(text, &len, "g_fnn_samples_total", "counter", "Samples processed since the start of the run.");
+    __append(text, &len, "g_fnn_samples_total %ld\n", atomic_load_explicit(&m->samples, memory_order_relaxed));
+
+    __header(text, &len, "g_fnn_samples_per_second", "gauge", "Samples processed per second over the last interval.");
+    __append(text, &len, "g_fnn_samples_per_second %.1f\n", m->samples_per_second);
+
+    __header(text, &len, "g_fnn_loss", "gauge", "Mean loss of the current epoch so far.");
+    __append(text, &len, "g_fnn_loss %g\n", (double)atomic_load_explicit(&m->loss, memory_order_relaxed));
+
+    __header(text, &len, "g_fnn_layer_learning_rate", "gauge", "Learning rate of the layer.");
+    for (int k = 0; k < m->layers; ++k) {
+        __append(text, &len, "g_fnn_layer_learning_rate{layer=\"%d\"} %g\n", k, (double)atomic_load_explicit(&m->lr[k], memory_order_relaxed));
+    }
+
+    __header(text, &len, "g_fnn_layer_mse", "gauge", "Mean squared error of the layer on the last sample.");
+    for (int k = 0; k < m->layers; ++k) {
+        __append(text, &len, "g_fnn_layer_mse{layer=\"%d\"} %g\n", k, (double)atomic_load_explicit(&m->mse[k], memory_order_relaxed));
+    }
+
+    if (m->queues_len > 0) {
+        __header(text, &len, "g_fnn_queue_depth", "gauge", "Entries waiting in the queue.");
+        for (int q = 0; q < m->queues_len; ++q) {
+            __append(text, &len, "g_fnn_queue_depth{queue=\"%s\"} %ld\n", m->queues[q].name, m->queues[q].depth(m->queues[q].ctx));
+        }
+    }
+
+    double resident;
+    double peak;
+    __memory(&resident, &peak);
+
+    __header(text, &len, "g_fnn_resident_bytes", "gauge", "Resident set size.");
+    __append(text, &len, "g_fnn_resident_bytes %.0f\n", resident);
+
+    __header(text, &len, "g_fnn_resident_peak_bytes", "gauge", "Peak resident set size.");
+    __append(text, &len, "g_fnn_resident_peak_bytes %.0f\n", peak);
+
+    __header(text, &len, "g_fnn_uptime_seconds", "gauge", "Seconds since the metrics were started.");
+    __append(text, &len, "g_fnn_uptime_seconds %.3f\n", __now() - m->start_seconds);
+
+    return len;
+}
+
+static bool __write_textfile(data_metrics_t *m, const char *text, size_t len) {
+    FILE *file = fopen(m->tmp_textfile, "w");
+    if (file == NULL) {
+        printf("[ERROR] Unable to open metrics file '%s': %s\n", m->tmp_textfile, strerror(errno));
+        return false;
+    }
+
+    bool rvalue = fwrite(text, 1, len, file) == len;
+
+    rvalue = rvalue && (fflush(file) == 0) && (fsync(fileno(file)) == 0);
+    rvalue = (fclose(file) == 0) && rvalue;
+
+    // a scraper sees either the previous file or this one
+    rvalue = rvalue && (rename(m->tmp_textfile, m->textfile) == 0);
+
+    if (!rvalue) {
+        printf("[ERROR] Unable to write metrics file '%s'\n", m->textfile);
+    }
+
+    return rvalue;
+}
+
+static void __tick(data_metrics_t *m, double now) {
+    const long samples = atomic_load_explicit(&m->samples, memory_order_relaxed);
+
+    if (now > m->last_seconds) {
+        m->samples_per_second = (double)(samples - m->last_samples) / (now - m->last_seconds);
+    }
+
+    m->last_seconds = now;
+    m->last_samples = samples;
+}
+
+static void *__exporter(void *arg) {
+    data_metrics_t *m = arg;
+
+    char *text = malloc(DATA_METRICS_TEXT);
+    if (text == NULL) {
+        printf("[ERROR] Unable to allocate metrics buffer\n");
+        return NULL;
+    }
+
+    double next = m->start_seconds + m->interval;
+
+    bool textfile_ok = true;
+
+    while (!atomic_load_explicit(&m->stop, memory_order_acquire)) {
+        const double now = __now();
+
+        if (now >= next) {
+            __tick(m, now);
+
+            // stop rewriting after the first failure, one error is enough
+            if ((m->textfile != NULL) && textfile_ok) {
+                textfile_ok = __write_textfile(m, text, __render(m, text));
+            }
+
+            next = now + m->interval;
+        }
+
+        const int timeout = (int)((next - now) * 1e3) + 1;
+        const int wait    = (timeout < DATA_METRICS_POLL) ? timeout : DATA_METRICS_POLL;
+
+        if (m->listen_fd >= 0) {
+            struct pollfd pfd = {.fd = m->listen_fd, .events = POLLIN, .revents = 0};
+
+            if ((poll(&pfd, 1, wait) > 0) && (pfd.revents & POLLIN)) {
+                const int client = accept(m->listen_fd, NULL, NULL);
+
+                if (client >= 0) {
+                    const size_t len = __render(m, text);
+
+                    // a client that hangs up early must not raise SIGPIPE
+                    size_t sent = 0;
+                    while (sent < len) {
+                        const ssize_t n = send(client, text + sent, len - sent, MSG_NOSIGNAL);
+                        if (n <= 0) {
+                            break;
+                        }
+                        sent += (size_t)n;
+                    }
+
+                    close(client);
+                }
+            }
+        } else {
+            const struct timespec ts = {wait / 1000, (wait % 1000) * 1000000L};
+            nanosleep(&ts, NULL);
+        }
+    }
+
+    free(text);
+
+    return NULL;
+}
+
+static bool __listen(data_metrics_t *m) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+
+    if (strlen(m->socket_path) >= sizeof(address.sun_path)) {
+        printf("[ERROR] Metrics socket path '%s' is too long\n", m->socket_path);
+        return false;
+    }
+
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, m->socket_path);
+
+    m->listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (m->listen_fd < 0) {
+        printf("[ERROR] Unable to create metrics socket: %s\n", strerror(errno));
+        return false;
+    }
+
+    // a stale socket of a previous run
+    unlink(m->socket_path);
+
+    if ((bind(m->listen_fd, (struct sockaddr *)&address, sizeof(address)) != 0) || (listen(m->listen_fd, 4) != 0)) {
+        printf("[ERROR] Unable to listen on metrics socket '%s': %s\n", m->socket_path, strerror(errno));
+        close(m->listen_fd);
+        m->listen_fd = -1;
+        return false;
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool data_metrics_open(data_metrics_t *m, const char *textfile, const char *socket_path, double interval, int layers) {
+    if (m == NULL || (textfile == NULL && socket_path == NULL) || interval <= 0.0 || layers <= 0) {
+        printf("[ERROR] Invalid arguments for metrics open\n");
+        return false;
+    }
+
+    memset(m, 0, sizeof(*m));
+
+    m->interval  = interval;
+    m->layers    = (layers < DATA_METRICS_LAYERS) ? layers : DATA_METRICS_LAYERS;
+    m->listen_fd = -1;
+
+    atomic_init(&m->epoch, 0);
+    atomic_init(&m->samples, 0);
+    atomic_init(&m->loss, 0.0f);
+    atomic_init(&m->stop, false);
+
+    for (int k = 0; k < DATA_METRICS_LAYERS; ++k) {
+        atomic_init(&m->lr[k], 0.0f);
+        atomic_init(&m->mse[k], 0.0f);
+    }
+
+    bool rvalue = true;
+
+    if (textfile != NULL) {
+        m->textfile     = __strdup(textfile, "");
+        m->tmp_textfile = __strdup(textfile, ".tmp");
+
+        rvalue = (m->textfile != NULL) && (m->tmp_textfile != NULL);
+    }
+
+    if (rvalue && (socket_path != NULL)) {
+        m->socket_path = __strdup(socket_path, "");
+
+        rvalue = (m->socket_path != NULL) && __listen(m);
+    }
+
+    if (!rvalue) {
+        data_metrics_close(m);
+    }
+
+    return rvalue;
+}
+
+bool data_metrics_queue(data_metrics_t *m, const char *name, data_metrics_depth_t depth, void *ctx) {
+    if (m == NULL || name == NULL || depth == NULL || m->thread_ok || m->queues_len >= DATA_METRICS_QUEUES) {
+        printf("[ERROR] Invalid arguments for metrics queue\n");
+        return false;
+    }
+
+    m->queues[m->queues_len].name  = name;
+    m->queues[m->queues_len].depth = depth;
+    m->queues[m->queues_len].ctx   = ctx;
+    m->queues_len++;
+
+    return true;
+}
+
+bool data_metrics_start(data_metrics_t *m) {
+    if (m == NULL || m->thread_ok) {
+        printf("[ERROR] Invalid arguments for metrics start\n");
+        return false;
+    }
+
+    m->start_seconds = __now();
+    m->last_seconds  = m->start_seconds;
+
+    m->thread_ok = pthread_create(&m->thread, NULL, __exporter, m) == 0;
+    if (!m->thread_ok) {
+        printf("[ERROR] Unable to start metrics thread\n");
+    }
+
+    return m->thread_ok;
+}
+
+bool data_metrics_close(data_metrics_t *m) {
+    if (m == NULL) {
+        return false;
+    }
+
+    bool rvalue = true;
+
+    if (m->thread_ok) {
+        atomic_store_explicit(&m->stop, true, memory_order_release);
+
+        pthread_join(m->thread, NULL);
+
+        m->thread_ok = false;
+
+        // the state at the end of the run
+        if (m->textfile != NULL) {
+            char *text = malloc(DATA_METRICS_TEXT);
+
+            rvalue = text != NULL;
+
+            if (rvalue) {
+                __tick(m, __now());
+
+                rvalue = __write_textfile(m, text, __render(m, text));
+            }
+
+            free(text);
+        }
+    }
+
+    if (m->listen_fd >= 0) {
+        close(m->listen_fd);
+        unlink(m->socket_path);
+
+        m->listen_fd = -1;
+    }
+
+    free(m->textfile);
+    free(m->tmp_textfile);
+    free(m->socket_path);
+
+    m->textfile     = NULL;
+    m->tmp_textfile = NULL;
+    m->socket_path  = NULL;
+
+    return rvalue;
+}
+
+void data_metrics_epoch(data_metrics_t *m, int epoch) {
+    atomic_store_explicit(&m->epoch, epoch, memory_order_relaxed);
+
+    m->loss_sum   = 0.0;
+    m->loss_count = 0;
+}
+
+void data_metrics_sample(data_metrics_t *m, const g_pages_t *pages, float loss) {
+    // single writer: a relaxed load and store, no read-modify-write
+    atomic_store_explicit(&m->samples, atomic_load_explicit(&m->samples, memory_order_relaxed) + 1, memory_order_relaxed);
+
+    m->loss_sum += loss;
+    m->loss_count++;
+
+    atomic_store_explicit(&m->loss, (float)(m->loss_sum / m->loss_count), memory_order_relaxed);
+
+    const int layers = (pages->len < m->layers) ? pages->len : m->layers;
+
+    for (int k = 0; k < layers; ++k) {
+        atomic_store_explicit(&m->lr[k], pages->ptr[k].lr, memory_order_relaxed);
+        atomic_store_explicit(&m->mse[k], pages->ptr[k].mse, memory_order_relaxed);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// End of File
@@ -0,0 +1,94 @@
+// -----------------------------------------------------------------------------
+// @file data_metrics.h
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#ifndef DATA_METRICS_H
+#define DATA_METRICS_H
+
+#include <pthread.h>   // pthread_t
+#include <stdatomic.h> // atomic_bool, atomic_int, atomic_long
+#include <stdbool.h>   // bool
+
+#include "g_page.h" // g_pages_t
+
+// -----------------------------------------------------------------------------
+/*
+ * Live run metrics in the Prometheus text exposition format. The compute
+ * loop publishes its counters with relaxed atomic stores (no locks, no
+ * system calls); an exporter thread renders them every interval into a
+ * textfile, written as "<file>.tmp" and renamed over it so a scraper never
+ * reads a partial file, and/or answers every connection to a Unix socket
+ * with the current text. Queue depths and memory use are sampled by the
+ * exporter thread itself.
+ */
+
+#define DATA_METRICS_LAYERS 16 // layers exported, deeper ones are left out
+#define DATA_METRICS_QUEUES 4
+
+// depth of a queue, called from the exporter thread
+typedef long (*data_metrics_depth_t)(void *ctx);
+
+typedef struct data_metrics_queue_t {
+    const char          *name;
+    data_metrics_depth_t depth;
+    void                *ctx;
+} data_metrics_queue_t;
+
+typedef struct data_metrics_t {
+    char  *textfile;     // NULL: no textfile
+    char  *tmp_textfile; // "<textfile>.tmp"
+    char  *socket_path;  // NULL: no socket
+    double interval;     // seconds between textfile updates
+
+    // published by the compute loop
+    atomic_int    epoch;
+    atomic_long   samples;
+    _Atomic float loss; // mean loss of the current epoch
+    int           layers;
+    _Atomic float lr[DATA_METRICS_LAYERS];
+    _Atomic float mse[DATA_METRICS_LAYERS];
+
+    // private to the compute loop
+    double loss_sum;
+    long   loss_count;
+
+    data_metrics_queue_t queues[DATA_METRICS_QUEUES];
+    int                  queues_len;
+
+    // private to the exporter thread
+    double start_seconds;
+    double last_seconds;
+    long   last_samples;
+    double samples_per_second;
+
+    int         listen_fd;
+    atomic_bool stop;
+    pthread_t   thread;
+    bool        thread_ok;
+} data_metrics_t;
+
+// -----------------------------------------------------------------------------
+
+bool data_metrics_open(data_metrics_t *m, const char *textfile, const char *socket_path, double interval, int layers);
+
+// registers a queue, before data_metrics_start
+bool data_metrics_queue(data_metrics_t *m, const char *name, data_metrics_depth_t depth, void *ctx);
+
+bool data_metrics_start(data_metrics_t *m);
+
+// stops the exporter and writes the final textfile
+bool data_metrics_close(data_metrics_t *m);
+
+void data_metrics_epoch(data_metrics_t *m, int epoch);
+
+// one trained (or inferred) sample, with its loss and the per-layer lr and mse
+void data_metrics_sample(data_metrics_t *m, const g_pages_t *pages, float loss);
+
+#endif // DATA_METRICS_H
+
+// -----------------------------------------------------------------------------
+// End of File
@@ -0,0 +1,303 @@
+// -----------------------------------------------------------------------------
+// @file data_prefetch.c
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#include "data_prefetch.h"
+
+#include <stdio.h>  // printf
+#include <stdlib.h> // calloc, free
+#include <string.h> // memset
+#include <time.h>   // clock_gettime, CLOCK_MONOTONIC
+
+#include "g_trace.h" // G_TRACE_BEGIN, G_TRACE_END, g_trace_thread_name
+
+// -----------------------------------------------------------------------------
+
+static double __now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void __fill_batch(data_prefetch_t *pf, data_prefetch_batch_t *batch, bool *targets_ok) {
+    batch->x_count = 0;
+    batch->t_count = 0;
+
+    for (int i = 0; i < pf->batch_len; ++i) {
+        float *x_row = batch->x + (size_t)i * pf->x_len;
+
+        if (!data_reader_next_values(pf->dataset, x_row, pf->x_len)) {
+            break;
+        }
+
+        batch->x_count++;
+
+        if (*targets_ok) {
+            float *t_row = batch->t + (size_t)i * pf->t_len;
+
+            *targets_ok = data_reader_next_values(pf->outputs, t_row, pf->t_len);
+
+            if (*targets_ok) {
+                batch->t_count++;
+            }
+        }
+    }
+}
+
+static void *__producer(void *arg) {
+    data_prefetch_t *pf = arg;
+
+    bool targets_ok = pf->outputs != NULL;
+
+    g_trace_thread_name("prefetch");
+
+    while (true) {
+        pthread_mutex_lock(&pf->lock);
+
+        // backpressure: wait for the consumer to hand back a slot
+        if ((pf->filled == pf->depth) && !pf->stop) {
+            G_TRACE_BEGIN(t0);
+
+            while ((pf->filled == pf->depth) && !pf->stop) {
+                pthread_cond_wait(&pf->not_full, &pf->lock);
+            }
+
+            G_TRACE_END(t0, "prefetch full", "queue");
+        }
+
+        const bool stop = pf->stop;
+
+        data_prefetch_batch_t *batch = &pf->slots[pf->tail];
+
+        pthread_mutex_unlock(&pf->lock);
+
+        if (stop) {
+            break;
+        }
+
+        // parse outside the lock, the slot is not visible to the consumer yet
+        G_TRACE_BEGIN(t1);
+
+        __fill_batch(pf, batch, &targets_ok);
+
+        G_TRACE_END(t1, "prefetch batch", "io");
+
+        const bool last = batch->x_count < pf->batch_len;
+
+        pthread_mutex_lock(&pf->lock);
+
+        if (batch->x_count > 0) {
+            pf->tail = (pf->tail + 1) % pf->depth;
+            pf->filled++;
+        }
+
+        pf->done = last;
+
+        pthread_cond_signal(&pf->not_empty);
+        pthread_mutex_unlock(&pf->lock);
+
+        if (last) {
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+static void __release_current(data_prefetch_t *pf) {
+    if (pf->current != NULL) {
+        pthread_mutex_lock(&pf->lock);
+
+        pf->head = (pf->head + 1) % pf->depth;
+        pf->filled--;
+        pf->current = NULL;
+
+        pthread_cond_signal(&pf->not_full);
+        pthread_mutex_unlock(&pf->lock);
+    }
+}
+
+static bool __acquire_next(data_prefetch_t *pf) {
+    pthread_mutex_lock(&pf->lock);
+
+    if ((pf->filled == 0) && !pf->done) {
+        const double t0 = __now();
+
+        G_TRACE_BEGIN(t1);
+
+        while ((pf->filled == 0) && !pf->done) {
+            pthread_cond_wait(&pf->not_empty, &pf->lock);
+        }
+
+        G_TRACE_END(t1, "prefetch wait", "queue");
+
+        pf->stall_seconds += __now() - t0;
+    }
+
+    const bool rvalue = pf->filled > 0;
+
+    if (rvalue) {
+        pf->current = &pf->slots[pf->head];
+        pf->index   = 0;
+    }
+
+    pthread_mutex_unlock(&pf->lock);
+
+    return rvalue;
+}
+
+bool data_prefetch_open(data_prefetch_t *pf,
+                        const char      *dataset_filename,
+                        const char      *outputs_filename,
+                        int              x_len,
+                        int              t_len,
+                        int              batch_len,
+                        int              depth) {
+    if (pf == NULL || x_len <= 0 || t_len < 0 || batch_len <= 0 || depth < 2) {
+        printf("[ERROR] Invalid arguments for prefetch open\n");
+        return false;
+    }
+
+    memset(pf, 0, sizeof(*pf));
+
+    pf->x_len     = x_len;
+    pf->t_len     = outputs_filename != NULL ? t_len : 0;
+    pf->batch_len = batch_len;
+    pf->depth     = depth;
+
+    pf->dataset = data_reader_open(dataset_filename);
+    if (pf->dataset == NULL) {
+        data_prefetch_close(pf);
+        return false;
+    }
+
+    if (pf->t_len > 0) {
+        pf->outputs = data_reader_open(outputs_filename);
+        if (pf->outputs == NULL) {
+            data_prefetch_close(pf);
+            return false;
+        }
+    }
+
+    pf->slots = calloc(depth, sizeof(data_prefetch_batch_t));
+    if (pf->slots == NULL) {
+        data_prefetch_close(pf);
+        return false;
+    }
+
+    for (int i = 0; i < depth; ++i) {
+        pf->slots[i].x = calloc((size_t)batch_len * x_len, sizeof(float));
+        pf->slots[i].t = pf->t_len > 0 ? calloc((size_t)batch_len * pf->t_len, sizeof(float)) : NULL;
+
+        if (pf->slots[i].x == NULL || (pf->t_len > 0 && pf->slots[i].t == NULL)) {
+            printf("[ERROR] Unable to allocate prefetch batches\n");
+            data_prefetch_close(pf);
+            return false;
+        }
+    }
+
+    pthread_mutex_init(&pf->lock, NULL);
+    pthread_cond_init(&pf->not_empty, NULL);
+    pthread_cond_init(&pf->not_full, NULL);
+
+    pf->thread_ok = pthread_create(&pf->thread, NULL, __producer, pf) == 0;
+    if (!pf->thread_ok) {
+        printf("[ERROR] Unable to start prefetch thread\n");
+        pthread_cond_destroy(&pf->not_full);
+        pthread_cond_destroy(&pf->not_empty);
+        pthread_mutex_destroy(&pf->lock);
+        data_prefetch_close(pf);
+        return false;
+    }
+
+    return true;
+}
+
+void data_prefetch_close(data_prefetch_t *pf) {
+    if (pf == NULL) {
+        return;
+    }
+
+    if (pf->thread_ok) {
+        pthread_mutex_lock(&pf->lock);
+        pf->stop = true;
+        pthread_cond_broadcast(&pf->not_full);
+        pthread_mutex_unlock(&pf->lock);
+
+        pthread_join(pf->thread, NULL);
+
+        pthread_cond_destroy(&pf->not_full);
+        pthread_cond_destroy(&pf->not_empty);
+        pthread_mutex_destroy(&pf->lock);
+
+        pf->thread_ok = false;
+    }
+
+    if (pf->slots != NULL) {
+        for (int i = 0; i < pf->depth; ++i) {
+            free(pf->slots[i].x);
+            free(pf->slots[i].t);
+        }
+
+        free(pf->slots);
+        pf->slots = NULL;
+    }
+
+    data_reader_close(&pf->dataset);
+    data_reader_close(&pf->outputs);
+
+    pf->current = NULL;
+}
+
+bool data_prefetch_next_inputs(data_prefetch_t *pf, f_vector_t *inputs) {
+    if (pf == NULL || pf->slots == NULL || inputs == NULL || inputs->len != pf->x_len) {
+        printf("[ERROR] Invalid arguments for prefetch inputs\n");
+        return false;
+    }
+
+    if ((pf->current != NULL) && (pf->index == pf->current->x_count)) {
+        __release_current(pf);
+    }
+
+    if ((pf->current == NULL) && !__acquire_next(pf)) {
+        return false;
+    }
+
+    inputs->ptr = pf->current->x + (size_t)pf->index * pf->x_len;
+    pf->index++;
+
+    return true;
+}
+
+bool data_prefetch_next_targets(data_prefetch_t *pf, f_vector_t *targets) {
+    if (pf == NULL || targets == NULL || targets->len != pf->t_len || pf->current == NULL) {
+        return false;
+    }
+
+    const int row = pf->index - 1;
+
+    if (row >= pf->current->t_count) {
+        return false;
+    }
+
+    targets->ptr = pf->current->t + (size_t)row * pf->t_len;
+
+    return true;
+}
+
+long data_prefetch_depth(data_prefetch_t *pf) {
+    pthread_mutex_lock(&pf->lock);
+
+    const long rvalue = pf->filled;
+
+    pthread_mutex_unlock(&pf->lock);
+
+    return rvalue;
+}
+
+// -----------------------------------------------------------------------------
+// End of File
@@ -0,0 +1,88 @@
+// -----------------------------------------------------------------------------
+// @file data_prefetch.h
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#ifndef DATA_PREFETCH_H
+#define DATA_PREFETCH_H
+
+#include <pthread.h> // pthread_t, pthread_mutex_t, pthread_cond_t
+#include <stdbool.h> // bool
+
+#include "data_reader.h" // data_reader_t
+#include "g_page.h"      // f_vector_t
+
+// -----------------------------------------------------------------------------
+/*
+ * A producer thread parses the dataset (and outputs) files into a bounded
+ * ring of sample batches. The consumer binds its vectors to rows of the
+ * oldest batch; a batch is handed back to the producer only when the
+ * consumer moves past it, so a bound pointer stays valid until the next
+ * call to data_prefetch_next_inputs.
+ */
+
+#define DATA_PREFETCH_BATCH 256 // samples per batch
+#define DATA_PREFETCH_DEPTH 4   // batches in flight (>= 2: double-buffered)
+
+typedef struct data_prefetch_batch_t {
+    float *x;       // [batch][x_len]
+    float *t;       // [batch][t_len], NULL without outputs
+    int    x_count; // samples with inputs
+    int    t_count; // samples with targets
+} data_prefetch_batch_t;
+
+typedef struct data_prefetch_t {
+    data_reader_t *dataset;
+    data_reader_t *outputs; // NULL when targets are not needed
+
+    int x_len;
+    int t_len;
+    int batch_len;
+    int depth;
+
+    data_prefetch_batch_t *slots;
+
+    // shared state, guarded by lock
+    pthread_mutex_t lock;
+    pthread_cond_t  not_empty;
+    pthread_cond_t  not_full;
+    int             head;   // oldest filled slot
+    int             tail;   // next slot to fill
+    int             filled; // slots owned by the consumer side
+    bool            done;   // producer reached the end of the dataset
+    bool            stop;   // consumer requested shutdown
+    pthread_t       thread;
+    bool            thread_ok;
+
+    // consumer cursor
+    data_prefetch_batch_t *current;
+    int                    index;
+    double                 stall_seconds; // time spent waiting on the producer
+} data_prefetch_t;
+
+// -----------------------------------------------------------------------------
+
+bool data_prefetch_open(data_prefetch_t *pf,
+                        const char      *dataset_filename,
+                        const char      *outputs_filename,
+                        int              x_len,
+                        int              t_len,
+                        int              batch_len,
+                        int              depth);
+
+void data_prefetch_close(data_prefetch_t *pf);
+
+bool data_prefetch_next_inputs(data_prefetch_t *pf, f_vector_t *inputs);
+
+bool data_prefetch_next_targets(data_prefetch_t *pf, f_vector_t *targets);
+
+// batches parsed and not yet consumed, callable from any thread
+long data_prefetch_depth(data_prefetch_t *pf);
+
+#endif // DATA_PREFETCH_H
+
+// -----------------------------------------------------------------------------
+// End of File
@@ -8,61 +8,306 @@
 
 #include "data_reader.h"
 
-#include <ctype.h>  // isdigit
-#include <errno.h>  // errno
-#include <stdio.h>  // FILE, fopen, fclose, fscanf, fgetc, feof, rewind
-#include <string.h> // strerror
+#include <errno.h>  // errno, EINTR
+#include <fcntl.h>  // open, O_RDONLY
+#include <stdint.h> // uint64_t
+#include <stdio.h>  // EOF, printf
+#include <stdlib.h> // calloc, free, strtof
+#include <string.h> // memcpy, memmove, strerror
+#include <unistd.h> // close, pread, read
 
 // -----------------------------------------------------------------------------
 
-static void __skip_invalid_chars(FILE *file) {
+// exact powers of ten representable in a double (10^0 ... 10^22)
+static const double __pow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+static inline bool __is_digit(int c) {
+    return (unsigned)(c - '0') < 10u;
+}
+
+static inline bool __is_space(int c) {
+    return (c == ' ') || (c == '\n') || (c == '\t') || (c == '\r') || (c == '\v') || (c == '\f');
+}
+
+static bool __refill(data_reader_t *reader) {
+    if (reader->eof) {
+        return false;
+    }
+
+    // slide the unparsed tail to the front of the window
+    const size_t tail = reader->end - reader->pos;
+
+    if (tail > 0 && reader->pos > 0) {
+        memmove(reader->buf, reader->buf + reader->pos, tail);
+    }
+    reader->pos = 0;
+    reader->end = tail;
+
+    reader->buf[reader->end] = '\0';
+
+    bool rvalue = false;
+
+    while (reader->end < reader->cap) {
+        const ssize_t n = read(reader->fd, reader->buf + reader->end, reader->cap - reader->end);
+
+        if (n > 0) {
+            reader->end += (size_t)n;
+            reader->buf[reader->end] = '\0'; // sentinel for the scanners
+            rvalue = true;
+            break; // one block at a time, keep latency low
+        }
+
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+
+        reader->eof = true;
+        break;
+    }
+
+    return rvalue;
+}
+
+static inline int __peek(data_reader_t *reader) {
+    if (reader->pos == reader->end && !__refill(reader)) {
+        return EOF;
+    }
+
+    return (unsigned char)reader->buf[reader->pos];
+}
+
+static inline void __ensure(data_reader_t *reader, size_t len) {
+    while ((reader->end - reader->pos < len) && __refill(reader)) {
+        // keep pulling until the token fits or the file ends
+    }
+}
+
+static void __skip_invalid_chars(data_reader_t *reader) {
     int c;
-    while ((c = fgetc(file)) != EOF) {
+    while ((c = __peek(reader)) != EOF) {
         // Skip lines that start with '#'
         if (c == '#') {
-            while ((c = fgetc(file)) != EOF && c != '\n') {
-                // Consume the rest of the line
+            while ((c = __peek(reader)) != EOF && c != '\n') {
+                reader->pos++; // Consume the rest of the line
             }
             continue; // Check the next character after the comment line
         }
 
         // Check for valid characters
-        if (isdigit(c)     //
+        if (__is_digit(c)  //
             || c == '.'    //
             || c == '-'    //
             || c == ','    //
             || c == 'e'    //
             || c == 'E') { //
-            ungetc(c, file);
             break;
         }
+
+        reader->pos++;
     }
 }
 
-FILE *data_reader_open(const char *filename) {
+static int __parse_slow(data_reader_t *reader, float *value) {
+    char token[DATA_READER_TOKEN_MAX + 1];
+
+    const size_t len = reader->end - reader->pos;
+    const size_t cpy = len < DATA_READER_TOKEN_MAX ? len : DATA_READER_TOKEN_MAX;
+
+    memcpy(token, reader->buf + reader->pos, cpy);
+    token[cpy] = '\0';
+
+    char *tail = token;
+    *value     = strtof(token, &tail);
+
+    if (tail == token) {
+        return 0; // matching failure
+    }
+
+    reader->pos += (size_t)(tail - token);
+
+    return 1;
+}
+
+// Scans a decimal number starting at p; the window is NUL-terminated so no
+// bound checks are needed. Returns the end of the number, or NULL when the
+// token needs the libc path.
+static inline const char *__scan_float(const char *p, float *value) {
+    // signs are data-dependent, keep them branch-free
+    const bool negative = *p == '-';
+    p += negative | (*p == '+');
+
+    uint64_t mantissa = 0;
+    int      exp10    = 0;
+
+    const char *digits = p;
+
+    while (__is_digit(*p)) {
+        mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+        p++;
+    }
+
+    int count = (int)(p - digits);
+
+    if (*p == '.') {
+        const char *fraction = ++p;
+
+        while (__is_digit(*p)) {
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+            p++;
+        }
+
+        exp10 = -(int)(p - fraction);
+        count += (int)(p - fraction);
+    }
+
+    // inf, nan, hexadecimal, malformed and over-long tokens
+    if (count == 0 || count > 19 || *p == 'x' || *p == 'X') {
+        return NULL;
+    }
+
+    if (*p == 'e' || *p == 'E') {
+        const char *q = p + 1;
+
+        const bool exp_negative = *q == '-';
+        q += exp_negative | (*q == '+');
+
+        if (__is_digit(*q)) {
+            int exp_value = 0;
+            while (__is_digit(*q)) {
+                if (exp_value < 10000) {
+                    exp_value = exp_value * 10 + (*q - '0');
+                }
+                q++;
+            }
+            exp10 += exp_negative ? -exp_value : exp_value;
+            p = q;
+        }
+    }
+
+    // mantissa and power of ten are exact doubles, so the product (or quotient)
+    // is correctly rounded to double; rounding that to float is a second
+    // rounding, which can differ from strtof in the last bit on rare halfway cases
+    if ((mantissa >> 53) != 0 || exp10 < -22 || exp10 > 22) {
+        return NULL;
+    }
+
+    // both candidates are computed so the exponent sign never mispredicts
+    const double scale  = __pow10[exp10 < 0 ? -exp10 : exp10];
+    const double up     = (double)mantissa * scale;
+    const double down   = (double)mantissa / scale;
+    const double result = exp10 < 0 ? down : up;
+
+    *value = (float)(negative ? -result : result);
+
+    return p;
+}
+
+// Same contract as fscanf(file, "%f", value): 1 on success, 0 on a matching
+// failure, EOF when the input ends before a number starts.
+static int __parse_float(data_reader_t *reader, float *value) {
+    int c;
+    while ((c = __peek(reader)) != EOF && __is_space(c)) {
+        reader->pos++;
+    }
+
+    if (c == EOF) {
+        return EOF;
+    }
+
+    __ensure(reader, DATA_READER_TOKEN_MAX);
+
+    const char *p = reader->buf + reader->pos;
+    const char *q = __scan_float(p, value);
+
+    if (q == NULL) {
+        return __parse_slow(reader, value);
+    }
+
+    reader->pos = (size_t)(q - reader->buf);
+
+    return 1;
+}
+
+// Parses a whole line from the window when it is known to be contiguous;
+// returns the number of values parsed before the fast path gave up.
+static int __parse_line(data_reader_t *reader, float *values_ptr, const int values_len) {
+    const char *p = reader->buf + reader->pos;
+    const char *e = reader->buf + reader->end;
+
+    int i = 0;
+    while (i < values_len) {
+        while (__is_space(*p)) {
+            p++;
+        }
+
+        const char *q = (p < e) ? __scan_float(p, &values_ptr[i]) : NULL;
+
+        if (q == NULL || (q == e && !reader->eof)) {
+            break; // the slow path re-parses a token cut by the window
+        }
+
+        p = q;
+        i++;
+
+        if (i < values_len && *p == ',') {
+            p++;
+        }
+    }
+
+    reader->pos = (size_t)(p - reader->buf);
+
+    return i;
+}
+
+data_reader_t *data_reader_open(const char *filename) {
     if (filename == NULL) {
         printf("[ERROR] Invalid filename\n");
         return NULL;
     }
 
-    FILE *file = fopen(filename, "r");
-    if (file == NULL) {
+    const int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
         printf("[ERROR] Unable to open file '%s': %s\n", filename, strerror(errno));
         return NULL;
     }
 
-    return file;
+    data_reader_t *reader = calloc(1, sizeof(data_reader_t));
+    char          *buf    = calloc(DATA_READER_BLOCK_SIZE + 1, 1); // + sentinel
+
+    if (reader == NULL || buf == NULL) {
+        printf("[ERROR] Unable to allocate reader for '%s'\n", filename);
+        free(reader);
+        free(buf);
+        close(fd);
+        return NULL;
+    }
+
+    reader->fd  = fd;
+    reader->buf = buf;
+    reader->cap = DATA_READER_BLOCK_SIZE;
+    reader->pos = 0;
+    reader->end = 0;
+    reader->eof = false;
+
+    reader->buf[0] = '\0';
+
+    return reader;
 }
 
-void data_reader_close(FILE **file) {
-    if (*file != NULL) {
-        fclose(*file);
-        *file = NULL;
+void data_reader_close(data_reader_t **reader) {
+    if (*reader != NULL) {
+        close((*reader)->fd);
+        free((*reader)->buf);
+        free(*reader);
+        *reader = NULL;
     }
 }
 
-bool data_reader_next_values(FILE *file, float *values_ptr, const int values_len) {
-    if (file == NULL) {
+bool data_reader_next_values(data_reader_t *reader, float *values_ptr, const int values_len) {
+    if (reader == NULL) {
         printf("[ERROR] No file open\n");
         return false;
     }
@@ -72,39 +317,95 @@ bool data_reader_next_values(FILE *file, float *values_ptr, const int values_len
         return false;
     }
 
-    __skip_invalid_chars(file);
+    __skip_invalid_chars(reader);
 
     int items_read = 0;
-    for (int i = 0; i < values_len; i++) {
-        if (fscanf(file, "%f", &values_ptr[i]) != 1) {
+
+    // fast path: the whole line is already in the window
+    const size_t line_max = (size_t)values_len * DATA_READER_TOKEN_MAX;
+
+    if (line_max < reader->cap / 2) {
+        __ensure(reader, line_max);
+
+        if (reader->end - reader->pos >= line_max) {
+            items_read = __parse_line(reader, values_ptr, values_len);
+        }
+    }
+
+    for (int i = items_read; i < values_len; i++) {
+        if (__parse_float(reader, &values_ptr[i]) != 1) {
             break;
         }
         items_read++;
         if (i < values_len - 1) {
-            int c = fgetc(file);
-            if (c != ',' && c != EOF) {
-                ungetc(c, file);
+            if (__peek(reader) == ',') {
+                reader->pos++;
             }
         }
     }
 
     if (items_read != values_len) {
-        if (!feof(file)) {
+        if (__peek(reader) != EOF) {
             printf("[ERROR] Invalid input format, expected %d values per line\n", values_len);
         }
         return false;
     }
 
     int c;
-    while ((c = fgetc(file)) != EOF && c != '\n') {
-        // Do nothing, just consume the characters
+    while ((c = __peek(reader)) != EOF) {
+        reader->pos++;
+        if (c == '\n') {
+            break;
+        }
     }
 
     return true;
 }
 
-bool data_reader_next_vector(FILE *file, f_vector_t *vector_ptr) {
-    if (file == NULL) {
+// after next_values failed: true at the end of the file, false on a malformed line
+bool data_reader_at_end(data_reader_t *reader) {
+    return (reader != NULL) && (__peek(reader) == EOF);
+}
+
+bool data_reader_read_at(data_reader_t *reader, off_t offset, size_t len, float *values_ptr, const int values_len) {
+    if (reader == NULL) {
+        printf("[ERROR] No file open\n");
+        return false;
+    }
+
+    if (len > reader->cap) {
+        printf("[ERROR] Line too long for random access (%zu bytes)\n", len);
+        return false;
+    }
+
+    // the window now holds exactly one line, sequential reading is over
+    size_t got = 0;
+    while (got < len) {
+        const ssize_t n = pread(reader->fd, reader->buf + got, len - got, offset + (off_t)got);
+
+        if (n > 0) {
+            got += (size_t)n;
+            continue;
+        }
+
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+
+        break;
+    }
+
+    reader->pos = 0;
+    reader->end = got;
+    reader->eof = true;
+
+    reader->buf[reader->end] = '\0';
+
+    return data_reader_next_values(reader, values_ptr, values_len);
+}
+
+bool data_reader_next_vector(data_reader_t *reader, f_vector_t *vector_ptr) {
+    if (reader == NULL) {
         printf("[ERROR] No file open\n");
         return false;
     }
@@ -114,11 +415,11 @@ bool data_reader_next_vector(FILE *file, f_vector_t *vector_ptr) {
         return false;
     }
 
-    return data_reader_next_values(file, vector_ptr->ptr, vector_ptr->len);
+    return data_reader_next_values(reader, vector_ptr->ptr, vector_ptr->len);
 }
 
-bool data_reader_next_matrix(FILE *file, f_matrix_t *matrix_ptr) {
-    if (file == NULL) {
+bool data_reader_next_matrix(data_reader_t *reader, f_matrix_t *matrix_ptr) {
+    if (reader == NULL) {
         printf("[ERROR] No file open\n");
         return false;
     }
@@ -129,7 +430,7 @@ bool data_reader_next_matrix(FILE *file, f_matrix_t *matrix_ptr) {
     }
 
     for (int i = 0; i < matrix_ptr->row; i++) {
-        if (!data_reader_next_values(file, f_matrix_row(matrix_ptr, i), matrix_ptr->col)) {
+        if (!data_reader_next_values(reader, f_matrix_row(matrix_ptr, i), matrix_ptr->col)) {
             return false;
         }
     }
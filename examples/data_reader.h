@@ -9,20 +9,41 @@
 #ifndef DATA_READER_H
 #define DATA_READER_H
 
-#include <stdbool.h> // bool
-#include <stdio.h>   // FILE
+#include <stdbool.h>    // bool
+#include <stddef.h>     // size_t
+#include <sys/types.h>  // off_t
 
 #include "g_page.h" // f_matrix_t
 
-FILE *data_reader_open(const char *filename);
+// -----------------------------------------------------------------------------
+
+#define DATA_READER_BLOCK_SIZE (1 << 20) // bytes pulled per read()
+#define DATA_READER_TOKEN_MAX  256       // longest number kept contiguous
+
+typedef struct data_reader_t {
+    int    fd;
+    char  *buf; // sliding window over the file (NUL-terminated at end)
+    size_t cap; // capacity of buf
+    size_t pos; // next byte to parse
+    size_t end; // end of valid bytes in buf
+    bool   eof; // no more bytes from read()
+} data_reader_t;
+
+// -----------------------------------------------------------------------------
+
+data_reader_t *data_reader_open(const char *filename);
+
+void data_reader_close(data_reader_t **reader);
+
+bool data_reader_next_values(data_reader_t *reader, float *values_ptr, const int values_len);
 
-void data_reader_close(FILE **file);
+bool data_reader_at_end(data_reader_t *reader);
 
-bool data_reader_next_values(FILE *file, float *values_ptr, const int values_len);
+bool data_reader_read_at(data_reader_t *reader, off_t offset, size_t len, float *values_ptr, const int values_len);
 
-bool data_reader_next_vector(FILE *file, f_vector_t *vector_ptr);
+bool data_reader_next_vector(data_reader_t *reader, f_vector_t *vector_ptr);
 
-bool data_reader_next_matrix(FILE *file, f_matrix_t *matrix_ptr);
+bool data_reader_next_matrix(data_reader_t *reader, f_matrix_t *matrix_ptr);
 
 #endif // DATA_READER_H
 
@@ -0,0 +1,278 @@
+// -----------------------------------------------------------------------------
+// @file data_spooler.c
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#include "data_spooler.h"
+
+#include <sched.h>  // sched_yield
+#include <stdio.h>  // printf, snprintf
+#include <stdlib.h> // calloc, free, realloc
+#include <string.h> // memcpy, memset
+#include <time.h>   // clock_gettime, nanosleep, CLOCK_MONOTONIC
+
+#include "g_trace.h" // G_TRACE_BEGIN, G_TRACE_END, g_trace_thread_name
+
+// -----------------------------------------------------------------------------
+
+static double __now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void __backoff(int *spins) {
+    if (++(*spins) < 64) {
+        sched_yield();
+    } else {
+        const struct timespec ts = {0, 50000}; // 50 us
+        nanosleep(&ts, NULL);
+    }
+}
+
+static bool __write_snapshot(data_spooler_t *sp) {
+    data_writer_t *file = data_writer_open(sp->stage_filename);
+    if (file == NULL) {
+        return false;
+    }
+
+    bool rvalue = true;
+
+    float *ptr = sp->stage;
+
+    char remark[32] = {0};
+    for (int k = 0; k < sp->stage_pages->len && rvalue; ++k) {
+        f_matrix_t w = sp->stage_pages->ptr[k].w;
+        w.ptr        = ptr;
+
+        snprintf(remark, sizeof(remark), "Layer %d weights", k);
+
+        rvalue = data_writer_next_remark(file, remark) && data_writer_next_matrix(file, &w);
+
+        ptr += (size_t)w.row * w.col;
+    }
+
+    rvalue = data_writer_flush(file) && rvalue;
+
+    data_writer_close(&file);
+
+    return rvalue;
+}
+
+static void *__consumer(void *arg) {
+    data_spooler_t *sp = arg;
+
+    size_t head  = atomic_load_explicit(&sp->head, memory_order_relaxed);
+    int    spins = 0;
+
+    g_trace_thread_name("spooler");
+
+    while (true) {
+        const size_t tail = atomic_load_explicit(&sp->tail, memory_order_acquire);
+
+        if (head != tail) {
+            f_vector_t record;
+            record.ptr = sp->ring + (head & (sp->capacity - 1)) * sp->values_len;
+            record.len = sp->values_len;
+
+            G_TRACE_BEGIN(t0);
+
+            const bool rvalue = sp->argmax ? data_writer_next_argmax(sp->writer, &record)
+                                           : data_writer_next_vector(sp->writer, &record);
+
+            G_TRACE_END(t0, "spool output", "io");
+
+            if (!rvalue) {
+                atomic_store(&sp->failed, true);
+            }
+
+            atomic_store_explicit(&sp->head, ++head, memory_order_release);
+            spins = 0;
+            continue;
+        }
+
+        if (atomic_load_explicit(&sp->stage_state, memory_order_acquire) == DATA_SPOOLER_PENDING) {
+            G_TRACE_BEGIN(t0);
+
+            if (!__write_snapshot(sp)) {
+                atomic_store(&sp->failed, true);
+            }
+
+            G_TRACE_END(t0, "weights snapshot", "io");
+
+            atomic_store_explicit(&sp->stage_state, DATA_SPOOLER_IDLE, memory_order_release);
+            continue;
+        }
+
+        // exit once the compute loop is done and everything it queued is written
+        if (atomic_load_explicit(&sp->stop, memory_order_acquire)) {
+            const bool drained = head == atomic_load_explicit(&sp->tail, memory_order_acquire);
+            const bool staged  = atomic_load_explicit(&sp->stage_state, memory_order_acquire) == DATA_SPOOLER_PENDING;
+
+            if (drained && !staged) {
+                break;
+            }
+            continue;
+        }
+
+        __backoff(&spins);
+    }
+
+    return NULL;
+}
+
+bool data_spooler_open(data_spooler_t *sp, data_writer_t *writer, int values_len, bool argmax, size_t capacity) {
+    if (sp == NULL || writer == NULL || values_len <= 0 || capacity < 2 || (capacity & (capacity - 1)) != 0) {
+        printf("[ERROR] Invalid arguments for spooler open\n");
+        return false;
+    }
+
+    memset(sp, 0, sizeof(*sp));
+
+    sp->writer     = writer;
+    sp->argmax     = argmax;
+    sp->values_len = values_len;
+    sp->capacity   = capacity;
+
+    atomic_init(&sp->head, 0);
+    atomic_init(&sp->tail, 0);
+    atomic_init(&sp->stage_state, DATA_SPOOLER_IDLE);
+    atomic_init(&sp->stop, false);
+    atomic_init(&sp->failed, false);
+
+    sp->ring = calloc(capacity * values_len, sizeof(float));
+    if (sp->ring == NULL) {
+        printf("[ERROR] Unable to allocate spooler ring\n");
+        return false;
+    }
+
+    sp->thread_ok = pthread_create(&sp->thread, NULL, __consumer, sp) == 0;
+    if (!sp->thread_ok) {
+        printf("[ERROR] Unable to start spooler thread\n");
+        free(sp->ring);
+        sp->ring = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+bool data_spooler_close(data_spooler_t *sp) {
+    if (sp == NULL) {
+        return false;
+    }
+
+    if (sp->thread_ok) {
+        atomic_store_explicit(&sp->stop, true, memory_order_release);
+
+        pthread_join(sp->thread, NULL);
+
+        sp->thread_ok = false;
+    }
+
+    free(sp->ring);
+    free(sp->stage);
+
+    sp->ring  = NULL;
+    sp->stage = NULL;
+
+    return !atomic_load(&sp->failed);
+}
+
+bool data_spooler_push(data_spooler_t *sp, f_vector_t *vector_ptr) {
+    if (sp == NULL || sp->ring == NULL || vector_ptr == NULL || vector_ptr->len != sp->values_len) {
+        printf("[ERROR] Invalid arguments for spooler push\n");
+        return false;
+    }
+
+    const size_t tail = atomic_load_explicit(&sp->tail, memory_order_relaxed);
+
+    // full: wait for the writer thread to free one record
+    if (tail - atomic_load_explicit(&sp->head, memory_order_acquire) == sp->capacity) {
+        const double t0    = __now();
+        int          spins = 0;
+
+        G_TRACE_BEGIN(t1);
+
+        while (tail - atomic_load_explicit(&sp->head, memory_order_acquire) == sp->capacity) {
+            __backoff(&spins);
+        }
+
+        G_TRACE_END(t1, "spooler full", "queue");
+
+        sp->stall_seconds += __now() - t0;
+    }
+
+    memcpy(sp->ring + (tail & (sp->capacity - 1)) * sp->values_len, vector_ptr->ptr, sp->values_len * sizeof(float));
+
+    atomic_store_explicit(&sp->tail, tail + 1, memory_order_release);
+
+    return !atomic_load_explicit(&sp->failed, memory_order_relaxed);
+}
+
+bool data_spooler_snapshot(data_spooler_t *sp, g_pages_t *pages, const char *filename) {
+    if (sp == NULL || sp->ring == NULL || pages == NULL || filename == NULL) {
+        printf("[ERROR] Invalid arguments for spooler snapshot\n");
+        return false;
+    }
+
+    // the staging buffer is still being written
+    if (atomic_load_explicit(&sp->stage_state, memory_order_acquire) != DATA_SPOOLER_IDLE) {
+        const double t0    = __now();
+        int          spins = 0;
+
+        G_TRACE_BEGIN(t1);
+
+        while (atomic_load_explicit(&sp->stage_state, memory_order_acquire) != DATA_SPOOLER_IDLE) {
+            __backoff(&spins);
+        }
+
+        G_TRACE_END(t1, "snapshot busy", "queue");
+
+        sp->stall_seconds += __now() - t0;
+    }
+
+    size_t stage_len = 0;
+    for (int k = 0; k < pages->len; ++k) {
+        stage_len += (size_t)pages->ptr[k].w.row * pages->ptr[k].w.col;
+    }
+
+    if (stage_len > sp->stage_len) {
+        float *stage = realloc(sp->stage, stage_len * sizeof(float));
+        if (stage == NULL) {
+            printf("[ERROR] Unable to allocate spooler staging buffer\n");
+            return false;
+        }
+
+        sp->stage     = stage;
+        sp->stage_len = stage_len;
+    }
+
+    float *ptr = sp->stage;
+    for (int k = 0; k < pages->len; ++k) {
+        const size_t len = (size_t)pages->ptr[k].w.row * pages->ptr[k].w.col;
+
+        memcpy(ptr, pages->ptr[k].w.ptr, len * sizeof(float));
+        ptr += len;
+    }
+
+    sp->stage_pages    = pages;
+    sp->stage_filename = filename;
+
+    atomic_store_explicit(&sp->stage_state, DATA_SPOOLER_PENDING, memory_order_release);
+
+    return !atomic_load_explicit(&sp->failed, memory_order_relaxed);
+}
+
+long data_spooler_depth(data_spooler_t *sp) {
+    const size_t head = atomic_load_explicit(&sp->head, memory_order_acquire);
+    const size_t tail = atomic_load_explicit(&sp->tail, memory_order_acquire);
+
+    return (tail >= head) ? (long)(tail - head) : 0;
+}
+
+// -----------------------------------------------------------------------------
+// End of File
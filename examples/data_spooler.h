@@ -0,0 +1,79 @@
+// -----------------------------------------------------------------------------
+// @file data_spooler.h
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#ifndef DATA_SPOOLER_H
+#define DATA_SPOOLER_H
+
+#include <pthread.h>   // pthread_t
+#include <stdatomic.h> // atomic_size_t, atomic_int, atomic_bool
+#include <stdbool.h>   // bool
+#include <stddef.h>    // size_t
+
+#include "data_writer.h" // data_writer_t
+#include "g_page.h"      // f_vector_t, g_pages_t
+
+// -----------------------------------------------------------------------------
+/*
+ * A writer thread drains a single-producer/single-consumer ring of output
+ * vectors into a data_writer_t, so the compute loop only copies a vector and
+ * moves on. Weight snapshots are copied into a staging buffer and serialized
+ * by the same thread. The compute loop waits only when the ring is full or a
+ * previous snapshot is still being written; that time is accumulated in
+ * stall_seconds.
+ */
+
+#define DATA_SPOOLER_CAPACITY 4096 // queued vectors (power of two)
+
+typedef enum data_spooler_stage_t {
+    DATA_SPOOLER_IDLE,    // staging buffer free
+    DATA_SPOOLER_PENDING, // snapshot copied, waiting for the writer thread
+} data_spooler_stage_t;
+
+typedef struct data_spooler_t {
+    data_writer_t *writer; // outputs sink, not owned
+    bool           argmax; // write the argmax instead of the whole vector
+
+    int    values_len;
+    size_t capacity;
+    float *ring; // [capacity][values_len]
+
+    atomic_size_t head; // next record to write (writer thread)
+    atomic_size_t tail; // next record to fill (compute loop)
+
+    // weight snapshot
+    float      *stage;
+    size_t      stage_len;
+    g_pages_t  *stage_pages; // shapes of the staged matrices
+    const char *stage_filename;
+    atomic_int  stage_state;
+
+    atomic_bool stop;
+    atomic_bool failed;
+    pthread_t   thread;
+    bool        thread_ok;
+
+    double stall_seconds; // time the compute loop spent waiting
+} data_spooler_t;
+
+// -----------------------------------------------------------------------------
+
+bool data_spooler_open(data_spooler_t *sp, data_writer_t *writer, int values_len, bool argmax, size_t capacity);
+
+bool data_spooler_close(data_spooler_t *sp);
+
+bool data_spooler_push(data_spooler_t *sp, f_vector_t *vector_ptr);
+
+bool data_spooler_snapshot(data_spooler_t *sp, g_pages_t *pages, const char *filename);
+
+// records queued and not yet written, callable from any thread
+long data_spooler_depth(data_spooler_t *sp);
+
+#endif // DATA_SPOOLER_H
+
+// -----------------------------------------------------------------------------
+// End of File
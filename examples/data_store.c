@@ -0,0 +1,141 @@
+// -----------------------------------------------------------------------------
+// @file data_store.c
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#include "data_store.h"
+
+#include <stdio.h>  // printf
+#include <stdlib.h> // free, realloc
+#include <string.h> // memset
+
+#include "data_reader.h"
+
+// -----------------------------------------------------------------------------
+
+static bool __reserve(data_store_t *store, long samples) {
+    if (samples <= store->capacity) {
+        return true;
+    }
+
+    long capacity = store->capacity > 0 ? store->capacity : 1024;
+    while (capacity < samples) {
+        capacity *= 2;
+    }
+
+    float *x = realloc(store->x, (size_t)capacity * store->x_len * sizeof(float));
+    if (x == NULL) {
+        return false;
+    }
+    store->x = x;
+
+    if (store->t_len > 0) {
+        float *t = realloc(store->t, (size_t)capacity * store->t_len * sizeof(float));
+        if (t == NULL) {
+            return false;
+        }
+        store->t = t;
+    }
+
+    store->capacity = capacity;
+
+    return true;
+}
+
+bool data_store_load(data_store_t *store, const char *dataset_filename, const char *outputs_filename, int x_len, int t_len) {
+    if (store == NULL || x_len <= 0 || t_len < 0) {
+        printf("[ERROR] Invalid arguments for store load\n");
+        return false;
+    }
+
+    memset(store, 0, sizeof(*store));
+
+    store->x_len = x_len;
+    store->t_len = outputs_filename != NULL ? t_len : 0;
+
+    data_reader_t *dataset = data_reader_open(dataset_filename);
+    data_reader_t *outputs = store->t_len > 0 ? data_reader_open(outputs_filename) : NULL;
+
+    bool rvalue = (dataset != NULL) && ((store->t_len == 0) || (outputs != NULL));
+
+    while (rvalue) {
+        if (!__reserve(store, store->samples + 1)) {
+            printf("[ERROR] Unable to allocate dataset store\n");
+            rvalue = false;
+            break;
+        }
+
+        float *x_row = store->x + (size_t)store->samples * x_len;
+
+        if (!data_reader_next_values(dataset, x_row, x_len)) {
+            break;
+        }
+
+        if (store->t_len > 0) {
+            float *t_row = store->t + (size_t)store->samples * store->t_len;
+
+            // every stored sample is complete: stop at the shorter file
+            if (!data_reader_next_values(outputs, t_row, store->t_len)) {
+                break;
+            }
+        }
+
+        store->samples++;
+    }
+
+    data_reader_close(&dataset);
+    data_reader_close(&outputs);
+
+    if (rvalue && store->samples == 0) {
+        printf("[ERROR] Empty dataset '%s'\n", dataset_filename);
+        rvalue = false;
+    }
+
+    if (!rvalue) {
+        data_store_close(store);
+    }
+
+    return rvalue;
+}
+
+void data_store_close(data_store_t *store) {
+    if (store != NULL) {
+        free(store->x);
+        free(store->t);
+
+        store->x        = NULL;
+        store->t        = NULL;
+        store->samples  = 0;
+        store->capacity = 0;
+    }
+}
+
+bool data_store_bind_sample(data_store_t *store, long index, f_vector_t *inputs, f_vector_t *targets) {
+    if (store == NULL || store->x == NULL || index < 0 || index >= store->samples) {
+        return false;
+    }
+
+    if (inputs != NULL) {
+        if (inputs->len != store->x_len) {
+            return false;
+        }
+
+        inputs->ptr = store->x + (size_t)index * store->x_len;
+    }
+
+    if (targets != NULL) {
+        if (store->t == NULL || targets->len != store->t_len) {
+            return false;
+        }
+
+        targets->ptr = store->t + (size_t)index * store->t_len;
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// End of File
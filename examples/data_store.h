@@ -0,0 +1,42 @@
+// -----------------------------------------------------------------------------
+// @file data_store.h
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#ifndef DATA_STORE_H
+#define DATA_STORE_H
+
+#include <stdbool.h> // bool
+
+#include "g_page.h" // f_vector_t
+
+// -----------------------------------------------------------------------------
+/*
+ * A text dataset parsed once into two contiguous arrays, so that multi-epoch
+ * training can visit samples in any order by binding vectors to rows.
+ */
+
+typedef struct data_store_t {
+    float *x;        // [samples][x_len]
+    float *t;        // [samples][t_len], NULL without outputs
+    long   samples;  // number of samples with inputs (and targets)
+    long   capacity; // allocated samples
+    int    x_len;
+    int    t_len;
+} data_store_t;
+
+// -----------------------------------------------------------------------------
+
+bool data_store_load(data_store_t *store, const char *dataset_filename, const char *outputs_filename, int x_len, int t_len);
+
+void data_store_close(data_store_t *store);
+
+bool data_store_bind_sample(data_store_t *store, long index, f_vector_t *inputs, f_vector_t *targets);
+
+#endif // DATA_STORE_H
+
+// -----------------------------------------------------------------------------
+// End of File
@@ -8,36 +8,279 @@
 
 #include "data_writer.h"
 
-#include <errno.h>  // errno
-#include <stdio.h>  // FILE, fopen, fclose, fprintf
-#include <string.h> // strerror
+#include <errno.h>  // errno, EINTR
+#include <fcntl.h>  // open, O_CREAT, O_TRUNC, O_WRONLY
+#include <math.h>   // floor, isinf, isnan, log10, signbit
+#include <stdint.h> // uint64_t
+#include <stdio.h>  // printf, snprintf
+#include <stdlib.h> // calloc, free, strtof
+#include <string.h> // memcpy, strerror, strlen
+#include <unistd.h> // close, lseek, write
 
 // -----------------------------------------------------------------------------
 
-FILE *data_writer_open(const char *filename) {
+// exact powers of ten representable in a double (10^0 ... 10^22)
+static const double __pow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+static const uint64_t __pow10_u64[] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+};
+
+static bool __write_all(int fd, const char *ptr, size_t len) {
+    while (len > 0) {
+        const ssize_t n = write(fd, ptr, len);
+
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+
+        ptr += n;
+        len -= (size_t)n;
+    }
+
+    return true;
+}
+
+static inline bool __reserve(data_writer_t *writer, size_t len) {
+    return (writer->cap - writer->len >= len) || data_writer_flush(writer);
+}
+
+static inline double __scale(double value, int exp10) {
+    return exp10 < 0 ? value / __pow10[-exp10] : value * __pow10[exp10];
+}
+
+// value * 10^exp10 over the whole float range (|exp10| up to 2 * 22 + 9)
+static inline double __scale_wide(double value, int exp10) {
+    while (exp10 > 22) {
+        value *= __pow10[22];
+        exp10 -= 22;
+    }
+    while (exp10 < -22) {
+        value /= __pow10[22];
+        exp10 += 22;
+    }
+    return __scale(value, exp10);
+}
+
+// True when digits * 10^exp10 reads back as value. For |exp10| <= 22 this is
+// exactly the arithmetic of data_reader's fast path (one double operation on
+// exact operands, rounded again to float); otherwise it mirrors its strtof
+// fallback.
+static bool __round_trips(uint64_t digits, int exp10, float value) {
+    if (exp10 >= -22 && exp10 <= 22) {
+        return (float)__scale((double)digits, exp10) == value;
+    }
+
+    char text[20 + 1 + 11 + 1]; // uint64_t digits, 'e', signed int exponent
+    snprintf(text, sizeof(text), "%llue%d", (unsigned long long)digits, exp10);
+
+    return strtof(text, NULL) == value;
+}
+
+static int __emit_digits(char *text, uint64_t digits, int count, int exp10) {
+    char dec[10];
+    for (int i = count - 1; i >= 0; --i) {
+        dec[i] = (char)('0' + digits % 10);
+        digits /= 10;
+    }
+
+    char *p = text;
+
+    if (exp10 >= -5 && exp10 < 9) {
+        // fixed notation
+        if (exp10 < 0) {
+            *p++ = '0';
+            *p++ = '.';
+            for (int i = 0; i < -exp10 - 1; ++i) {
+                *p++ = '0';
+            }
+            for (int i = 0; i < count; ++i) {
+                *p++ = dec[i];
+            }
+        } else if (count <= exp10 + 1) {
+            for (int i = 0; i < count; ++i) {
+                *p++ = dec[i];
+            }
+            for (int i = count; i <= exp10; ++i) {
+                *p++ = '0';
+            }
+        } else {
+            for (int i = 0; i <= exp10; ++i) {
+                *p++ = dec[i];
+            }
+            *p++ = '.';
+            for (int i = exp10 + 1; i < count; ++i) {
+                *p++ = dec[i];
+            }
+        }
+    } else {
+        // scientific notation
+        *p++ = dec[0];
+        if (count > 1) {
+            *p++ = '.';
+            for (int i = 1; i < count; ++i) {
+                *p++ = dec[i];
+            }
+        }
+
+        *p++ = 'e';
+        if (exp10 < 0) {
+            *p++ = '-';
+        }
+
+        const int e = exp10 < 0 ? -exp10 : exp10;
+        if (e >= 100) {
+            *p++ = (char)('0' + e / 100);
+        }
+        *p++ = (char)('0' + (e / 10) % 10);
+        *p++ = (char)('0' + e % 10);
+    }
+
+    return (int)(p - text);
+}
+
+// Shortest decimal (at most 9 significant digits) that reads back as the same
+// float; returns the number of characters written (no terminator).
+int data_writer_format_value(char *text, float value) {
+    char *p = text;
+
+    if (isnan(value)) {
+        memcpy(p, "nan", 3);
+        return 3;
+    }
+
+    if (signbit(value)) {
+        *p++  = '-';
+        value = -value;
+    }
+
+    if (isinf(value)) {
+        memcpy(p, "inf", 3);
+        return (int)(p - text) + 3;
+    }
+
+    if (value == 0.0f) {
+        *p++ = '0';
+        return (int)(p - text);
+    }
+
+    const double v = value;
+
+    // decimal exponent of the leading digit (log10 may be off by one)
+    int k = (int)floor(log10(v));
+
+    for (int count = 1; count <= 9; ++count) {
+        int      scale  = count - 1 - k;
+        uint64_t digits = (uint64_t)(__scale_wide(v, scale) + 0.5);
+
+        if (digits >= __pow10_u64[count]) {
+            digits /= 10; // rounded up to the next power of ten
+            scale -= 1;
+        } else if (digits < __pow10_u64[count - 1]) {
+            continue; // k overestimated, the next count re-scales
+        }
+
+        if (__round_trips(digits, -scale, value)) {
+            return (int)(p - text) + __emit_digits(p, digits, count, count - 1 - scale);
+        }
+    }
+
+    // unreachable for correctly rounded arithmetic, kept as a safety net
+    return (int)(p - text) + snprintf(p, DATA_WRITER_VALUE_MAX - 1, "%.8e", v);
+}
+
+data_writer_t *data_writer_open(const char *filename) {
     if (filename == NULL) {
         printf("[ERROR] Invalid filename\n");
         return NULL;
     }
 
-    FILE *file = fopen(filename, "w");
-    if (file == NULL) {
+    const int fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
         printf("[ERROR] Unable to open file '%s': %s\n", filename, strerror(errno));
         return NULL;
     }
 
-    return file;
+    data_writer_t *writer = calloc(1, sizeof(data_writer_t));
+    char          *buf    = calloc(DATA_WRITER_BLOCK_SIZE, 1);
+
+    if (writer == NULL || buf == NULL) {
+        printf("[ERROR] Unable to allocate writer for '%s'\n", filename);
+        free(writer);
+        free(buf);
+        close(fd);
+        return NULL;
+    }
+
+    writer->fd     = fd;
+    writer->buf    = buf;
+    writer->cap    = DATA_WRITER_BLOCK_SIZE;
+    writer->len    = 0;
+    writer->format = DATA_WRITER_TEXT;
+
+    return writer;
 }
 
-void data_writer_close(FILE **file) {
-    if (*file != NULL) {
-        fclose(*file);
-        *file = NULL;
+data_writer_t *data_writer_open_binary(const char *filename, int values_len) {
+    data_mapper_header_t header;
+
+    if (!data_mapper_header_init(&header, values_len, 0)) {
+        return NULL;
+    }
+
+    data_writer_t *writer = data_writer_open(filename);
+
+    if (writer != NULL) {
+        writer->format = DATA_WRITER_BINARY;
+        writer->header = header;
+
+        // room for the header, patched with the sample count on close
+        memset(writer->buf, 0, header.data_offset);
+        writer->len = header.data_offset;
     }
+
+    return writer;
 }
 
-bool data_writer_next_remark(FILE *file, const char *remark) {
-    if (file == NULL) {
+void data_writer_close(data_writer_t **writer) {
+    if (*writer != NULL) {
+        data_writer_t *w = *writer;
+
+        data_writer_flush(w);
+
+        if (w->format == DATA_WRITER_BINARY) {
+            if ((lseek(w->fd, 0, SEEK_SET) != 0) || !__write_all(w->fd, (const char *)&w->header, sizeof(w->header))) {
+                printf("[ERROR] Unable to finalize binary header\n");
+            }
+        }
+
+        close(w->fd);
+        free(w->buf);
+        free(w);
+        *writer = NULL;
+    }
+}
+
+bool data_writer_flush(data_writer_t *writer) {
+    if (writer == NULL) {
+        return false;
+    }
+
+    const bool rvalue = __write_all(writer->fd, writer->buf, writer->len);
+
+    writer->len = 0;
+
+    return rvalue;
+}
+
+bool data_writer_next_remark(data_writer_t *writer, const char *remark) {
+    if (writer == NULL) {
         printf("[ERROR] No file open\n");
         return false;
     }
@@ -47,11 +290,37 @@ bool data_writer_next_remark(FILE *file, const char *remark) {
         return false;
     }
 
-    return fprintf(file, "# %s\n", remark) > 0;
+    if (writer->format == DATA_WRITER_BINARY) {
+        return true; // no comments in binary records
+    }
+
+    const size_t len = strlen(remark);
+
+    if (!__reserve(writer, len + 3)) {
+        return false;
+    }
+
+    if (len + 3 > writer->cap) {
+        return __write_all(writer->fd, "# ", 2)          //
+               && __write_all(writer->fd, remark, len) //
+               && __write_all(writer->fd, "\n", 1);
+    }
+
+    char *p = writer->buf + writer->len;
+
+    *p++ = '#';
+    *p++ = ' ';
+    memcpy(p, remark, len);
+    p += len;
+    *p++ = '\n';
+
+    writer->len = (size_t)(p - writer->buf);
+
+    return true;
 }
 
-bool data_writer_next_values(FILE *file, float *values_ptr, const int values_len) {
-    if (file == NULL) {
+bool data_writer_next_values(data_writer_t *writer, float *values_ptr, const int values_len) {
+    if (writer == NULL) {
         printf("[ERROR] No file open\n");
         return false;
     }
@@ -61,26 +330,45 @@ bool data_writer_next_values(FILE *file, float *values_ptr, const int values_len
         return false;
     }
 
-    for (int i = 0; i < values_len; i++) {
-        if (fprintf(file, "%14.6e", values_ptr[i]) < 0) {
+    if (writer->format == DATA_WRITER_BINARY) {
+        if ((int)writer->header.x_len != values_len) {
+            printf("[ERROR] Invalid input format, expected %u values per record\n", writer->header.x_len);
             return false;
         }
-        if (i < values_len - 1) {
-            if (fprintf(file, ",") < 0) {
-                return false;
-            }
+
+        const size_t stride = writer->header.stride;
+
+        if (!__reserve(writer, stride)) {
+            return false;
         }
+
+        memset(writer->buf + writer->len, 0, stride);
+        memcpy(writer->buf + writer->len, values_ptr, values_len * sizeof(float));
+
+        writer->len += stride;
+        writer->header.samples++;
+
+        return true;
     }
 
-    if (fprintf(file, "\n") < 0) {
-        return false;
+    for (int i = 0; i < values_len; i++) {
+        if (!__reserve(writer, DATA_WRITER_VALUE_MAX + 1)) {
+            return false;
+        }
+
+        char *p = writer->buf + writer->len;
+
+        p += data_writer_format_value(p, values_ptr[i]);
+        *p++ = (i < values_len - 1) ? ',' : '\n';
+
+        writer->len = (size_t)(p - writer->buf);
     }
 
     return true;
 }
 
-bool data_writer_next_vector(FILE *file, f_vector_t *vector_ptr) {
-    if (file == NULL) {
+bool data_writer_next_vector(data_writer_t *writer, f_vector_t *vector_ptr) {
+    if (writer == NULL) {
         printf("[ERROR] No file open\n");
         return false;
     }
@@ -90,11 +378,11 @@ bool data_writer_next_vector(FILE *file, f_vector_t *vector_ptr) {
         return false;
     }
 
-    return data_writer_next_values(file, vector_ptr->ptr, vector_ptr->len);
+    return data_writer_next_values(writer, vector_ptr->ptr, vector_ptr->len);
 }
 
-bool data_writer_next_matrix(FILE *file, f_matrix_t *matrix_ptr) {
-    if (file == NULL) {
+bool data_writer_next_matrix(data_writer_t *writer, f_matrix_t *matrix_ptr) {
+    if (writer == NULL) {
         printf("[ERROR] No file open\n");
         return false;
     }
@@ -105,7 +393,7 @@ bool data_writer_next_matrix(FILE *file, f_matrix_t *matrix_ptr) {
     }
 
     for (int i = 0; i < matrix_ptr->row; i++) {
-        if (!data_writer_next_values(file, f_matrix_row(matrix_ptr, i), matrix_ptr->col)) {
+        if (!data_writer_next_values(writer, f_matrix_row(matrix_ptr, i), matrix_ptr->col)) {
             return false;
         }
     }
@@ -113,5 +401,28 @@ bool data_writer_next_matrix(FILE *file, f_matrix_t *matrix_ptr) {
     return true;
 }
 
+bool data_writer_next_argmax(data_writer_t *writer, f_vector_t *vector_ptr) {
+    if (writer == NULL) {
+        printf("[ERROR] No file open\n");
+        return false;
+    }
+
+    if (vector_ptr == NULL || vector_ptr->ptr == NULL || vector_ptr->len <= 0) {
+        printf("[ERROR] Invalid arguments for next argmax\n");
+        return false;
+    }
+
+    int j_max = 0;
+    for (int j = 1; j < vector_ptr->len; ++j) {
+        if (vector_ptr->ptr[j] > vector_ptr->ptr[j_max]) {
+            j_max = j;
+        }
+    }
+
+    float index = (float)j_max;
+
+    return data_writer_next_values(writer, &index, 1);
+}
+
 // -----------------------------------------------------------------------------
 // End of File
@@ -10,21 +10,51 @@
 #define DATA_WRITER_H
 
 #include <stdbool.h> // bool
-#include <stdio.h>   // FILE
+#include <stddef.h>  // size_t
 
-#include "g_page.h" // f_matrix_t
+#include "data_mapper.h" // data_mapper_header_t
+#include "g_page.h"      // f_matrix_t
 
-FILE *data_writer_open(const char *filename);
+// -----------------------------------------------------------------------------
+
+#define DATA_WRITER_BLOCK_SIZE (1 << 20) // bytes per write()
+#define DATA_WRITER_VALUE_MAX  32        // longest formatted value
+
+typedef enum data_writer_format_t {
+    DATA_WRITER_TEXT,   // comma-separated, shortest round-trip decimals
+    DATA_WRITER_BINARY, // data_mapper records (X only), readable by data_mapper_open
+} data_writer_format_t;
+
+typedef struct data_writer_t {
+    int                  fd;
+    char                *buf;
+    size_t               cap;
+    size_t               len;
+    data_writer_format_t format;
+    data_mapper_header_t header; // binary layout, patched on close
+} data_writer_t;
+
+// -----------------------------------------------------------------------------
+
+data_writer_t *data_writer_open(const char *filename);
+
+data_writer_t *data_writer_open_binary(const char *filename, int values_len);
+
+void data_writer_close(data_writer_t **writer);
+
+bool data_writer_flush(data_writer_t *writer);
+
+bool data_writer_next_remark(data_writer_t *writer, const char *remark);
 
-void data_writer_close(FILE **file);
+bool data_writer_next_values(data_writer_t *writer, float *values_ptr, const int values_len);
 
-bool data_writer_next_remark(FILE *file, const char *remark);
+bool data_writer_next_vector(data_writer_t *writer, f_vector_t *vector_ptr);
 
-bool data_writer_next_values(FILE *file, float *values_ptr, const int values_len);
+bool data_writer_next_matrix(data_writer_t *writer, f_matrix_t *matrix_ptr);
 
-bool data_writer_next_vector(FILE *file, f_vector_t *vector_ptr);
+bool data_writer_next_argmax(data_writer_t *writer, f_vector_t *vector_ptr);
 
-bool data_writer_next_matrix(FILE *file, f_matrix_t *matrix_ptr);
+int data_writer_format_value(char *text, float value);
 
 #endif // DATA_WRITER_H
 
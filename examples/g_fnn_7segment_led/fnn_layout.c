@@ -21,6 +21,8 @@ float             L01_dE_dY[20]  = {0.0f};
 float             L01_LR         = 0.01f;
 g_act_func_type_t L01_AF_TYPE    = LEAKY_RELU;
 float             L01_AF_ARGS[1] = {0.01f};
+float             L01_M[20][8]   = {{0.0f}};
+float             L01_V[20][8]   = {{0.0f}};
 
 // layer 2: hidden layer
 float             L02_W[20][21]  = {{0.0f}};
@@ -31,6 +33,8 @@ float             L02_dE_dY[20]  = {0.0f};
 float             L02_LR         = 0.02f;
 g_act_func_type_t L02_AF_TYPE    = LEAKY_RELU;
 float             L02_AF_ARGS[1] = {0.01f};
+float             L02_M[20][21]  = {{0.0f}};
+float             L02_V[20][21]  = {{0.0f}};
 
 // layer 3: output layer
 float             L03_W[10][21]  = {{0.0f}};
@@ -41,6 +45,8 @@ float             L03_dE_dY[10]  = {0.0f};
 float             L03_LR         = 0.03f;
 g_act_func_type_t L03_AF_TYPE    = SIGMOID;
 float             L03_AF_ARGS[1] = {0.0f};
+float             L03_M[10][21]  = {{0.0f}};
+float             L03_V[10][21]  = {{0.0f}};
 
 // layer 3: actual outputs (Y target)
 float OUT_YT[10] = {0.0f};
@@ -68,6 +74,12 @@ g_pages_t fnn_layout_to_pages(void) {
     page[0].af_type     = L01_AF_TYPE;
     page[0].af_args.ptr = L01_AF_ARGS;
     page[0].af_args.len = SIZEOF(L01_AF_ARGS);
+    page[0].m.ptr       = (float *)L01_M;
+    page[0].m.row       = SIZEOF(L01_M);
+    page[0].m.col       = SIZEOF(L01_M[0]);
+    page[0].v.ptr       = (float *)L01_V;
+    page[0].v.row       = SIZEOF(L01_V);
+    page[0].v.col       = SIZEOF(L01_V[0]);
     // Layer 2
     g_page_reset(&page[1]);
     page[1].l_id        = 1;
@@ -88,6 +100,12 @@ g_pages_t fnn_layout_to_pages(void) {
     page[1].af_type     = L02_AF_TYPE;
     page[1].af_args.ptr = L02_AF_ARGS;
     page[1].af_args.len = SIZEOF(L02_AF_ARGS);
+    page[1].m.ptr       = (float *)L02_M;
+    page[1].m.row       = SIZEOF(L02_M);
+    page[1].m.col       = SIZEOF(L02_M[0]);
+    page[1].v.ptr       = (float *)L02_V;
+    page[1].v.row       = SIZEOF(L02_V);
+    page[1].v.col       = SIZEOF(L02_V[0]);
     // Layer 3
     g_page_reset(&page[2]);
     page[2].l_id        = 2;
@@ -108,6 +126,12 @@ g_pages_t fnn_layout_to_pages(void) {
     page[2].af_type     = L03_AF_TYPE;
     page[2].af_args.ptr = L03_AF_ARGS;
     page[2].af_args.len = SIZEOF(L03_AF_ARGS);
+    page[2].m.ptr       = (float *)L03_M;
+    page[2].m.row       = SIZEOF(L03_M);
+    page[2].m.col       = SIZEOF(L03_M[0]);
+    page[2].v.ptr       = (float *)L03_V;
+    page[2].v.row       = SIZEOF(L03_V);
+    page[2].v.col       = SIZEOF(L03_V[0]);
 
     return (g_pages_t){.ptr = page, .len = SIZEOF(page)};
 }
@@ -8,13 +8,31 @@
 
 #include <libgen.h> // basename
 #include <math.h>   // INFINITY
-#include <stdio.h>  // FILE, NULL, fprintf, printf, puts
-#include <stdlib.h> // atexit, exit
-#include <string.h> // strcmp
-
+#include <stdio.h>  // NULL, fprintf, printf, puts
+#include <stdlib.h> // atexit, atoi, atol, exit, free, malloc, strtof, strtoul
+#include <string.h> // memcpy, strcmp
+#include <time.h>   // clock_gettime, time, CLOCK_MONOTONIC
+#include <unistd.h> // sysconf, _SC_NPROCESSORS_ONLN
+
+#include "data_cache.h"
+#include "data_checkpoint.h"
+#include "data_export.h"
+#include "data_index.h"
+#include "data_mapper.h"
+#include "data_metrics.h"
+#include "data_prefetch.h"
 #include "data_reader.h"
+#include "data_spooler.h"
+#include "data_store.h"
 #include "data_writer.h"
+#include "g_cost.h"
+#include "g_histogram.h"
 #include "g_network.h"
+#include "g_profile.h"
+#include "g_random.h"
+#include "g_scheduler.h"
+#include "g_trace.h"
+#include "g_validator.h"
 
 // -----------------------------------------------------------------------------
 // Neural Network Layout
@@ -37,7 +55,8 @@ typedef enum {
 typedef enum {
     TRAINING   = 0,
     INFERENCE  = 1,
-    VALIDATION = 2
+    VALIDATION = 2,
+    EXPORT     = 3
 } network_modes_t;
 
 // -----------------------------------------------------------------------------
@@ -49,170 +68,1370 @@ char *fnn_dataset_set = "fnn_dataset.set";
 char *fnn_outputs_set = "fnn_outputs.set";
 char *fnn_weights_out = "fnn_weights.out";
 char *fnn_outputs_out = "fnn_outputs.out";
-
-FILE *file_weights_cfg = NULL;
-FILE *file_dataset_set = NULL;
-FILE *file_outputs_set = NULL;
-FILE *file_weights_out = NULL;
-FILE *file_outputs_out = NULL;
+char *fnn_valid_set   = NULL; // held-out dataset checked while training
+char *fnn_valid_out   = NULL; // held-out outputs checked while training
+char *fnn_checkpoint  = NULL; // training state, rewritten periodically
+char *fnn_export_base = NULL; // standalone C inference source, "<base>.c" and "<base>.h"
+
+data_reader_t *file_weights_cfg = NULL;
+data_reader_t *file_dataset_set = NULL;
+data_reader_t *file_outputs_set = NULL;
+
+data_writer_t *file_weights_new = NULL;
+data_writer_t *file_weights_out = NULL;
+data_writer_t *file_outputs_out = NULL;
+
+data_mapper_t   dataset_map   = {.fd = -1};
+data_mapper_t   dataset_cache = {.fd = -1};
+data_mapper_t   outputs_cache = {.fd = -1};
+data_prefetch_t dataset_prefetcher;
+data_spooler_t  outputs_spooler;
+data_store_t    dataset_store;
+data_index_t    dataset_lines = {.fd = -1};
+data_index_t    outputs_lines = {.fd = -1};
+data_mapper_t   valid_map     = {.fd = -1};
+data_store_t    valid_store;
+data_checkpoint_t training_checkpoint;
+data_metrics_t    run_metrics = {.listen_fd = -1};
 
 static void cleanup_resources(void) {
+    data_metrics_close(&run_metrics);
+    data_spooler_close(&outputs_spooler);
     data_reader_close(&file_weights_cfg);
     data_reader_close(&file_dataset_set);
     data_reader_close(&file_outputs_set);
+    data_writer_close(&file_weights_new);
     data_writer_close(&file_weights_out);
     data_writer_close(&file_outputs_out);
+    data_mapper_close(&dataset_map);
+    data_mapper_close(&dataset_cache);
+    data_mapper_close(&outputs_cache);
+    data_prefetch_close(&dataset_prefetcher);
+    data_store_close(&dataset_store);
+    data_index_close(&dataset_lines);
+    data_index_close(&outputs_lines);
+    data_mapper_close(&valid_map);
+    data_store_close(&valid_store);
+    data_checkpoint_close(&training_checkpoint);
 }
 
 // -----------------------------------------------------------------------------
-// Network Mode: TRAINING
+// Sample Feeding
 // -----------------------------------------------------------------------------
 
-static void save_weights_to_file(FILE *file, g_pages_t *pages) {
-    if ((file == NULL) || (pages == NULL)) {
-        exit(ERR_NULL);
+typedef enum {
+    SOURCE_TEXT     = 0, // synchronous data_reader
+    SOURCE_MAPPED   = 1, // binary dataset, zero-copy
+    SOURCE_PREFETCH = 2, // data_reader on a producer thread
+    SOURCE_MEMORY   = 3, // text dataset parsed once into memory
+    SOURCE_INDEXED  = 4, // text dataset read line by line through an index
+    SOURCE_CACHED   = 5  // text dataset parsed once into a mapped sidecar
+} sample_sources_t;
+
+sample_sources_t dataset_source   = SOURCE_TEXT;
+bool             dataset_prefetch = false;
+long             dataset_index    = 0;
+int              dataset_epochs   = 1;
+bool             dataset_indexed  = false;
+bool             dataset_cached   = true;
+
+static bool open_dataset_cache(g_pages_t *pages, bool with_outputs) {
+    bool rvalue = data_cache_open(&dataset_cache, fnn_dataset_set, pages->ptr[0].x.len);
+
+    if (rvalue && with_outputs) {
+        rvalue = data_cache_open(&outputs_cache, fnn_outputs_set, SIZEOF(OUT_YT));
     }
 
-    char remark[32] = {0};
-    for (int k = 0; k < pages->len; ++k) {
-        snprintf(remark, sizeof(remark), "Layer %d weights", k);
+    if (!rvalue) {
+        // not fatal: the text files are parsed as usual
+        printf("[ALERT] Dataset cache unavailable, parsing text files\n");
+        data_mapper_close(&dataset_cache);
+        data_mapper_close(&outputs_cache);
+    }
 
-        data_writer_next_remark(file, remark);
-        data_writer_next_matrix(file, &pages->ptr[k].w);
+    return rvalue;
+}
+
+static void open_dataset(g_network_t *network, g_pages_t *pages, bool with_outputs, bool random_access) {
+    if (data_mapper_probe(fnn_dataset_set)) {
+        if (!data_mapper_open(&dataset_map, fnn_dataset_set)) {
+            network->Destroy(network);
+            exit(ERR_FILE);
+        }
+
+        const bool chk_1 = (int)dataset_map.header.x_len == pages->ptr[0].x.len;
+        const bool chk_2 = (int)dataset_map.header.t_len == SIZEOF(OUT_YT);
+        const bool chk_3 = (dataset_map.header.t_len == 0) && !with_outputs;
+
+        if (!chk_1 || !(chk_2 || chk_3)) {
+            printf("[ERROR] Binary dataset shape mismatch (inputs: %u, outputs: %u)\n",
+                   dataset_map.header.x_len,
+                   dataset_map.header.t_len);
+            network->Destroy(network);
+            exit(ERR_DATA);
+        }
+
+        dataset_source = SOURCE_MAPPED;
+        dataset_index  = 0;
+    } else if (dataset_cached && open_dataset_cache(pages, with_outputs)) {
+        if (with_outputs && (dataset_cache.header.samples != outputs_cache.header.samples)) {
+            printf("[ERROR] Dataset and outputs sample count mismatch (dataset: %llu, outputs: %llu)\n",
+                   (unsigned long long)dataset_cache.header.samples,
+                   (unsigned long long)outputs_cache.header.samples);
+            network->Destroy(network);
+            exit(ERR_DATA);
+        }
+
+        dataset_source = SOURCE_CACHED;
+        dataset_index  = 0;
+    } else if (random_access && dataset_indexed) {
+        if (!data_index_open(&dataset_lines, fnn_dataset_set, pages->ptr[0].x.len)) {
+            network->Destroy(network);
+            exit(ERR_FILE);
+        }
+
+        if (with_outputs && !data_index_open(&outputs_lines, fnn_outputs_set, SIZEOF(OUT_YT))) {
+            network->Destroy(network);
+            exit(ERR_FILE);
+        }
+
+        if (with_outputs && (dataset_lines.header.lines != outputs_lines.header.lines)) {
+            printf("[ERROR] Dataset and outputs sample count mismatch (dataset: %llu, outputs: %llu)\n",
+                   (unsigned long long)dataset_lines.header.lines,
+                   (unsigned long long)outputs_lines.header.lines);
+            network->Destroy(network);
+            exit(ERR_DATA);
+        }
+
+        dataset_source = SOURCE_INDEXED;
+        dataset_index  = 0;
+    } else if (random_access) {
+        const char *outputs = with_outputs ? fnn_outputs_set : NULL;
+
+        if (!data_store_load(&dataset_store, fnn_dataset_set, outputs, pages->ptr[0].x.len, SIZEOF(OUT_YT))) {
+            network->Destroy(network);
+            exit(ERR_FILE);
+        }
+
+        dataset_source = SOURCE_MEMORY;
+        dataset_index  = 0;
+    } else if (dataset_prefetch) {
+        const char *outputs = with_outputs ? fnn_outputs_set : NULL;
+
+        if (!data_prefetch_open(&dataset_prefetcher,
+                                fnn_dataset_set,
+                                outputs,
+                                pages->ptr[0].x.len,
+                                SIZEOF(OUT_YT),
+                                DATA_PREFETCH_BATCH,
+                                DATA_PREFETCH_DEPTH)) {
+            network->Destroy(network);
+            exit(ERR_FILE);
+        }
+
+        dataset_source = SOURCE_PREFETCH;
+    } else {
+        file_dataset_set = data_reader_open(fnn_dataset_set);
+        if (file_dataset_set == NULL) {
+            network->Destroy(network);
+            exit(ERR_FILE);
+        }
+
+        if (with_outputs) {
+            file_outputs_set = data_reader_open(fnn_outputs_set);
+            if (file_outputs_set == NULL) {
+                network->Destroy(network);
+                exit(ERR_FILE);
+            }
+        }
+
+        dataset_source = SOURCE_TEXT;
     }
 }
 
-static void training_mode(g_network_t *network, g_pages_t *pages) {
-    // layer 3: actual outputs
-    f_vector_t actual_outputs;
-    actual_outputs.ptr = &OUT_YT[0];
-    actual_outputs.len = SIZEOF(OUT_YT);
+static bool next_sample_inputs(f_vector_t *inputs) {
+    bool rvalue;
+
+    G_PROFILE_BEGIN(t0);
+
+    switch (dataset_source) {
+        case SOURCE_MAPPED:
+            // zero-copy: the input layer reads straight from the mapping
+            rvalue = data_mapper_bind_sample(&dataset_map, dataset_index++, inputs, NULL);
+            break;
+        case SOURCE_MEMORY:
+            rvalue = data_store_bind_sample(&dataset_store, dataset_index++, inputs, NULL);
+            break;
+        case SOURCE_INDEXED:
+            rvalue = data_index_bind_sample(&dataset_lines, dataset_index++, inputs);
+            break;
+        case SOURCE_CACHED:
+            rvalue = data_mapper_bind_sample(&dataset_cache, dataset_index++, inputs, NULL);
+            break;
+        case SOURCE_PREFETCH:
+            rvalue = data_prefetch_next_inputs(&dataset_prefetcher, inputs);
+            break;
+        default:
+            rvalue = data_reader_next_vector(file_dataset_set, inputs);
+            break;
+    }
+
+    G_PROFILE_END(t0, G_PROFILE_IO, G_PROFILE_READER);
+
+    return rvalue;
+}
+
+static bool next_sample_targets(f_vector_t *targets) {
+    bool rvalue;
+
+    G_PROFILE_BEGIN(t0);
+
+    switch (dataset_source) {
+        case SOURCE_MAPPED:
+            rvalue = data_mapper_bind_sample(&dataset_map, dataset_index - 1, NULL, targets);
+            break;
+        case SOURCE_MEMORY:
+            rvalue = data_store_bind_sample(&dataset_store, dataset_index - 1, NULL, targets);
+            break;
+        case SOURCE_INDEXED:
+            rvalue = data_index_bind_sample(&outputs_lines, dataset_index - 1, targets);
+            break;
+        case SOURCE_CACHED:
+            // the outputs cache stores targets as its inputs
+            rvalue = data_mapper_bind_sample(&outputs_cache, dataset_index - 1, targets, NULL);
+            break;
+        case SOURCE_PREFETCH:
+            rvalue = data_prefetch_next_targets(&dataset_prefetcher, targets);
+            break;
+        default:
+            rvalue = data_reader_next_vector(file_outputs_set, targets);
+            break;
+    }
+
+    G_PROFILE_END(t0, G_PROFILE_IO, G_PROFILE_READER);
+
+    return rvalue;
+}
+
+static long dataset_samples(void) {
+    switch (dataset_source) {
+        case SOURCE_MAPPED:
+            return (long)dataset_map.header.samples;
+        case SOURCE_MEMORY:
+            return dataset_store.samples;
+        case SOURCE_INDEXED:
+            return (long)dataset_lines.header.lines;
+        case SOURCE_CACHED:
+            return (long)dataset_cache.header.samples;
+        default:
+            return 0; // streaming sources have no random access
+    }
+}
+
+static bool bind_sample(long index, f_vector_t *inputs, f_vector_t *targets) {
+    bool rvalue;
+
+    G_PROFILE_BEGIN(t0);
+
+    switch (dataset_source) {
+        case SOURCE_MAPPED:
+            rvalue = data_mapper_bind_sample(&dataset_map, index, inputs, targets);
+            break;
+        case SOURCE_MEMORY:
+            rvalue = data_store_bind_sample(&dataset_store, index, inputs, targets);
+            break;
+        case SOURCE_INDEXED:
+            rvalue = ((inputs == NULL) || data_index_bind_sample(&dataset_lines, index, inputs))
+                     && ((targets == NULL) || data_index_bind_sample(&outputs_lines, index, targets));
+            break;
+        case SOURCE_CACHED:
+            rvalue = ((inputs == NULL) || data_mapper_bind_sample(&dataset_cache, index, inputs, NULL))
+                     && ((targets == NULL) || data_mapper_bind_sample(&outputs_cache, index, targets, NULL));
+            break;
+        default:
+            rvalue = false;
+            break;
+    }
+
+    G_PROFILE_END(t0, G_PROFILE_IO, G_PROFILE_READER);
+
+    return rvalue;
+}
+
+// -----------------------------------------------------------------------------
+// Learning Rate
+// -----------------------------------------------------------------------------
+
+float learning_rate = 0.0f; // fixed rate for every layer, 0: per-layer adjustment
+
+static void set_learning_rate(g_pages_t *pages, g_optim_type_t op_type) {
+    // the per-layer adjustment is tuned for plain SGD steps
+    if (learning_rate == 0.0f) {
+        switch (op_type) {
+            case MOMENTUM:
+            case NESTEROV:
+                learning_rate = 0.01f;
+                break;
+            case RMSPROP:
+            case ADAM:
+                learning_rate = 0.001f;
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (learning_rate > 0.0f) {
+        for (int k = 0; k < pages->len; ++k) {
+            pages->ptr[k].lr = learning_rate;
+        }
+
+        printf("[INFO] Fixed learning rate: %g\n", learning_rate);
+    }
+}
+
+g_sched_type_t schedule_type  = ADAPTIVE;
+bool           schedule_set   = false; // default: ADAPTIVE unless the rate is fixed
+long           schedule_every = 0;     // samples per evaluation, 0: one epoch
+
+static g_sched_args_t scheduler_defaults(g_sched_type_t type, int total) {
+    g_sched_args_t args = {0};
+
+    args.period    = schedule_every;
+    args.total     = total;
+    args.step_size = total > 3 ? total / 3 : 1;
+    args.gamma     = 0.1f;
+    args.warmup    = (type == ONE_CYCLE) ? (3 * total) / 10 : (total > 10 ? total / 10 : 1);
+    args.patience  = 2;
+    args.factor    = 0.5f;
+    args.threshold = 1e-4f;
+    args.min_scale = (type == COSINE || type == ONE_CYCLE) ? 0.0f : 0.01f;
+    args.max_scale = 10.0f;
+
+    return args;
+}
+
+static void open_scheduler(g_network_t *network, g_scheduler_t *scheduler) {
+    if (!schedule_set) {
+        schedule_type = (learning_rate == 0.0f) ? ADAPTIVE : CONSTANT;
+    }
+
+    // periods of the whole run, unknown for streaming sources
+    const long N     = dataset_samples();
+    int        total = dataset_epochs;
+
+    if (schedule_every > 0) {
+        total = (N > 0) ? (int)(dataset_epochs * ((N + schedule_every - 1) / schedule_every)) : 0;
+    }
 
-    // load outputs from file
-    file_outputs_set = data_reader_open(fnn_outputs_set);
-    if (file_outputs_set == NULL) {
+    if ((total == 0) && (schedule_type != CONSTANT) && (schedule_type != ADAPTIVE) && (schedule_type != PLATEAU)) {
+        printf("[ERROR] Schedule needs the dataset size, not known while streaming\n");
         network->Destroy(network);
-        exit(ERR_FILE);
+        exit(ERR_ARGS);
     }
 
-    // save weights to file
-    file_weights_out = data_writer_open(fnn_weights_out);
-    if (file_weights_out == NULL) {
+    if (!scheduler->Create(scheduler, network, schedule_type, scheduler_defaults(schedule_type, total))) {
         network->Destroy(network);
-        exit(ERR_FILE);
+        exit(ERR_ARGS);
     }
+}
 
-    const int L = pages->len - 1;
+// -----------------------------------------------------------------------------
+// Output Writing
+// -----------------------------------------------------------------------------
 
-    // load dataset from file
-    while (data_reader_next_vector(file_dataset_set, &pages->ptr[0].x)) {
-        network->Step_Forward(network);
+bool outputs_binary = false; // data_mapper records instead of text lines
+bool outputs_argmax = false; // only the index of the winning class
+int  outputs_every  = 1;     // training: one output line every n samples
+bool outputs_spool  = false; // serialize outputs on a writer thread
 
-        // load actual outputs from file
-        if (data_reader_next_vector(file_outputs_set, &actual_outputs)) {
-            network->Step_Errors(network, &actual_outputs);
+static void open_outputs(g_network_t *network, g_pages_t *pages) {
+    const int values_len = outputs_argmax ? 1 : pages->ptr[pages->len - 1].y.len;
 
-            network->Step_Adjust(network);
+    if (outputs_binary) {
+        file_outputs_out = data_writer_open_binary(fnn_outputs_out, values_len);
+    } else {
+        file_outputs_out = data_writer_open(fnn_outputs_out);
+    }
 
-            network->Step_Backward(network);
+    if (file_outputs_out == NULL) {
+        network->Destroy(network);
+        exit(ERR_FILE);
+    }
+
+    if (outputs_spool) {
+        const int len = pages->ptr[pages->len - 1].y.len;
+
+        if (!data_spooler_open(&outputs_spooler, file_outputs_out, len, outputs_argmax, DATA_SPOOLER_CAPACITY)) {
+            network->Destroy(network);
+            exit(ERR_FILE);
         }
+    }
+}
 
-        // save outputs to file
-        if (!data_writer_next_vector(file_outputs_out, &pages->ptr[L].y)) {
+static void close_outputs(g_network_t *network) {
+    if (outputs_spool) {
+        const double stall = outputs_spooler.stall_seconds;
+
+        if (!data_spooler_close(&outputs_spooler)) {
             network->Destroy(network);
             exit(ERR_DATA);
         }
+
+        printf("[INFO] Output spooler stall time: %.3f s\n", stall);
+    }
+}
+
+static void save_outputs_to_file(g_network_t *network, f_vector_t *outputs) {
+    bool rvalue;
+
+    G_PROFILE_BEGIN(t0);
+
+    if (outputs_spool) {
+        rvalue = data_spooler_push(&outputs_spooler, outputs);
+    } else if (outputs_argmax) {
+        rvalue = data_writer_next_argmax(file_outputs_out, outputs);
+    } else {
+        rvalue = data_writer_next_vector(file_outputs_out, outputs);
     }
 
-    save_weights_to_file(file_weights_out, pages);
+    G_PROFILE_END(t0, G_PROFILE_IO, G_PROFILE_WRITER);
+
+    if (!rvalue) {
+        network->Destroy(network);
+        exit(ERR_DATA);
+    }
 }
 
 // -----------------------------------------------------------------------------
-// Network Mode: INFERENCE
+// Worker Threads
 // -----------------------------------------------------------------------------
 
-static void inference_mode(g_network_t *network, g_pages_t *pages) {
-    // load dataset from file
-    while (data_reader_next_vector(file_dataset_set, &pages->ptr[0].x)) {
-        network->Step_Forward(network);
+int worker_threads = 0; // 0: one per online processor
 
-        // save outputs to file
-        const int L = pages->len - 1;
-        if (!data_writer_next_vector(file_outputs_out, &pages->ptr[L].y)) {
-            network->Destroy(network);
-            exit(ERR_DATA);
-        }
+static int worker_count(void) {
+    if (worker_threads > 0) {
+        return worker_threads;
     }
+
+    const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return (cpus > 0) ? (int)cpus : 1;
 }
 
 // -----------------------------------------------------------------------------
-// Network Mode: VALIDATION
+// Metrics Export
 // -----------------------------------------------------------------------------
 
-static void validation_mode(g_network_t *network, g_pages_t *pages) {
-    // layer 3: actual outputs
-    f_vector_t actual_outputs;
-    actual_outputs.ptr = &OUT_YT[0];
-    actual_outputs.len = SIZEOF(OUT_YT);
+char  *metrics_file   = NULL; // Prometheus textfile
+char  *metrics_socket = NULL; // Unix socket answering with the same text
+double metrics_every  = 5.0;  // seconds between textfile updates
+bool   metrics_on     = false;
+
+static long spooler_depth(void *ctx) {
+    return data_spooler_depth(ctx);
+}
+
+static long prefetch_depth(void *ctx) {
+    return data_prefetch_depth(ctx);
+}
+
+static void open_metrics(g_network_t *network, g_pages_t *pages) {
+    if ((metrics_file == NULL) && (metrics_socket == NULL)) {
+        return;
+    }
+
+    bool rvalue = data_metrics_open(&run_metrics, metrics_file, metrics_socket, metrics_every, pages->len);
+
+    if (rvalue && outputs_spool) {
+        rvalue = data_metrics_queue(&run_metrics, "outputs_spooler", spooler_depth, &outputs_spooler);
+    }
+
+    if (rvalue && (dataset_source == SOURCE_PREFETCH)) {
+        rvalue = data_metrics_queue(&run_metrics, "dataset_prefetch", prefetch_depth, &dataset_prefetcher);
+    }
 
-    // load outputs from file
-    file_outputs_set = data_reader_open(fnn_outputs_set);
-    if (file_outputs_set == NULL) {
+    if (!rvalue || !data_metrics_start(&run_metrics)) {
         network->Destroy(network);
         exit(ERR_FILE);
     }
 
-    const int L = pages->len - 1;
-    const int P = pages->ptr[L].y.len;
+    metrics_on = true;
+}
 
-    int total_samples = 0;
-    int total_errors  = 0;
+static void close_metrics(void) {
+    if (metrics_on && !data_metrics_close(&run_metrics)) {
+        printf("[ALERT] Final metrics not written\n");
+    }
 
-    // load dataset from file
-    while (data_reader_next_vector(file_dataset_set, &pages->ptr[0].x)) {
-        network->Step_Forward(network);
+    metrics_on = false;
+}
 
-        float y_max = -INFINITY;
-        for (int i = 0; i < P; ++i) {
-            if (pages->ptr[L].y.ptr[i] > y_max) {
-                y_max = pages->ptr[L].y.ptr[i];
-            }
-        }
+// -----------------------------------------------------------------------------
+// Validation Engine
+// -----------------------------------------------------------------------------
 
-        for (int i = 0; i < P; ++i) {
-            float y_val = pages->ptr[L].y.ptr[i];
+g_validator_t validator;
+int           validator_top_k = 1;
 
-            pages->ptr[L].y.ptr[i] = (y_val < y_max) ? 0.0f : 1.0f;
-        }
+static void open_validator(g_network_t *network, g_pages_t *pages, bool thread_safe) {
+    int threads = worker_count();
 
-        if (data_reader_next_vector(file_outputs_set, &actual_outputs)) {
-            total_samples++;
+    // the line index binds samples through a shared scratch row
+    if (!thread_safe) {
+        threads = 1;
+    }
 
-            for (int i = 0; i < P; ++i) {
-                if (pages->ptr[L].y.ptr[i] != actual_outputs.ptr[i]) {
-                    total_errors++;
-                    break;
-                }
-            }
-        }
+    g_validator_link(&validator);
 
-        // save outputs to file
-        if (!data_writer_next_vector(file_outputs_out, &pages->ptr[L].y)) {
-            network->Destroy(network);
-            exit(ERR_DATA);
+    if (!validator.Create(&validator, pages, threads, validator_top_k)) {
+        printf("[ERROR] Unable to create the validation engine\n");
+        network->Destroy(network);
+        exit(ERR_NULL);
+    }
+
+    // early stopping compares the loss being trained
+    validator.Set_Loss(&validator, network->loss_type);
+}
+
+static void close_validator(void) {
+    if (validator.Destroy != NULL) {
+        validator.Destroy(&validator);
+    }
+}
+
+static bool bind_dataset_sample(void *ctx, long index, f_vector_t *inputs, f_vector_t *targets) {
+    (void)ctx;
+    return bind_sample(index, inputs, targets);
+}
+
+static bool bind_valid_sample(void *ctx, long index, f_vector_t *inputs, f_vector_t *targets) {
+    (void)ctx;
+    return (valid_map.fd >= 0) ? data_mapper_bind_sample(&valid_map, index, inputs, targets)
+                               : data_store_bind_sample(&valid_store, index, inputs, targets);
+}
+
+// -----------------------------------------------------------------------------
+// Network Mode: TRAINING
+// -----------------------------------------------------------------------------
+
+static void save_weights_to_file(data_writer_t *file, g_pages_t *pages) {
+    if ((file == NULL) || (pages == NULL)) {
+        exit(ERR_NULL);
+    }
+
+    G_PROFILE_BEGIN(t0);
+
+    char remark[32] = {0};
+    for (int k = 0; k < pages->len; ++k) {
+        snprintf(remark, sizeof(remark), "Layer %d weights", k);
+
+        data_writer_next_remark(file, remark);
+        data_writer_next_matrix(file, &pages->ptr[k].w);
+    }
+
+    G_PROFILE_END(t0, G_PROFILE_IO, G_PROFILE_WRITER);
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// -----------------------------------------------------------------------------
+// Network Mode: TRAINING (held-out validation)
+// -----------------------------------------------------------------------------
+
+int valid_every    = 1; // epochs between validations
+int valid_patience = 3; // validations without improvement before stopping, 0: never
+
+float *valid_best       = NULL; // weights of the best validation so far
+float  valid_best_loss  = INFINITY;
+int    valid_best_epoch = 0;
+int    valid_stale      = 0;
+
+static void open_validation(g_network_t *network, g_pages_t *pages) {
+    const int x_len = pages->ptr[0].x.len;
+    const int t_len = SIZEOF(OUT_YT);
+
+    bool rvalue;
+
+    if (data_mapper_probe(fnn_valid_set)) {
+        rvalue = data_mapper_open(&valid_map, fnn_valid_set);
+        rvalue = rvalue && ((int)valid_map.header.x_len == x_len) && ((int)valid_map.header.t_len == t_len);
+    } else {
+        rvalue = (fnn_valid_out != NULL) && data_store_load(&valid_store, fnn_valid_set, fnn_valid_out, x_len, t_len);
+    }
+
+    size_t len = 0;
+    for (int k = 0; k < pages->len; ++k) {
+        len += (size_t)pages->ptr[k].w.row * pages->ptr[k].w.col;
+    }
+
+    valid_best = rvalue ? malloc(len * sizeof(float)) : NULL;
+
+    if (valid_best == NULL) {
+        printf("[ERROR] Unable to load validation set '%s'\n", fnn_valid_set);
+        network->Destroy(network);
+        exit(ERR_DATA);
+    }
+
+    open_validator(network, pages, true);
+}
+
+static void close_validation(void) {
+    free(valid_best);
+    valid_best = NULL;
+}
+
+// copy the weights of every layer to (save) or from (!save) the best buffer
+static void swap_best_weights(g_pages_t *pages, bool save) {
+    float *ptr = valid_best;
+
+    for (int k = 0; k < pages->len; ++k) {
+        const size_t len = (size_t)pages->ptr[k].w.row * pages->ptr[k].w.col;
+
+        if (save) {
+            memcpy(ptr, pages->ptr[k].w.ptr, len * sizeof(float));
+        } else {
+            memcpy(pages->ptr[k].w.ptr, ptr, len * sizeof(float));
+        }
+
+        ptr += len;
+    }
+}
+
+// Inference-only pass over the held-out set, on the validation engine (the
+// training pages are not touched); returns true when training should stop
+// (no improvement for valid_patience validations).
+static bool validate_epoch(g_network_t *network, g_pages_t *pages, int epoch) {
+    const long N = (valid_map.fd >= 0) ? (long)valid_map.header.samples : valid_store.samples;
+
+    if (!validator.Run(&validator, bind_valid_sample, NULL, N, NULL)) {
+        network->Destroy(network);
+        exit(ERR_DATA);
+    }
+
+    const double loss = validator.loss;
+
+    printf("[INFO] Validation after epoch %d: loss %.6f, accuracy %.1f%%\n",
+           epoch,
+           loss,
+           validator.samples > 0 ? 100.0 * validator.hits_1 / validator.samples : 0.0);
+
+    if (loss < valid_best_loss) {
+        valid_best_loss  = (float)loss;
+        valid_best_epoch = epoch;
+        valid_stale      = 0;
+
+        swap_best_weights(pages, true);
+        return false;
+    }
+
+    return (valid_patience > 0) && (++valid_stale >= valid_patience);
+}
+
+// -----------------------------------------------------------------------------
+// Network Mode: TRAINING (checkpoints)
+// -----------------------------------------------------------------------------
+
+long   checkpoint_every  = 0;     // samples between checkpoints, 0: end of each epoch
+bool   checkpoint_resume = false; // continue from fnn_checkpoint
+double checkpoint_stall  = 0.0;   // longest pause of the compute loop
+
+// position of a training run
+typedef struct training_cursor_t {
+    int      epoch;     // epoch in progress (1-based)
+    long     sample;    // samples of the epoch already visited
+    long     trained;   // samples of the epoch with targets
+    double   loss;      // loss accumulated over the epoch
+    uint32_t random[8]; // g_random state at the start of the epoch
+} training_cursor_t;
+
+// checkpoint payload head, followed by the pages, the scheduler and the best
+// validation weights; the visiting order is regenerated from random
+typedef struct checkpoint_state_t {
+    int32_t  layers;
+    int32_t  op_type;
+    int64_t  samples; // dataset size of a multi-epoch run, 0 when streaming
+    int32_t  epoch;
+    int32_t  valid_best_epoch;
+    int64_t  sample;
+    int64_t  trained;
+    double   loss;
+    float    valid_best_loss;
+    int32_t  valid_stale;
+    uint32_t random[8]; // g_random state at the start of the epoch
+} checkpoint_state_t;
+
+static bool checkpoint_floats(data_checkpoint_t *cp, data_checkpoint_view_t *view, float *ptr, size_t len) {
+    return (cp != NULL) ? data_checkpoint_append(cp, ptr, len * sizeof(float))
+                        : data_checkpoint_read(view, ptr, len * sizeof(float));
+}
+
+// Serializes (cp) or restores (view) everything past the checkpoint head, in
+// the same order both ways.
+static bool checkpoint_body(data_checkpoint_t *cp,
+                            data_checkpoint_view_t *view,
+                            g_pages_t *pages,
+                            g_scheduler_t *scheduler) {
+    bool rvalue = true;
+
+    size_t weights = 0;
+
+    for (int k = 0; k < pages->len && rvalue; ++k) {
+        g_page_t *page = &pages->ptr[k];
+
+        const size_t len = (size_t)page->w.row * page->w.col;
+
+        float head[4] = {page->lr, page->mse, page->op_args.beta_1_t, page->op_args.beta_2_t};
+
+        rvalue = rvalue && checkpoint_floats(cp, view, head, 4);
+        rvalue = rvalue && checkpoint_floats(cp, view, page->w.ptr, len);
+        rvalue = rvalue && ((page->m.ptr == NULL) || checkpoint_floats(cp, view, page->m.ptr, len));
+        rvalue = rvalue && ((page->v.ptr == NULL) || checkpoint_floats(cp, view, page->v.ptr, len));
+
+        page->lr               = head[0];
+        page->mse              = head[1];
+        page->op_args.beta_1_t = head[2];
+        page->op_args.beta_2_t = head[3];
+
+        weights += len;
+    }
+
+    double sched[6] = {scheduler->scale, scheduler->step, scheduler->samples,
+                       scheduler->sum,   scheduler->best, scheduler->stale};
+
+    if (cp != NULL) {
+        rvalue = rvalue && data_checkpoint_append(cp, sched, sizeof(sched));
+    } else {
+        rvalue = rvalue && data_checkpoint_read(view, sched, sizeof(sched));
+    }
+
+    scheduler->scale   = (float)sched[0];
+    scheduler->step    = (int)sched[1];
+    scheduler->samples = (long)sched[2];
+    scheduler->sum     = sched[3];
+    scheduler->best    = (float)sched[4];
+    scheduler->stale   = (int)sched[5];
+
+    if (valid_best != NULL) {
+        rvalue = rvalue && checkpoint_floats(cp, view, valid_best, weights);
+    }
+
+    return rvalue;
+}
+
+static void save_checkpoint(g_network_t *network,
+                            g_pages_t *pages,
+                            g_scheduler_t *scheduler,
+                            long N,
+                            training_cursor_t *at,
+                            bool last) {
+    const double t0 = now_seconds();
+
+    G_TRACE_BEGIN(t1);
+
+    checkpoint_state_t state;
+    memset(&state, 0, sizeof(state));
+
+    state.layers           = pages->len;
+    state.op_type          = (int32_t)pages->ptr[0].op_type;
+    state.samples          = N;
+    state.epoch            = at->epoch;
+    state.sample           = at->sample;
+    state.trained          = at->trained;
+    state.loss             = at->loss;
+    state.valid_best_epoch = valid_best_epoch;
+    state.valid_best_loss  = valid_best_loss;
+    state.valid_stale      = valid_stale;
+
+    memcpy(state.random, at->random, sizeof(state.random));
+
+    data_checkpoint_t *cp = &training_checkpoint;
+
+    data_checkpoint_begin(cp);
+
+    bool rvalue = data_checkpoint_append(cp, &state, sizeof(state));
+
+    rvalue = rvalue && checkpoint_body(cp, NULL, pages, scheduler);
+    rvalue = rvalue && data_checkpoint_commit(cp, last);
+
+    if (!rvalue) {
+        printf("[ERROR] Unable to write checkpoint '%s'\n", fnn_checkpoint);
+        network->Destroy(network);
+        exit(ERR_FILE);
+    }
+
+    G_TRACE_END(t1, "checkpoint serialize", "checkpoint");
+
+    const double stall = now_seconds() - t0;
+
+    checkpoint_stall = (stall > checkpoint_stall) ? stall : checkpoint_stall;
+}
+
+static void resume_checkpoint(g_network_t *network,
+                              g_pages_t *pages,
+                              g_scheduler_t *scheduler,
+                              long N,
+                              training_cursor_t *at) {
+    data_checkpoint_view_t view;
+    checkpoint_state_t     state;
+
+    bool rvalue = data_checkpoint_load(&view, fnn_checkpoint);
+
+    rvalue = rvalue && data_checkpoint_read(&view, &state, sizeof(state));
+    rvalue = rvalue && (state.layers == pages->len);
+    rvalue = rvalue && (state.op_type == (int32_t)pages->ptr[0].op_type);
+    rvalue = rvalue && (state.samples == N);
+    rvalue = rvalue && checkpoint_body(NULL, &view, pages, scheduler);
+    rvalue = rvalue && (view.off == view.len);
+
+    data_checkpoint_release(&view);
+
+    if (!rvalue) {
+        printf("[ERROR] Checkpoint '%s' does not match this run\n", fnn_checkpoint);
+        network->Destroy(network);
+        exit(ERR_DATA);
+    }
+
+    at->epoch   = state.epoch;
+    at->sample  = state.sample;
+    at->trained = state.trained;
+    at->loss    = state.loss;
+
+    memcpy(at->random, state.random, sizeof(at->random));
+
+    valid_best_epoch = state.valid_best_epoch;
+    valid_best_loss  = state.valid_best_loss;
+    valid_stale      = state.valid_stale;
+
+    // back at the start of the epoch: its visiting order is drawn again
+    g_random_set_state(state.random);
+
+    printf("[INFO] Resumed epoch %d at sample %ld\n", at->epoch, at->sample);
+}
+
+static void training_epochs(g_network_t *network, g_pages_t *pages, g_scheduler_t *scheduler) {
+    // layer 3: actual outputs
+    f_vector_t actual_outputs;
+    actual_outputs.ptr = &OUT_YT[0];
+    actual_outputs.len = SIZEOF(OUT_YT);
+
+    const long N = dataset_samples();
+    const int  L = pages->len - 1;
+
+    uint32_t *order = malloc(sizeof(uint32_t) * (N > 0 ? N : 1));
+    if (order == NULL) {
+        network->Destroy(network);
+        exit(ERR_NULL);
+    }
+
+    training_cursor_t at = {.epoch = 1};
+
+    if (checkpoint_resume) {
+        resume_checkpoint(network, pages, scheduler, N, &at);
+    }
+
+    const bool checkpoints = fnn_checkpoint != NULL;
+
+    for (; at.epoch <= dataset_epochs; ++at.epoch) {
+        if (at.sample == 0) {
+            g_random_get_state(at.random);
+
+            at.loss    = 0.0;
+            at.trained = 0;
+        }
+
+        // visiting order of the epoch, a function of at.random only, so a
+        // resumed epoch draws the same one; samples stay in place
+        for (long n = 0; n < N; ++n) {
+            order[n] = (uint32_t)n;
+        }
+
+        g_random_shuffle(order, (uint32_t)N);
+
+        if (metrics_on) {
+            data_metrics_epoch(&run_metrics, at.epoch);
+        }
+
+        const long   n0 = at.sample;
+        const double t0 = now_seconds();
+
+        for (long n = n0; n < N; ++n) {
+            if (!bind_sample(order[n], &pages->ptr[0].x, NULL)) {
+                break;
+            }
+
+            network->Step_Forward(network);
+
+            if (bind_sample(order[n], NULL, &actual_outputs)) {
+                network->Step_Errors(network, &actual_outputs);
+
+                at.loss += network->loss;
+                at.trained++;
+
+                scheduler->Step_Sample(scheduler);
+
+                network->Step_Backward(network);
+
+                if (metrics_on) {
+                    data_metrics_sample(&run_metrics, pages, network->loss);
+                }
+            }
+
+            at.sample = n + 1;
+
+            if (checkpoints && (checkpoint_every > 0) && (at.sample % checkpoint_every) == 0 && (at.sample < N)) {
+                save_checkpoint(network, pages, scheduler, N, &at, false);
+            }
+        }
+
+        scheduler->Step_Epoch(scheduler);
+
+        const double t1 = now_seconds();
+
+        printf("[INFO] Epoch %d/%d: loss %.6f, %.0f samples/s\n",
+               at.epoch,
+               dataset_epochs,
+               at.trained > 0 ? at.loss / at.trained : 0.0,
+               (double)(N - n0) / (t1 - t0));
+
+        bool stop = false;
+
+        if ((fnn_valid_set != NULL) && ((at.epoch % valid_every) == 0 || at.epoch == dataset_epochs)) {
+            stop = validate_epoch(network, pages, at.epoch);
+        }
+
+        at.sample = 0;
+
+        if (checkpoints) {
+            // the next run starts with the following epoch
+            training_cursor_t next = {.epoch = stop ? dataset_epochs + 1 : at.epoch + 1};
+
+            g_random_get_state(next.random);
+
+            save_checkpoint(network, pages, scheduler, N, &next, stop || at.epoch == dataset_epochs);
+        }
+
+        if (stop) {
+            printf("[INFO] Early stop after epoch %d\n", at.epoch);
+            break;
+        }
+    }
+
+    free(order);
+
+    // the run ends with the weights that generalized best
+    if ((fnn_valid_set != NULL) && (valid_best_epoch > 0)) {
+        swap_best_weights(pages, false);
+        printf("[INFO] Restored weights of epoch %d (validation loss %.6f)\n", valid_best_epoch, valid_best_loss);
+    }
+
+    // outputs of the trained network, in dataset order
+    long sample = 0;
+
+    dataset_index = 0;
+    while (next_sample_inputs(&pages->ptr[0].x)) {
+        network->Step_Forward(network);
+
+        // save outputs to file
+        if ((sample++ % outputs_every) == 0) {
+            save_outputs_to_file(network, &pages->ptr[L].y);
+        }
+    }
+}
+
+static void training_mode(g_network_t *network, g_pages_t *pages, g_scheduler_t *scheduler) {
+    // layer 3: actual outputs
+    f_vector_t actual_outputs;
+    actual_outputs.ptr = &OUT_YT[0];
+    actual_outputs.len = SIZEOF(OUT_YT);
+
+    // save weights to file (the spooler opens it on its own thread)
+    if (!outputs_spool) {
+        file_weights_out = data_writer_open(fnn_weights_out);
+        if (file_weights_out == NULL) {
+            network->Destroy(network);
+            exit(ERR_FILE);
+        }
+    }
+
+    const int L = pages->len - 1;
+
+    long sample = 0;
+
+    const bool checkpoints = fnn_checkpoint != NULL;
+
+    training_cursor_t at = {.epoch = 1};
+
+    g_random_get_state(at.random);
+
+    if ((dataset_epochs == 1) && checkpoint_resume) {
+        resume_checkpoint(network, pages, scheduler, 0, &at);
+
+        // a single pass has no random access: the samples already trained are
+        // read past, and their outputs are not written again
+        for (; (sample < at.sample) && next_sample_inputs(&pages->ptr[0].x); ++sample) {
+            next_sample_targets(&actual_outputs);
+        }
+    }
+
+    const bool streaming = (dataset_epochs == 1) && (at.epoch == 1);
+
+    if (metrics_on) {
+        data_metrics_epoch(&run_metrics, 1);
+    }
+
+    // load dataset from file
+    while (streaming && next_sample_inputs(&pages->ptr[0].x)) {
+        network->Step_Forward(network);
+
+        // load actual outputs from file
+        if (next_sample_targets(&actual_outputs)) {
+            network->Step_Errors(network, &actual_outputs);
+
+            scheduler->Step_Sample(scheduler);
+
+            network->Step_Backward(network);
+
+            if (metrics_on) {
+                data_metrics_sample(&run_metrics, pages, network->loss);
+            }
+        }
+
+        // save outputs to file
+        if ((sample++ % outputs_every) == 0) {
+            save_outputs_to_file(network, &pages->ptr[L].y);
+        }
+
+        at.sample = sample;
+
+        if (checkpoints && (checkpoint_every > 0) && (at.sample % checkpoint_every) == 0) {
+            save_checkpoint(network, pages, scheduler, 0, &at, false);
+        }
+    }
+
+    if (dataset_epochs > 1) {
+        training_epochs(network, pages, scheduler);
+    } else if (streaming) {
+        scheduler->Step_Epoch(scheduler);
+
+        if (fnn_valid_set != NULL) {
+            validate_epoch(network, pages, 1);
+        }
+
+        if (checkpoints) {
+            // a resumed run finds the pass complete
+            training_cursor_t next = {.epoch = 2};
+
+            g_random_get_state(next.random);
+
+            save_checkpoint(network, pages, scheduler, 0, &next, true);
+        }
+    }
+
+    if (checkpoints) {
+        printf("[INFO] Checkpoints written: %ld, skipped: %ld, longest stall: %.3f ms\n",
+               training_checkpoint.written,
+               training_checkpoint.skipped,
+               1e3 * checkpoint_stall);
+    }
+
+    if (outputs_spool) {
+        if (!data_spooler_snapshot(&outputs_spooler, pages, fnn_weights_out)) {
+            network->Destroy(network);
+            exit(ERR_FILE);
+        }
+    } else {
+        save_weights_to_file(file_weights_out, pages);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Latency Histograms
+// -----------------------------------------------------------------------------
+
+#define LATENCY_MAX 10000000000ull // 10 s in nanoseconds, longer passes are clamped
+
+bool   latency_report   = false; // forward pass percentiles at exit
+int    latency_digits   = 3;     // significant digits of the histograms
+double latency_interval = 0.0;   // seconds between interval reports, 0: none
+
+static inline uint64_t now_nanoseconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void print_latency(const char *label, const g_histogram_t *latency) {
+    printf("[INFO] %s: %llu passes, p50 %.3f us, p90 %.3f us, p99 %.3f us, p99.9 %.3f us, max %.3f us\n",
+           label,
+           (unsigned long long)latency->total,
+           1e-3 * g_histogram_percentile(latency, 50.0),
+           1e-3 * g_histogram_percentile(latency, 90.0),
+           1e-3 * g_histogram_percentile(latency, 99.0),
+           1e-3 * g_histogram_percentile(latency, 99.9),
+           1e-3 * latency->max);
+
+    if (latency->clamped > 0) {
+        printf("[ALERT] %llu passes above %.0f s were clamped\n", (unsigned long long)latency->clamped, 1e-9 * LATENCY_MAX);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Network Mode: INFERENCE
+// -----------------------------------------------------------------------------
+
+static void inference_mode(g_network_t *network, g_pages_t *pages) {
+    // whole run, and the current interval merged into it at every report
+    g_histogram_t latency;
+    g_histogram_t interval;
+
+    const bool timed = latency_report || (latency_interval > 0.0);
+
+    if (timed && !(g_histogram_init(&latency, 1, LATENCY_MAX, latency_digits) &&
+                   g_histogram_init(&interval, 1, LATENCY_MAX, latency_digits))) {
+        network->Destroy(network);
+        exit(ERR_NULL);
+    }
+
+    const uint64_t period = (uint64_t)(latency_interval * 1e9);
+
+    uint64_t next_report = timed ? now_nanoseconds() + period : 0;
+
+    // load dataset from file
+    while (next_sample_inputs(&pages->ptr[0].x)) {
+        if (timed) {
+            const uint64_t t0 = now_nanoseconds();
+
+            network->Step_Forward(network);
+
+            const uint64_t t1 = now_nanoseconds();
+
+            g_histogram_record(&interval, t1 - t0);
+
+            if ((period > 0) && (t1 >= next_report)) {
+                print_latency("Latency interval", &interval);
+
+                g_histogram_merge(&latency, &interval);
+                g_histogram_reset(&interval);
+
+                next_report = t1 + period;
+            }
+        } else {
+            network->Step_Forward(network);
+        }
+
+        // save outputs to file
+        const int L = pages->len - 1;
+        save_outputs_to_file(network, &pages->ptr[L].y);
+    }
+
+    if (timed) {
+        g_histogram_merge(&latency, &interval);
+
+        print_latency("Latency (forward pass)", &latency);
+
+        g_histogram_free(&latency);
+        g_histogram_free(&interval);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Network Mode: VALIDATION
+// -----------------------------------------------------------------------------
+
+static void validation_mode(g_network_t *network, g_pages_t *pages) {
+    const int L = pages->len - 1;
+    const int P = pages->ptr[L].y.len;
+
+    const long N = dataset_samples();
+
+    int32_t *predicted = malloc(sizeof(int32_t) * (N > 0 ? N : 1));
+    float   *one_hot   = calloc(P, sizeof(float));
+
+    if ((predicted == NULL) || (one_hot == NULL)) {
+        free(predicted);
+        free(one_hot);
+        network->Destroy(network);
+        exit(ERR_NULL);
+    }
+
+    const double t0 = now_seconds();
+
+    if (!validator.Run(&validator, bind_dataset_sample, NULL, N, predicted)) {
+        free(predicted);
+        free(one_hot);
+        network->Destroy(network);
+        exit(ERR_DATA);
+    }
+
+    const double t1 = now_seconds();
+
+    // save outputs to file, one-hot of the winning class in dataset order
+    f_vector_t outputs;
+    outputs.ptr = one_hot;
+    outputs.len = P;
+
+    for (long n = 0; n < N; ++n) {
+        if (predicted[n] < 0) {
+            continue; // not bound, not validated
+        }
+
+        one_hot[predicted[n]] = 1.0f;
+
+        save_outputs_to_file(network, &outputs);
+
+        one_hot[predicted[n]] = 0.0f;
+    }
+
+    free(predicted);
+    free(one_hot);
+
+    const long total_samples = validator.samples;
+    const long total_errors  = validator.samples - validator.hits_1;
+
+    float accuracy = (float)(total_samples - total_errors) / (float)total_samples;
+    printf("[INFO] Total samples processed: %ld\n", total_samples);
+    printf("[INFO] Total errors recognised: %ld\n", total_errors);
+    printf("[INFO] Neural Network accuracy: %.1f%%\n", 100.0f * accuracy);
+
+    if (validator.top_k > 1) {
+        printf("[INFO] Top-%d accuracy: %.1f%%\n", validator.top_k, 100.0 * validator.hits_k / total_samples);
+    }
+
+    printf("[INFO] Validation threads: %d, %.0f samples/s\n", validator.threads, (double)N / (t1 - t0));
+
+    if (latency_report) {
+        print_latency("Latency (forward pass, all threads)", &validator.latency);
+    }
+
+    // rows: target class, columns: predicted class
+    printf("[INFO] Confusion matrix (rows: target, columns: prediction):\n");
+    printf("      ");
+    for (int j = 0; j < P; ++j) {
+        printf(" %7d", j);
+    }
+    printf("\n");
+
+    for (int i = 0; i < P; ++i) {
+        printf("  %3d:", i);
+        for (int j = 0; j < P; ++j) {
+            printf(" %7ld", validator.confusion[i * P + j]);
+        }
+        printf("\n");
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Argument Processing
+// -----------------------------------------------------------------------------
+
+uint32_t random_seed     = 0;
+bool     random_seed_set = false;
+
+bool profile_run      = false; // per-layer timing report at the end
+bool profile_counters = false; // with hardware counters, when available
+bool cost_report      = false; // static cost model after the network is created
+
+char  *trace_file   = NULL;             // Chrome trace-event JSON of the run
+size_t trace_events = G_TRACE_CAPACITY; // kept per thread, the newest win
+
+g_optim_type_t optimizer_type = SGD;
+g_loss_type_t  loss_type      = MSE;
+
+static g_optim_args_t optimizer_defaults(g_optim_type_t op_type) {
+    g_optim_args_t op_args = {0};
+
+    switch (op_type) {
+        case MOMENTUM:
+        case NESTEROV:
+            op_args.beta_1 = 0.9f;
+            break;
+        case RMSPROP:
+            op_args.beta_2  = 0.9f;
+            op_args.epsilon = 1e-8f;
+            break;
+        case ADAM:
+            op_args.beta_1  = 0.9f;
+            op_args.beta_2  = 0.999f;
+            op_args.epsilon = 1e-8f;
+            break;
+        default:
+            break;
+    }
+
+    return op_args;
+}
+
+static bool parse_optimizer(const char *name, g_optim_type_t *op_type) {
+    static const struct {
+        const char    *name;
+        g_optim_type_t type;
+    } names[] = {
+        {"sgd", SGD},
+        {"momentum", MOMENTUM},
+        {"nesterov", NESTEROV},
+        {"rmsprop", RMSPROP},
+        {"adam", ADAM},
+    };
+
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+        if (strcmp(name, names[i].name) == 0) {
+            *op_type = names[i].type;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool parse_loss(const char *name, g_loss_type_t *type) {
+    static const struct {
+        const char   *name;
+        g_loss_type_t type;
+    } names[] = {
+        {"mse", MSE},
+        {"bce", BCE},
+        {"cce", CCE},
+    };
+
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+        if (strcmp(name, names[i].name) == 0) {
+            *type = names[i].type;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool parse_schedule(const char *name, g_sched_type_t *type) {
+    static const struct {
+        const char    *name;
+        g_sched_type_t type;
+    } names[] = {
+        {"adaptive", ADAPTIVE},
+        {"constant", CONSTANT},
+        {"step", STEP_DECAY},
+        {"cosine", COSINE},
+        {"one-cycle", ONE_CYCLE},
+        {"warmup", WARMUP},
+        {"plateau", PLATEAU},
+    };
+
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+        if (strcmp(name, names[i].name) == 0) {
+            *type = names[i].type;
+            return true;
         }
     }
 
-    float accuracy = (float)(total_samples - total_errors) / (float)total_samples;
-    printf("[INFO] Total samples processed: %d\n", total_samples);
-    printf("[INFO] Total errors recognised: %d\n", total_errors);
-    printf("[INFO] Neural Network accuracy: %.1f%%\n", 100.0f * accuracy);
+    return false;
 }
 
-// -----------------------------------------------------------------------------
-// Argument Processing
-// -----------------------------------------------------------------------------
-
 static void process_arguments(int argc, char *argv[], network_modes_t *mode) {
     const char *filename = basename(argv[0]);
 
@@ -237,17 +1456,29 @@ static void process_arguments(int argc, char *argv[], network_modes_t *mode) {
             *mode = VALIDATION;
         }
 
+        else if (strcmp(arg, "--export") == 0) {
+            if (i + 1 < argc) {
+                *mode           = EXPORT;
+                fnn_export_base = argv[++i];
+            } else {
+                fprintf(stderr, "Error: Missing argument for --export\n");
+                exit(ERR_ARGS);
+            }
+        }
+
         else if ((strcmp(arg, "--help") == 0) || (strcmp(arg, "-h") == 0)) {
             // clang-format off
             fprintf(stderr, "Usage:\n");
             fprintf(stderr, "  %s -t [options]\n", filename);
             fprintf(stderr, "  %s -i [options]\n", filename);
             fprintf(stderr, "  %s -v [options]\n", filename);
+            fprintf(stderr, "  %s --export <base> [options]\n", filename);
             fprintf(stderr, "  %s -h\n", filename);
             fprintf(stderr, "Commands:\n");
             fprintf(stderr, "  -t, --train               Run in training mode\n");
             fprintf(stderr, "  -i, --infer               Run in inference mode\n");
             fprintf(stderr, "  -v, --valid               Run in validation mode\n");
+            fprintf(stderr, "      --export <base>       Write the weights cfg as standalone C, <base>.c and <base>.h\n");
             fprintf(stderr, "  -h, --help                Show this help message\n");
             fprintf(stderr, "Options:\n");
             fprintf(stderr, "  -w, --weights-cfg <file>  The weights cfg file (default: %s)\n", fnn_weights_cfg);
@@ -255,6 +1486,40 @@ static void process_arguments(int argc, char *argv[], network_modes_t *mode) {
             fprintf(stderr, "  -s, --outputs-set <file>  The outputs set file (default: %s)\n", fnn_outputs_set);
             fprintf(stderr, "  -x, --weights-out <file>  The weights out file (default: %s)\n", fnn_weights_out);
             fprintf(stderr, "  -o, --outputs-out <file>  The outputs out file (default: %s)\n", fnn_outputs_out);
+            fprintf(stderr, "  -p, --prefetch            Parse text datasets on a separate thread (implies -c)\n");
+            fprintf(stderr, "  -b, --outputs-bin         Write outputs as binary records\n");
+            fprintf(stderr, "  -a, --outputs-argmax      Write only the index of the winning class\n");
+            fprintf(stderr, "  -e, --outputs-every <n>   Write one output every n training samples (default: %d)\n", outputs_every);
+            fprintf(stderr, "  -q, --outputs-spool       Write outputs and weights on a separate thread\n");
+            fprintf(stderr, "  -n, --epochs <n>          Train n epochs in memory, shuffled (default: %d)\n", dataset_epochs);
+            fprintf(stderr, "  -r, --seed <n>            Seed of weight init and shuffling\n");
+            fprintf(stderr, "  -k, --indexed             Read epochs through a line index instead of memory (implies -c)\n");
+            fprintf(stderr, "  -c, --no-cache            Do not keep a parsed cache next to text datasets\n");
+            fprintf(stderr, "  -g, --optimizer <name>    sgd, momentum, nesterov, rmsprop or adam (default: sgd)\n");
+            fprintf(stderr, "  -l, --learning-rate <lr>  Fixed learning rate (default: adjusted per layer)\n");
+            fprintf(stderr, "  -u, --schedule <name>     adaptive, constant, step, cosine, one-cycle, warmup or plateau\n");
+            fprintf(stderr, "  -j, --schedule-every <n>  Evaluate the schedule every n samples (default: every epoch)\n");
+            fprintf(stderr, "  -y, --valid-set <file>    Held-out dataset checked while training (text or binary)\n");
+            fprintf(stderr, "  -z, --valid-out <file>    Held-out outputs of a text --valid-set\n");
+            fprintf(stderr, "  -m, --valid-every <k>     Check the held-out set every k epochs (default: %d)\n", valid_every);
+            fprintf(stderr, "  -f, --patience <n>        Stop after n checks without improvement, 0: never (default: %d)\n", valid_patience);
+            fprintf(stderr, "      --loss <name>         mse, bce or cce (default: mse)\n");
+            fprintf(stderr, "      --threads <n>         Threads for validation and weight init (default: one per processor)\n");
+            fprintf(stderr, "      --top-k <k>           Also report top-k accuracy (default: %d)\n", validator_top_k);
+            fprintf(stderr, "      --checkpoint <file>   Save the training state periodically, atomically\n");
+            fprintf(stderr, "      --checkpoint-every <n> Save every n samples (default: at the end of each epoch)\n");
+            fprintf(stderr, "      --resume              Continue from the --checkpoint file\n");
+            fprintf(stderr, "      --profile             Print a per-layer, per-phase timing table\n");
+            fprintf(stderr, "      --profile-counters    Also count cycles, instructions, cache and branch misses\n");
+            fprintf(stderr, "      --cost                Print parameters, bytes, FLOPs and cache fit per layer\n");
+            fprintf(stderr, "      --trace <file>        Write a Chrome trace-event timeline of the run\n");
+            fprintf(stderr, "      --metrics-file <file> Write live training metrics as a Prometheus textfile\n");
+            fprintf(stderr, "      --metrics-socket <path> Serve the same metrics on a Unix socket\n");
+            fprintf(stderr, "      --metrics-every <s>   Seconds between textfile updates (default: %.0f)\n", metrics_every);
+            fprintf(stderr, "      --latency             Report forward pass latency percentiles (inference, validation)\n");
+            fprintf(stderr, "      --latency-digits <d>  Significant digits of the latency histogram, 1-5 (default: %d)\n", latency_digits);
+            fprintf(stderr, "      --latency-interval <s> Also report inference latency every s seconds\n");
+            fprintf(stderr, "      --trace-events <n>    Events kept per thread (default: %d)\n", G_TRACE_CAPACITY);
             // clang-format on
             exit(ERR_NONE);
         }
@@ -304,6 +1569,325 @@ static void process_arguments(int argc, char *argv[], network_modes_t *mode) {
             }
         }
 
+        else if ((strcmp(arg, "--prefetch") == 0) || (strcmp(arg, "-p") == 0)) {
+            dataset_prefetch = true;
+            dataset_cached   = false; // the cache would bypass the reader thread
+        }
+
+        else if ((strcmp(arg, "--outputs-bin") == 0) || (strcmp(arg, "-b") == 0)) {
+            outputs_binary = true;
+        }
+
+        else if ((strcmp(arg, "--outputs-argmax") == 0) || (strcmp(arg, "-a") == 0)) {
+            outputs_argmax = true;
+        }
+
+        else if ((strcmp(arg, "--outputs-spool") == 0) || (strcmp(arg, "-q") == 0)) {
+            outputs_spool = true;
+        }
+
+        else if ((strcmp(arg, "--epochs") == 0) || (strcmp(arg, "-n") == 0)) {
+            if (i + 1 < argc) {
+                dataset_epochs = atoi(argv[++i]);
+                if (dataset_epochs <= 0) {
+                    fprintf(stderr, "Error: Invalid argument for --epochs\n");
+                    exit(ERR_ARGS);
+                }
+            } else {
+                fprintf(stderr, "Error: Missing argument for --epochs\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else if ((strcmp(arg, "--indexed") == 0) || (strcmp(arg, "-k") == 0)) {
+            dataset_indexed = true;
+            dataset_cached  = false; // the cache would bypass the line index
+        }
+
+        else if ((strcmp(arg, "--no-cache") == 0) || (strcmp(arg, "-c") == 0)) {
+            dataset_cached = false;
+        }
+
+        else if ((strcmp(arg, "--learning-rate") == 0) || (strcmp(arg, "-l") == 0)) {
+            if (i + 1 < argc) {
+                learning_rate = strtof(argv[++i], NULL);
+                if (!(learning_rate > 0.0f)) {
+                    fprintf(stderr, "Error: Invalid argument for --learning-rate\n");
+                    exit(ERR_ARGS);
+                }
+            } else {
+                fprintf(stderr, "Error: Missing argument for --learning-rate\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else if ((strcmp(arg, "--optimizer") == 0) || (strcmp(arg, "-g") == 0)) {
+            if (i + 1 < argc) {
+                if (!parse_optimizer(argv[++i], &optimizer_type)) {
+                    fprintf(stderr, "Error: Unknown optimizer '%s'\n", argv[i]);
+                    exit(ERR_ARGS);
+                }
+            } else {
+                fprintf(stderr, "Error: Missing argument for --optimizer\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else if ((strcmp(arg, "--schedule") == 0) || (strcmp(arg, "-u") == 0)) {
+            if (i + 1 < argc) {
+                if (!parse_schedule(argv[++i], &schedule_type)) {
+                    fprintf(stderr, "Error: Unknown schedule '%s'\n", argv[i]);
+                    exit(ERR_ARGS);
+                }
+                schedule_set = true;
+            } else {
+                fprintf(stderr, "Error: Missing argument for --schedule\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else if ((strcmp(arg, "--schedule-every") == 0) || (strcmp(arg, "-j") == 0)) {
+            if (i + 1 < argc) {
+                schedule_every = atol(argv[++i]);
+                if (schedule_every <= 0) {
+                    fprintf(stderr, "Error: Invalid argument for --schedule-every\n");
+                    exit(ERR_ARGS);
+                }
+            } else {
+                fprintf(stderr, "Error: Missing argument for --schedule-every\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else if ((strcmp(arg, "--valid-set") == 0) || (strcmp(arg, "-y") == 0)) {
+            if (i + 1 < argc) {
+                fnn_valid_set = argv[++i];
+            } else {
+                fprintf(stderr, "Error: Missing argument for --valid-set\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else if ((strcmp(arg, "--valid-out") == 0) || (strcmp(arg, "-z") == 0)) {
+            if (i + 1 < argc) {
+                fnn_valid_out = argv[++i];
+            } else {
+                fprintf(stderr, "Error: Missing argument for --valid-out\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else if ((strcmp(arg, "--valid-every") == 0) || (strcmp(arg, "-m") == 0)) {
+            if (i + 1 < argc) {
+                valid_every = atoi(argv[++i]);
+                if (valid_every <= 0) {
+                    fprintf(stderr, "Error: Invalid argument for --valid-every\n");
+                    exit(ERR_ARGS);
+                }
+            } else {
+                fprintf(stderr, "Error: Missing argument for --valid-every\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else if ((strcmp(arg, "--patience") == 0) || (strcmp(arg, "-f") == 0)) {
+            if (i + 1 < argc) {
+                valid_patience = atoi(argv[++i]);
+                if (valid_patience < 0) {
+                    fprintf(stderr, "Error: Invalid argument for --patience\n");
+                    exit(ERR_ARGS);
+                }
+            } else {
+                fprintf(stderr, "Error: Missing argument for --patience\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else if (strcmp(arg, "--threads") == 0) {
+            if (i + 1 < argc) {
+                worker_threads = atoi(argv[++i]);
+                if (worker_threads <= 0) {
+                    fprintf(stderr, "Error: Invalid argument for --threads\n");
+                    exit(ERR_ARGS);
+                }
+            } else {
+                fprintf(stderr, "Error: Missing argument for --threads\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else if (strcmp(arg, "--top-k") == 0) {
+            if (i + 1 < argc) {
+                validator_top_k = atoi(argv[++i]);
+                if (validator_top_k <= 0) {
+                    fprintf(stderr, "Error: Invalid argument for --top-k\n");
+                    exit(ERR_ARGS);
+                }
+            } else {
+                fprintf(stderr, "Error: Missing argument for --top-k\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else if (strcmp(arg, "--loss") == 0) {
+            if (i + 1 < argc) {
+                if (!parse_loss(argv[++i], &loss_type)) {
+                    fprintf(stderr, "Error: Unknown loss '%s'\n", argv[i]);
+                    exit(ERR_ARGS);
+                }
+            } else {
+                fprintf(stderr, "Error: Missing argument for --loss\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else if (strcmp(arg, "--checkpoint") == 0) {
+            if (i + 1 < argc) {
+                fnn_checkpoint = argv[++i];
+            } else {
+                fprintf(stderr, "Error: Missing argument for --checkpoint\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else if (strcmp(arg, "--checkpoint-every") == 0) {
+            if (i + 1 < argc) {
+                checkpoint_every = atol(argv[++i]);
+                if (checkpoint_every <= 0) {
+                    fprintf(stderr, "Error: Invalid argument for --checkpoint-every\n");
+                    exit(ERR_ARGS);
+                }
+            } else {
+                fprintf(stderr, "Error: Missing argument for --checkpoint-every\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else if (strcmp(arg, "--resume") == 0) {
+            checkpoint_resume = true;
+        }
+
+        else if (strcmp(arg, "--profile") == 0) {
+            profile_run = true;
+        }
+
+        else if (strcmp(arg, "--profile-counters") == 0) {
+            profile_run      = true;
+            profile_counters = true;
+        }
+
+        else if (strcmp(arg, "--cost") == 0) {
+            cost_report = true;
+        }
+
+        else if (strcmp(arg, "--trace") == 0) {
+            if (i + 1 < argc) {
+                trace_file = argv[++i];
+            } else {
+                fprintf(stderr, "Error: Missing argument for --trace\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else if (strcmp(arg, "--metrics-file") == 0) {
+            if (i + 1 < argc) {
+                metrics_file = argv[++i];
+            } else {
+                fprintf(stderr, "Error: Missing argument for --metrics-file\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else if (strcmp(arg, "--metrics-socket") == 0) {
+            if (i + 1 < argc) {
+                metrics_socket = argv[++i];
+            } else {
+                fprintf(stderr, "Error: Missing argument for --metrics-socket\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else if (strcmp(arg, "--metrics-every") == 0) {
+            if (i + 1 < argc) {
+                metrics_every = strtof(argv[++i], NULL);
+                if (metrics_every <= 0.0) {
+                    fprintf(stderr, "Error: Invalid argument for --metrics-every\n");
+                    exit(ERR_ARGS);
+                }
+            } else {
+                fprintf(stderr, "Error: Missing argument for --metrics-every\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else if (strcmp(arg, "--latency") == 0) {
+            latency_report = true;
+        }
+
+        else if (strcmp(arg, "--latency-digits") == 0) {
+            if (i + 1 < argc) {
+                latency_digits = atoi(argv[++i]);
+                if ((latency_digits < 1) || (latency_digits > 5)) {
+                    fprintf(stderr, "Error: Invalid argument for --latency-digits\n");
+                    exit(ERR_ARGS);
+                }
+            } else {
+                fprintf(stderr, "Error: Missing argument for --latency-digits\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else if (strcmp(arg, "--latency-interval") == 0) {
+            if (i + 1 < argc) {
+                latency_interval = strtof(argv[++i], NULL);
+                if (latency_interval <= 0.0) {
+                    fprintf(stderr, "Error: Invalid argument for --latency-interval\n");
+                    exit(ERR_ARGS);
+                }
+                latency_report = true;
+            } else {
+                fprintf(stderr, "Error: Missing argument for --latency-interval\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else if (strcmp(arg, "--trace-events") == 0) {
+            if (i + 1 < argc) {
+                const long events = atol(argv[++i]);
+                if (events <= 0) {
+                    fprintf(stderr, "Error: Invalid argument for --trace-events\n");
+                    exit(ERR_ARGS);
+                }
+                trace_events = (size_t)events;
+            } else {
+                fprintf(stderr, "Error: Missing argument for --trace-events\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else if ((strcmp(arg, "--seed") == 0) || (strcmp(arg, "-r") == 0)) {
+            if (i + 1 < argc) {
+                random_seed     = (uint32_t)strtoul(argv[++i], NULL, 0);
+                random_seed_set = true;
+            } else {
+                fprintf(stderr, "Error: Missing argument for --seed\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else if ((strcmp(arg, "--outputs-every") == 0) || (strcmp(arg, "-e") == 0)) {
+            if (i + 1 < argc) {
+                outputs_every = atoi(argv[++i]);
+                if (outputs_every <= 0) {
+                    fprintf(stderr, "Error: Invalid argument for --outputs-every\n");
+                    exit(ERR_ARGS);
+                }
+            } else {
+                fprintf(stderr, "Error: Missing argument for --outputs-every\n");
+                exit(ERR_ARGS);
+            }
+        }
+
         else {
             fprintf(stderr, "Error: Unknown argument '%s'\n", arg);
             fprintf(stderr, "For more information use: %s --help\n", filename);
@@ -322,6 +1906,11 @@ int main(int argc, char *argv[]) {
     // process command-line arguments
     process_arguments(argc, argv, &network_mode);
 
+    if (checkpoint_resume && (fnn_checkpoint == NULL)) {
+        fprintf(stderr, "Error: --resume needs a --checkpoint file\n");
+        exit(ERR_ARGS);
+    }
+
     switch (network_mode) {
         case TRAINING:
             printf("Network mode: training\n");
@@ -330,6 +1919,9 @@ int main(int argc, char *argv[]) {
             printf(" ―→█   Outputs file: %s\n", fnn_outputs_set);
             printf("   █―→ Weights file: %s\n", fnn_weights_out);
             printf("   █―→ Outputs file: %s\n", fnn_outputs_out);
+            if (fnn_valid_set != NULL) {
+                printf(" ―→█   Valid. dataset: %s\n", fnn_valid_set);
+            }
             break;
         case INFERENCE:
             printf("Network mode: inference\n");
@@ -344,6 +1936,12 @@ int main(int argc, char *argv[]) {
             printf(" ―→█   Outputs file: %s\n", fnn_outputs_set);
             printf("   █―→ Outputs file: %s\n", fnn_outputs_out);
             break;
+        case EXPORT:
+            printf("Network mode: export\n");
+            printf(" ―→█   Weights file: %s\n", fnn_weights_cfg);
+            printf("   █―→ Source  file: %s.c\n", fnn_export_base);
+            printf("   █―→ Header  file: %s.h\n", fnn_export_base);
+            break;
         default:
             exit(ERR_ARGS);
     }
@@ -354,24 +1952,68 @@ int main(int argc, char *argv[]) {
     // network layout & structure
     g_pages_t pages = fnn_layout_to_pages();
 
-    g_network_t network;
+    g_network_t   network;
+    g_scheduler_t scheduler;
 
     g_network_link(&network);
+    g_scheduler_link(&scheduler);
 
     if (network.Create(&network, &pages)) {
+        // update rule, its moment buffers come with the layout
+        if (!network.Set_Optimizer(&network, optimizer_type, optimizer_defaults(optimizer_type))) {
+            printf("[ERROR] Optimizer state buffers missing from the layout\n");
+            network.Destroy(&network);
+            exit(ERR_DATA);
+        }
+
+        // cross-entropy on a sigmoid/softmax output uses the fused Y - T gradient
+        network.Set_Loss(&network, loss_type);
+
+        if ((loss_type == CCE) && (pages.ptr[pages.len - 1].af_type != SOFTMAX)) {
+            printf("[ALERT] Categorical cross-entropy expects a softmax output layer\n");
+        }
+
+        // from the shapes alone, with the optimizer moments in place
+        if (cost_report) {
+            g_cost_t cost;
+
+            if (g_cost_analyze(&cost, &pages)) {
+                g_cost_report(&cost);
+                g_cost_free(&cost);
+            }
+        }
+
+        if (network_mode == TRAINING) {
+            set_learning_rate(&pages, optimizer_type);
+        }
+
+        // one seed per run, for the weights and the shuffling alike
+        if (!random_seed_set) {
+            random_seed = (uint32_t)time(NULL);
+        }
+
         // load weights from file
         file_weights_cfg = data_reader_open(fnn_weights_cfg);
-        if (file_weights_cfg == NULL) {
-            printf("[ALERT] Creating random weights file '%s'...\n", fnn_weights_cfg);
-            network.Init_Weights(&network, 0.5f);
+        if ((file_weights_cfg == NULL) && (network_mode == EXPORT)) {
+            network.Destroy(&network);
+            exit(ERR_FILE);
+        } else if (file_weights_cfg == NULL) {
+            // the same seed and thread count give the same weights
+            const int threads = worker_count();
+
+            printf("[ALERT] Creating random weights file '%s' (seed %u, %d threads)...\n",
+                   fnn_weights_cfg,
+                   random_seed,
+                   threads);
+            network.Init_Weights(&network, 0.5f, random_seed, threads);
 
             // save random weights to file
-            file_weights_cfg = data_writer_open(fnn_weights_cfg);
-            if (file_weights_cfg == NULL) {
+            file_weights_new = data_writer_open(fnn_weights_cfg);
+            if (file_weights_new == NULL) {
                 exit(ERR_FILE);
             }
 
-            save_weights_to_file(file_weights_cfg, &pages);
+            save_weights_to_file(file_weights_new, &pages);
         } else {
             for (int k = 0; k < pages.len; ++k) {
                 if (!data_reader_next_matrix(file_weights_cfg, &pages.ptr[k].w)) {
@@ -381,24 +2023,84 @@ int main(int argc, char *argv[]) {
             }
         }
 
-        // load dataset from file
-        file_dataset_set = data_reader_open(fnn_dataset_set);
-        if (file_dataset_set == NULL) {
+        // trained weights and layout as source, nothing to run
+        if (network_mode == EXPORT) {
+            const bool exported = data_export_c(&pages, fnn_export_base);
+
             network.Destroy(&network);
-            exit(ERR_FILE);
+
+            if (!exported) {
+                exit(ERR_FILE);
+            }
+
+            cleanup_resources();
+
+            puts("... Done!");
+            return ERR_NONE;
         }
 
-        // save outputs to file
-        file_outputs_out = data_writer_open(fnn_outputs_out);
-        if (file_outputs_out == NULL) {
-            network.Destroy(&network);
-            exit(ERR_FILE);
+        // before the reader and writer threads start; the phase marks come
+        // from the profiler, enabled even without --profile
+        if ((trace_file != NULL) && g_profile_enable() && g_trace_enable(trace_events)) {
+            g_trace_thread_name("main");
+        } else if (trace_file != NULL) {
+            printf("[ALERT] Tracing not built in, configure with -DG_FNN_PROFILE=ON\n");
+            trace_file = NULL;
+        }
+
+        // load dataset (and outputs) from file, text or binary; validation
+        // needs random access to spread the samples over threads
+        const bool random_access = ((network_mode == TRAINING) && (dataset_epochs > 1)) || (network_mode == VALIDATION);
+
+        open_dataset(&network, &pages, network_mode != INFERENCE, random_access);
+
+        if (network_mode == VALIDATION) {
+            open_validator(&network, &pages, dataset_source != SOURCE_INDEXED);
+        }
+
+        // shuffling draws from g_random; the weights use a g_random_t of their own
+        g_random_seed(random_seed);
+
+        if ((network_mode == TRAINING) && (dataset_epochs > 1) && !random_seed_set) {
+            printf("[INFO] Shuffle seed %u (reproduce with --seed)\n", random_seed);
+        }
+
+        // learning rate schedule, over the periods of the whole run
+        if (network_mode == TRAINING) {
+            open_scheduler(&network, &scheduler);
+        }
+
+        // held-out set, kept in memory for the whole run
+        if ((network_mode == TRAINING) && (fnn_valid_set != NULL)) {
+            open_validation(&network, &pages);
+        }
+
+        // checkpoints are written by a thread of their own
+        if ((network_mode == TRAINING) && (fnn_checkpoint != NULL)) {
+            if (!data_checkpoint_open(&training_checkpoint, fnn_checkpoint)) {
+                network.Destroy(&network);
+                exit(ERR_FILE);
+            }
         }
 
+        // save outputs to file, text or binary
+        open_outputs(&network, &pages);
+
+        if (profile_run && !g_profile_enable()) {
+            printf("[ALERT] Profiling not built in, configure with -DG_FNN_PROFILE=ON\n");
+        } else if (profile_counters) {
+            g_profile_enable_counters();
+        }
+
+        // live metrics, sampled by a thread of their own
+        open_metrics(&network, &pages);
+
+        const double profile_t0 = now_seconds();
+
         // execution mode
         switch (network_mode) {
             case TRAINING:
-                training_mode(&network, &pages);
+                training_mode(&network, &pages, &scheduler);
                 break;
             case INFERENCE:
                 inference_mode(&network, &pages);
@@ -410,11 +2112,39 @@ int main(int argc, char *argv[]) {
                 exit(ERR_ARGS);
         }
 
+        close_metrics();
+
+        // drain queued outputs and weight snapshots
+        close_outputs(&network);
+
+        if (profile_run) {
+            g_profile_report(now_seconds() - profile_t0);
+        }
+
+        g_profile_release();
+
+        if (dataset_source == SOURCE_PREFETCH) {
+            printf("[INFO] Prefetch stall time: %.3f s\n", dataset_prefetcher.stall_seconds);
+        }
+
+        if (!data_checkpoint_close(&training_checkpoint) && (fnn_checkpoint != NULL) && (network_mode == TRAINING)) {
+            printf("[ERROR] Unable to write checkpoint '%s'\n", fnn_checkpoint);
+        }
+
+        close_validation();
+        close_validator();
+        scheduler.Destroy(&scheduler);
         network.Destroy(&network);
     }
 
     cleanup_resources();
 
+    // after the prefetch and spooler threads are joined
+    if (trace_file != NULL) {
+        g_trace_dump(trace_file);
+        g_trace_release();
+    }
+
     puts("... Done!");
     return ERR_NONE;
 }
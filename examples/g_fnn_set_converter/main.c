@@ -0,0 +1,238 @@
+// -----------------------------------------------------------------------------
+// @file main.c
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#include <libgen.h> // basename
+#include <stdio.h>  // FILE, NULL, fprintf, printf, puts
+#include <stdlib.h> // atexit, atoi, calloc, exit, free
+#include <string.h> // strcmp
+
+#include "data_mapper.h"
+#include "data_reader.h"
+
+// -----------------------------------------------------------------------------
+// Error Codes
+// -----------------------------------------------------------------------------
+
+typedef enum {
+    ERR_NONE = 0,
+    ERR_ARGS = 1,
+    ERR_NULL = 2,
+    ERR_FILE = 3,
+    ERR_DATA = 4
+} error_codes_t;
+
+// -----------------------------------------------------------------------------
+// File Handles
+// -----------------------------------------------------------------------------
+
+char *fnn_dataset_set = "fnn_dataset.set";
+char *fnn_outputs_set = NULL;
+char *fnn_dataset_bin = "fnn_dataset.bset";
+
+int inputs_len  = 0;
+int outputs_len = 0;
+
+data_reader_t *file_dataset_set = NULL;
+data_reader_t *file_outputs_set = NULL;
+
+FILE *file_dataset_bin = NULL;
+
+float *buffer_x = NULL;
+float *buffer_t = NULL;
+
+static void cleanup_resources(void) {
+    data_reader_close(&file_dataset_set);
+    data_reader_close(&file_outputs_set);
+
+    if (file_dataset_bin != NULL) {
+        fclose(file_dataset_bin);
+        file_dataset_bin = NULL;
+    }
+
+    free(buffer_x);
+    free(buffer_t);
+    buffer_x = NULL;
+    buffer_t = NULL;
+}
+
+// -----------------------------------------------------------------------------
+// Argument Processing
+// -----------------------------------------------------------------------------
+
+static void process_arguments(int argc, char *argv[]) {
+    const char *filename = basename(argv[0]);
+
+    if (argc == 1) {
+        fprintf(stderr, "Error: No arguments provided\n");
+        fprintf(stderr, "For more information use: %s --help\n", filename);
+        exit(ERR_ARGS);
+    }
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+
+        if ((strcmp(arg, "--help") == 0) || (strcmp(arg, "-h") == 0)) {
+            // clang-format off
+            fprintf(stderr, "Usage:\n");
+            fprintf(stderr, "  %s -n <len> [-m <len>] [options]\n", filename);
+            fprintf(stderr, "  %s -h\n", filename);
+            fprintf(stderr, "Commands:\n");
+            fprintf(stderr, "  -h, --help                Show this help message\n");
+            fprintf(stderr, "Options:\n");
+            fprintf(stderr, "  -n, --inputs <len>        Number of inputs per sample (required)\n");
+            fprintf(stderr, "  -m, --outputs <len>       Number of outputs per sample (default: 0)\n");
+            fprintf(stderr, "  -d, --dataset-set <file>  The dataset set file (default: %s)\n", fnn_dataset_set);
+            fprintf(stderr, "  -s, --outputs-set <file>  The outputs set file (required if -m > 0)\n");
+            fprintf(stderr, "  -b, --dataset-bin <file>  The binary dataset file (default: %s)\n", fnn_dataset_bin);
+            // clang-format on
+            exit(ERR_NONE);
+        }
+
+        else if ((strcmp(arg, "--inputs") == 0) || (strcmp(arg, "-n") == 0)) {
+            if (i + 1 < argc) {
+                inputs_len = atoi(argv[++i]);
+            } else {
+                fprintf(stderr, "Error: Missing argument for --inputs\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else if ((strcmp(arg, "--outputs") == 0) || (strcmp(arg, "-m") == 0)) {
+            if (i + 1 < argc) {
+                outputs_len = atoi(argv[++i]);
+            } else {
+                fprintf(stderr, "Error: Missing argument for --outputs\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else if ((strcmp(arg, "--dataset-set") == 0) || (strcmp(arg, "-d") == 0)) {
+            if (i + 1 < argc) {
+                fnn_dataset_set = argv[++i];
+            } else {
+                fprintf(stderr, "Error: Missing argument for --dataset-set\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else if ((strcmp(arg, "--outputs-set") == 0) || (strcmp(arg, "-s") == 0)) {
+            if (i + 1 < argc) {
+                fnn_outputs_set = argv[++i];
+            } else {
+                fprintf(stderr, "Error: Missing argument for --outputs-set\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else if ((strcmp(arg, "--dataset-bin") == 0) || (strcmp(arg, "-b") == 0)) {
+            if (i + 1 < argc) {
+                fnn_dataset_bin = argv[++i];
+            } else {
+                fprintf(stderr, "Error: Missing argument for --dataset-bin\n");
+                exit(ERR_ARGS);
+            }
+        }
+
+        else {
+            fprintf(stderr, "Error: Unknown argument '%s'\n", arg);
+            fprintf(stderr, "For more information use: %s --help\n", filename);
+            exit(ERR_ARGS);
+        }
+    }
+
+    if (inputs_len <= 0 || outputs_len < 0) {
+        fprintf(stderr, "Error: Invalid vector lengths (inputs: %d, outputs: %d)\n", inputs_len, outputs_len);
+        exit(ERR_ARGS);
+    }
+
+    if (outputs_len > 0 && fnn_outputs_set == NULL) {
+        fprintf(stderr, "Error: Missing argument for --outputs-set\n");
+        exit(ERR_ARGS);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Main Entry Point
+// -----------------------------------------------------------------------------
+
+int main(int argc, char *argv[]) {
+    // process command-line arguments
+    process_arguments(argc, argv);
+
+    printf("Converter mode: text to binary\n");
+    printf(" ―→█   Dataset file: %s\n", fnn_dataset_set);
+    if (outputs_len > 0) {
+        printf(" ―→█   Outputs file: %s\n", fnn_outputs_set);
+    }
+    printf("   █―→ Binary  file: %s\n", fnn_dataset_bin);
+
+    // register cleanup handler
+    atexit(cleanup_resources);
+
+    buffer_x = calloc(inputs_len, sizeof(float));
+    buffer_t = calloc(outputs_len > 0 ? outputs_len : 1, sizeof(float));
+    if (buffer_x == NULL || buffer_t == NULL) {
+        exit(ERR_NULL);
+    }
+
+    file_dataset_set = data_reader_open(fnn_dataset_set);
+    if (file_dataset_set == NULL) {
+        exit(ERR_FILE);
+    }
+
+    if (outputs_len > 0) {
+        file_outputs_set = data_reader_open(fnn_outputs_set);
+        if (file_outputs_set == NULL) {
+            exit(ERR_FILE);
+        }
+    }
+
+    file_dataset_bin = fopen(fnn_dataset_bin, "wb");
+    if (file_dataset_bin == NULL) {
+        printf("[ERROR] Unable to open file '%s'\n", fnn_dataset_bin);
+        exit(ERR_FILE);
+    }
+
+    data_mapper_header_t header;
+    if (!data_mapper_header_init(&header, inputs_len, outputs_len)) {
+        exit(ERR_ARGS);
+    }
+
+    // reserve the header block, it is rewritten once the samples are counted
+    if (!data_mapper_write_header(file_dataset_bin, &header)) {
+        exit(ERR_FILE);
+    }
+
+    while (data_reader_next_values(file_dataset_set, buffer_x, inputs_len)) {
+        if (outputs_len > 0) {
+            if (!data_reader_next_values(file_outputs_set, buffer_t, outputs_len)) {
+                printf("[ERROR] Outputs file ended before dataset file\n");
+                exit(ERR_DATA);
+            }
+        }
+
+        if (!data_mapper_write_sample(file_dataset_bin, &header, buffer_x, buffer_t)) {
+            exit(ERR_FILE);
+        }
+    }
+
+    if (!data_mapper_write_header(file_dataset_bin, &header)) {
+        exit(ERR_FILE);
+    }
+
+    printf("[INFO] Total samples converted: %llu\n", (unsigned long long)header.samples);
+    printf("[INFO] Record stride in bytes: %llu\n", (unsigned long long)header.stride);
+
+    cleanup_resources();
+
+    puts("... Done!");
+    return ERR_NONE;
+}
+
+// -----------------------------------------------------------------------------
+// End of File
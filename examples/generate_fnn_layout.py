@@ -181,6 +181,8 @@ def generate_data_arrays(layers, activations, learning_rates):
                 ("float",             f"{lname}_LR",                    f"= {lr}f;"),
                 ("g_act_func_type_t", f"{lname}_AF_TYPE",               f"= {act};"),
                 ("float",             f"{lname}_AF_ARGS[{af_args_len}]",f"= {af_args_init};"),  # vector
+                ("float",             f"{lname}_M[{layers[i]}][{layers[i-1]+1}]", "= {{0.0f}};"),  # matrix
+                ("float",             f"{lname}_V[{layers[i]}][{layers[i-1]+1}]", "= {{0.0f}};"),  # matrix
             ])
         # Alignment
         max_type = max(len(t) for t, n, v in block)
@@ -225,6 +227,12 @@ def generate_linking_body(layers):
             ("af_type",     f"{lname}_AF_TYPE"),
             ("af_args.ptr", f"{lname}_AF_ARGS"),
             ("af_args.len", f"SIZEOF({lname}_AF_ARGS)"),
+            ("m.ptr",       f"(float *){lname}_M"),
+            ("m.row",       f"SIZEOF({lname}_M)"),
+            ("m.col",       f"SIZEOF({lname}_M[0])"),
+            ("v.ptr",       f"(float *){lname}_V"),
+            ("v.row",       f"SIZEOF({lname}_V)"),
+            ("v.col",       f"SIZEOF({lname}_V[0])"),
         ]
         lines.append(f"    // Layer {i}")
         lines.append(f"    g_page_reset(&page[{idx}]);")
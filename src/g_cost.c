@@ -0,0 +1,292 @@
+// -----------------------------------------------------------------------------
+// @file g_cost.c
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#include "g_cost.h"
+
+#include <stdio.h>  // fclose, fopen, fscanf, printf, snprintf
+#include <stdlib.h> // calloc, free
+#include <string.h> // memset, strcmp
+#include <unistd.h> // sysconf
+
+// -----------------------------------------------------------------------------
+
+#define G_COST_SYSFS_INDICES 8 // cache descriptions looked up in sysfs
+
+// activation and its derivative, per neuron (exp, sqrt, div as one)
+static double __act_flops(g_act_func_type_t af_type) {
+    switch (af_type) {
+        case LINEAR:
+            return 0.0;
+        case TANH:
+            return 3.0; // tanh, 1 - y * y
+        case RELU:
+            return 2.0;
+        case LEAKY_RELU:
+        case PRELU:
+            return 3.0;
+        case SWISH:
+            return 8.0; // sigmoid, z * s, s + y * (1 - s)
+        case ELU:
+            return 4.0;
+        case SOFTPLUS:
+            return 7.0; // log(1 + exp), sigmoid
+        case SIGMOID:
+            return 5.0;
+        case SOFTMAX:
+            return 7.0; // max, exp, sum, exp, div, y * (1 - y)
+        default:
+            return 0.0;
+    }
+}
+
+// weight update, per weight (the gradient de_dz * x included)
+static double __optim_flops(g_optim_type_t op_type) {
+    switch (op_type) {
+        case SGD:
+            return 3.0;
+        case MOMENTUM:
+            return 5.0;
+        case NESTEROV:
+            return 7.0;
+        case RMSPROP:
+            return 11.0;
+        case ADAM:
+            return 16.0;
+        default:
+            return 3.0;
+    }
+}
+
+static size_t __sysfs_cache(int level, bool data) {
+    size_t rvalue = 0;
+
+    for (int index = 0; index < G_COST_SYSFS_INDICES; ++index) {
+        char path[128];
+        char type[32] = {0};
+        int  found    = 0;
+        long size     = 0;
+
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/level", index);
+        FILE *file = fopen(path, "r");
+        if (file == NULL) {
+            break;
+        }
+        if (fscanf(file, "%d", &found) != 1) {
+            found = 0;
+        }
+        fclose(file);
+
+        if (found != level) {
+            continue;
+        }
+
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/type", index);
+        file = fopen(path, "r");
+        if ((file != NULL) && (fscanf(file, "%31s", type) != 1)) {
+            type[0] = '\0';
+        }
+        if (file != NULL) {
+            fclose(file);
+        }
+
+        if (data && (strcmp(type, "Instruction") == 0)) {
+            continue;
+        }
+
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/size", index);
+        file = fopen(path, "r");
+        if (file != NULL) {
+            char unit = 'K';
+
+            if (fscanf(file, "%ld%c", &size, &unit) >= 1) {
+                size *= (unit == 'M') ? 1024L * 1024L : (unit == 'K') ? 1024L : 1L;
+            }
+            fclose(file);
+        }
+
+        if (size > 0) {
+            rvalue = (size_t)size;
+            break;
+        }
+    }
+
+    return rvalue;
+}
+
+static void __detect_caches(size_t cache[G_COST_LEVELS]) {
+    long size[G_COST_LEVELS] = {0};
+
+#if defined(_SC_LEVEL1_DCACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE) && defined(_SC_LEVEL3_CACHE_SIZE)
+    size[G_COST_L1]  = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+    size[G_COST_L2]  = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    size[G_COST_LLC] = sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+
+    for (int l = 0; l < G_COST_LEVELS; ++l) {
+        cache[l] = (size[l] > 0) ? (size_t)size[l] : __sysfs_cache(l + 1, l == G_COST_L1);
+    }
+
+    // without a third level the second one is the last
+    if ((cache[G_COST_LLC] == 0) && (cache[G_COST_L2] > 0)) {
+        cache[G_COST_LLC] = cache[G_COST_L2];
+    }
+}
+
+static g_cost_level_t __fit(const size_t cache[G_COST_LEVELS], size_t bytes) {
+    for (int l = 0; l < G_COST_LEVELS; ++l) {
+        if ((cache[l] > 0) && (bytes <= cache[l])) {
+            return (g_cost_level_t)l;
+        }
+    }
+
+    return G_COST_DRAM;
+}
+
+static void __intensity(g_cost_layer_t *layer) {
+    layer->forward_intensity  = (layer->forward_bytes > 0.0) ? layer->forward_flops / layer->forward_bytes : 0.0;
+    layer->backward_intensity = (layer->backward_bytes > 0.0) ? layer->backward_flops / layer->backward_bytes : 0.0;
+}
+
+static void __layer_cost(g_cost_layer_t *layer, const g_page_t *page, bool first) {
+    const double F = (double)sizeof(float);
+
+    const size_t N = (size_t)page->x.len; // inputs
+    const size_t P = (size_t)page->y.len; // neurons
+    const size_t W = (size_t)page->w.row * (size_t)page->w.col;
+
+    size_t states = 0;
+    states += (page->m.ptr != NULL) ? (size_t)page->m.row * (size_t)page->m.col : 0;
+    states += (page->v.ptr != NULL) ? (size_t)page->v.row * (size_t)page->v.col : 0;
+
+    layer->inputs  = (int)N;
+    layer->neurons = (int)P;
+    layer->params  = W;
+
+    layer->weight_bytes     = W * sizeof(float);
+    layer->state_bytes      = states * sizeof(float);
+    layer->activation_bytes = ((first ? N : 0) + 2 * P) * sizeof(float); // X belongs to the previous layer
+    layer->gradient_bytes   = 2 * P * sizeof(float);
+
+    // Z = W X + b, then Y and dY/dZ
+    layer->forward_flops = 2.0 * (double)(P * N) + (double)P + __act_flops(page->af_type) * (double)P;
+    layer->forward_bytes = F * (double)(W + N + 3 * P);
+
+    // dE/dZ and the update of every weight
+    layer->backward_flops = (double)P + __optim_flops(page->op_type) * (double)W;
+    layer->backward_bytes = F * (double)(2 * P + N + 2 * W + 2 * states);
+
+    // dE/dY of the previous layer, through these weights
+    if (!first) {
+        layer->backward_flops += 3.0 * (double)(P * N) + 2.0 * (double)N;
+        layer->backward_bytes += F * (double)(P * N + 2 * P + N);
+    }
+
+    __intensity(layer);
+
+    layer->working_set = layer->weight_bytes + layer->state_bytes + (N + 4 * P) * sizeof(float);
+}
+
+// -----------------------------------------------------------------------------
+
+bool g_cost_analyze(g_cost_t *self, const g_pages_t *pages) {
+    if (self == NULL || pages == NULL || pages->ptr == NULL || pages->len < 1) {
+        printf("[ERROR] Invalid arguments for cost analysis\n");
+        return false;
+    }
+
+    memset(self, 0, sizeof(*self));
+
+    self->layers = calloc(pages->len, sizeof(g_cost_layer_t));
+    if (self->layers == NULL) {
+        printf("[ERROR] Unable to allocate cost layers\n");
+        return false;
+    }
+
+    self->len = pages->len;
+
+    __detect_caches(self->cache);
+
+    g_cost_layer_t *total = &self->total;
+
+    total->inputs = pages->ptr[0].x.len;
+
+    for (int k = 0; k < self->len; ++k) {
+        g_cost_layer_t *layer = &self->layers[k];
+
+        __layer_cost(layer, &pages->ptr[k], k == 0);
+
+        layer->fit = __fit(self->cache, layer->working_set);
+
+        total->neurons += layer->neurons;
+        total->params += layer->params;
+        total->weight_bytes += layer->weight_bytes;
+        total->state_bytes += layer->state_bytes;
+        total->activation_bytes += layer->activation_bytes;
+        total->gradient_bytes += layer->gradient_bytes;
+        total->forward_flops += layer->forward_flops;
+        total->backward_flops += layer->backward_flops;
+        total->forward_bytes += layer->forward_bytes;
+        total->backward_bytes += layer->backward_bytes;
+    }
+
+    __intensity(total);
+
+    // the whole network stays resident from one sample to the next
+    total->working_set = total->weight_bytes + total->state_bytes + total->activation_bytes + total->gradient_bytes;
+    total->fit = __fit(self->cache, total->working_set);
+
+    return true;
+}
+
+void g_cost_free(g_cost_t *self) {
+    if (self != NULL) {
+        free(self->layers);
+        self->layers = NULL;
+        self->len    = 0;
+    }
+}
+
+static const char *__level_name(g_cost_level_t level) {
+    static const char *names[] = {"L1", "L2", "LLC", "DRAM"};
+
+    return names[level];
+}
+
+static void __print_row(const char *label, const g_cost_layer_t *layer) {
+    printf("%-6s %6d %6d %10zu %10zu %10zu %12.0f %12.0f %7.3f %7.3f %10zu  %s\n", label, layer->inputs,
+           layer->neurons, layer->params, layer->activation_bytes, layer->gradient_bytes, layer->forward_flops,
+           layer->backward_flops, layer->forward_intensity, layer->backward_intensity, layer->working_set,
+           __level_name(layer->fit));
+}
+
+void g_cost_report(const g_cost_t *self) {
+    if (self == NULL || self->layers == NULL) {
+        return;
+    }
+
+    printf("[INFO] Cost model, per sample (caches: L1d %zu B, L2 %zu B, LLC %zu B%s):\n", self->cache[G_COST_L1],
+           self->cache[G_COST_L2], self->cache[G_COST_LLC], (self->cache[G_COST_L1] == 0) ? " (not detected)" : "");
+    printf("%-6s %6s %6s %10s %10s %10s %12s %12s %7s %7s %10s  %s\n", "layer", "in", "out", "params", "act B",
+           "grad B", "fwd FLOP", "bwd FLOP", "fwd AI", "bwd AI", "working B", "fits");
+
+    for (int k = 0; k < self->len; ++k) {
+        char label[16];
+        snprintf(label, sizeof(label), "%d", k);
+
+        __print_row(label, &self->layers[k]);
+    }
+
+    __print_row("total", &self->total);
+
+    printf("[INFO] Weights %zu B, optimizer state %zu B, moved %.0f B forward, %.0f B backward\n",
+           self->total.weight_bytes, self->total.state_bytes, self->total.forward_bytes,
+           self->total.backward_bytes);
+}
+
+// -----------------------------------------------------------------------------
+// End of File
@@ -0,0 +1,77 @@
+// -----------------------------------------------------------------------------
+// @file g_cost.h
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#ifndef G_COST_H
+#define G_COST_H
+
+#include <stdbool.h> // bool
+#include <stddef.h>  // size_t
+
+#include "g_page.h" // g_pages_t
+
+// -----------------------------------------------------------------------------
+/*
+ * Static cost model of a network, from the shapes of its pages alone. Every
+ * figure is per sample: FLOPs count a multiply, an add or a transcendental
+ * as one; bytes count every float operand of the kernel once (perfect
+ * reuse), so the arithmetic intensity is an upper bound. The working set of
+ * a layer is everything one training step touches: weights, optimizer
+ * moments, inputs, activations and gradients; it is compared with the cache
+ * sizes reported by the system.
+ */
+
+typedef enum g_cost_level_t {
+    G_COST_L1,  // L1 data cache
+    G_COST_L2,  // L2 cache
+    G_COST_LLC, // last level cache
+    G_COST_DRAM,
+    G_COST_LEVELS = G_COST_DRAM
+} g_cost_level_t;
+
+typedef struct g_cost_layer_t {
+    int inputs;  // without the bias
+    int neurons;
+
+    size_t params;           // weights and biases
+    size_t weight_bytes;     // W
+    size_t state_bytes;      // optimizer moments M, V
+    size_t activation_bytes; // X, Z, Y
+    size_t gradient_bytes;   // dY/dZ, dE/dY
+
+    double forward_flops;  // weighted sums and activation
+    double backward_flops; // errors into the previous layer, weight update
+    double forward_bytes;  // moved by the forward pass
+    double backward_bytes; // moved by the backward pass
+
+    double forward_intensity; // FLOPs per byte
+    double backward_intensity;
+
+    size_t         working_set; // bytes touched by one training step
+    g_cost_level_t fit;         // smallest level holding the working set
+} g_cost_layer_t;
+
+typedef struct g_cost_t {
+    g_cost_layer_t *layers;
+    int             len;
+    g_cost_layer_t  total; // sums, working set of the whole network
+
+    size_t cache[G_COST_LEVELS]; // bytes per level, 0 when unknown
+} g_cost_t;
+
+// -----------------------------------------------------------------------------
+
+bool g_cost_analyze(g_cost_t *self, const g_pages_t *pages);
+
+void g_cost_free(g_cost_t *self);
+
+void g_cost_report(const g_cost_t *self);
+
+#endif // G_COST_H
+
+// -----------------------------------------------------------------------------
+// End of File
@@ -0,0 +1,216 @@
+// -----------------------------------------------------------------------------
+// @file g_histogram.c
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#include "g_histogram.h"
+
+#include <stdio.h>  // printf
+#include <stdlib.h> // calloc, free
+#include <string.h> // memset
+
+// -----------------------------------------------------------------------------
+
+static inline int32_t __log2_ceil(uint64_t value) {
+    int32_t rvalue = 0;
+    while (((uint64_t)1 << rvalue) < value) {
+        rvalue++;
+    }
+    return rvalue;
+}
+
+static inline int32_t __bucket_index(const g_histogram_t *self, uint64_t value) {
+    // position of the highest set bit, the mask folds small values into bucket 0
+    const int32_t pow2_ceiling = 64 - __builtin_clzll(value | self->sub_bucket_mask);
+
+    return pow2_ceiling - self->unit_magnitude - (self->sub_bucket_half_magnitude + 1);
+}
+
+static inline int32_t __sub_bucket_index(const g_histogram_t *self, uint64_t value, int32_t bucket_index) {
+    return (int32_t)(value >> (bucket_index + self->unit_magnitude));
+}
+
+static inline int32_t __counts_index(const g_histogram_t *self, int32_t bucket_index, int32_t sub_bucket_index) {
+    // the lower half of every bucket but the first overlaps the previous one
+    const int32_t bucket_base = (bucket_index + 1) << self->sub_bucket_half_magnitude;
+
+    return bucket_base + (sub_bucket_index - self->sub_bucket_half_count);
+}
+
+static inline uint64_t __value_at(const g_histogram_t *self, int32_t index) {
+    int32_t bucket_index     = (index >> self->sub_bucket_half_magnitude) - 1;
+    int32_t sub_bucket_index = (index & (self->sub_bucket_half_count - 1)) + self->sub_bucket_half_count;
+
+    if (bucket_index < 0) {
+        sub_bucket_index -= self->sub_bucket_half_count;
+        bucket_index = 0;
+    }
+
+    return (uint64_t)sub_bucket_index << (bucket_index + self->unit_magnitude);
+}
+
+static inline uint64_t __highest_equivalent(const g_histogram_t *self, uint64_t value) {
+    const int32_t bucket_index     = __bucket_index(self, value);
+    const int32_t sub_bucket_index = __sub_bucket_index(self, value, bucket_index);
+
+    const uint64_t lowest = (uint64_t)sub_bucket_index << (bucket_index + self->unit_magnitude);
+    const int32_t  width  = (sub_bucket_index >= self->sub_bucket_count) ? bucket_index + 1 : bucket_index;
+
+    return lowest + ((uint64_t)1 << (self->unit_magnitude + width)) - 1;
+}
+
+// -----------------------------------------------------------------------------
+
+bool g_histogram_init(g_histogram_t *self, uint64_t lowest, uint64_t highest, int digits) {
+    if (self == NULL || lowest < 1 || digits < 1 || digits > 5 || highest < 2 * lowest) {
+        printf("[ERROR] Invalid arguments for histogram init\n");
+        return false;
+    }
+
+    memset(self, 0, sizeof(*self));
+
+    uint64_t largest_single_unit = 2;
+    for (int d = 0; d < digits; ++d) {
+        largest_single_unit *= 10;
+    }
+
+    self->lowest  = lowest;
+    self->highest = highest;
+    self->digits  = digits;
+
+    self->unit_magnitude            = __log2_ceil(lowest + 1) - 1; // floor(log2(lowest))
+    self->sub_bucket_half_magnitude = __log2_ceil(largest_single_unit) - 1;
+    self->sub_bucket_count          = (int32_t)1 << (self->sub_bucket_half_magnitude + 1);
+    self->sub_bucket_half_count     = self->sub_bucket_count / 2;
+    self->sub_bucket_mask           = ((uint64_t)self->sub_bucket_count - 1) << self->unit_magnitude;
+
+    // buckets until the first value that can no longer be represented exceeds highest
+    uint64_t smallest_untrackable = (uint64_t)self->sub_bucket_count << self->unit_magnitude;
+
+    self->bucket_count = 1;
+    while (smallest_untrackable <= highest) {
+        if (smallest_untrackable > UINT64_MAX / 2) {
+            self->bucket_count++;
+            break;
+        }
+
+        smallest_untrackable <<= 1;
+        self->bucket_count++;
+    }
+
+    self->counts_len = (self->bucket_count + 1) * self->sub_bucket_half_count;
+
+    self->counts = calloc(self->counts_len, sizeof(uint64_t));
+    if (self->counts == NULL) {
+        printf("[ERROR] Unable to allocate histogram counts\n");
+        return false;
+    }
+
+    self->min = UINT64_MAX;
+
+    return true;
+}
+
+void g_histogram_free(g_histogram_t *self) {
+    if (self != NULL) {
+        free(self->counts);
+        self->counts     = NULL;
+        self->counts_len = 0;
+    }
+}
+
+void g_histogram_reset(g_histogram_t *self) {
+    memset(self->counts, 0, sizeof(uint64_t) * self->counts_len);
+
+    self->total   = 0;
+    self->clamped = 0;
+    self->min     = UINT64_MAX;
+    self->max     = 0;
+}
+
+void g_histogram_record(g_histogram_t *self, uint64_t value) {
+    // exact extremes, even for clamped values
+    self->min = (value < self->min) ? value : self->min;
+    self->max = (value > self->max) ? value : self->max;
+
+    if (value > self->highest) {
+        value = self->highest;
+        self->clamped++;
+    }
+
+    const int32_t bucket_index     = __bucket_index(self, value);
+    const int32_t sub_bucket_index = __sub_bucket_index(self, value, bucket_index);
+
+    self->counts[__counts_index(self, bucket_index, sub_bucket_index)]++;
+    self->total++;
+}
+
+bool g_histogram_merge(g_histogram_t *self, const g_histogram_t *other) {
+    if (self->counts_len != other->counts_len || self->unit_magnitude != other->unit_magnitude ||
+        self->sub_bucket_count != other->sub_bucket_count) {
+        printf("[ERROR] Unable to merge histograms of different layouts\n");
+        return false;
+    }
+
+    for (int32_t i = 0; i < self->counts_len; ++i) {
+        self->counts[i] += other->counts[i];
+    }
+
+    self->total += other->total;
+    self->clamped += other->clamped;
+
+    self->min = (other->min < self->min) ? other->min : self->min;
+    self->max = (other->max > self->max) ? other->max : self->max;
+
+    return true;
+}
+
+uint64_t g_histogram_percentile(const g_histogram_t *self, double percentile) {
+    if (self->total == 0) {
+        return 0;
+    }
+
+    percentile = (percentile < 0.0) ? 0.0 : (percentile > 100.0) ? 100.0 : percentile;
+
+    // rank of the value, at least the first one
+    uint64_t rank = (uint64_t)(percentile / 100.0 * (double)self->total + 0.5);
+    rank          = (rank < 1) ? 1 : rank;
+
+    uint64_t seen = 0;
+    for (int32_t i = 0; i < self->counts_len; ++i) {
+        seen += self->counts[i];
+
+        if (seen >= rank) {
+            const uint64_t value = __highest_equivalent(self, __value_at(self, i));
+
+            // exact at the ends
+            return (value > self->max || seen == self->total) ? self->max : (value < self->min) ? self->min : value;
+        }
+    }
+
+    return self->max;
+}
+
+double g_histogram_mean(const g_histogram_t *self) {
+    if (self->total == 0) {
+        return 0.0;
+    }
+
+    double sum = 0.0;
+    for (int32_t i = 0; i < self->counts_len; ++i) {
+        if (self->counts[i] > 0) {
+            const uint64_t lowest = __value_at(self, i);
+
+            // middle of the sub-bucket
+            sum += (double)self->counts[i] * 0.5 * (double)(lowest + __highest_equivalent(self, lowest));
+        }
+    }
+
+    return sum / (double)self->total;
+}
+
+// -----------------------------------------------------------------------------
+// End of File
@@ -0,0 +1,71 @@
+// -----------------------------------------------------------------------------
+// @file g_histogram.h
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#ifndef G_HISTOGRAM_H
+#define G_HISTOGRAM_H
+
+#include <stdbool.h> // bool
+#include <stdint.h>  // int32_t, uint64_t
+
+// -----------------------------------------------------------------------------
+/*
+ * High dynamic range histogram (HdrHistogram layout) of positive integer
+ * values, typically latencies in nanoseconds. Values in [lowest, highest]
+ * are kept with the given number of significant decimal digits (1 to 5):
+ * buckets of doubling width, each split into the same number of linear
+ * sub-buckets. Memory is allocated once at init and recording is an index
+ * computation and an increment; values above highest are clamped.
+ *
+ * A histogram is not thread-safe: every thread records into its own, and
+ * histograms with the same layout are merged by adding their counts once
+ * the threads are done, without locks.
+ */
+
+typedef struct g_histogram_t {
+    uint64_t lowest;  // smallest discernible value
+    uint64_t highest; // largest trackable value
+    int      digits;  // significant decimal digits
+
+    int32_t  unit_magnitude;            // log2(lowest)
+    int32_t  sub_bucket_half_magnitude; // log2(sub_bucket_count) - 1
+    int32_t  sub_bucket_count;          // linear sub-buckets per bucket
+    int32_t  sub_bucket_half_count;     // sub-buckets not shared with the previous bucket
+    int32_t  bucket_count;              // buckets of doubling width
+    uint64_t sub_bucket_mask;           // values below it fall into bucket 0
+
+    uint64_t *counts;
+    int32_t   counts_len;
+
+    uint64_t total;   // values recorded
+    uint64_t clamped; // values above highest, counted as highest
+    uint64_t min;
+    uint64_t max;
+} g_histogram_t;
+
+// -----------------------------------------------------------------------------
+
+bool g_histogram_init(g_histogram_t *self, uint64_t lowest, uint64_t highest, int digits);
+
+void g_histogram_free(g_histogram_t *self);
+
+void g_histogram_reset(g_histogram_t *self);
+
+void g_histogram_record(g_histogram_t *self, uint64_t value);
+
+// adds the counts of other, false when the layouts differ
+bool g_histogram_merge(g_histogram_t *self, const g_histogram_t *other);
+
+// value at the given percentile (0 to 100), the highest of its sub-bucket
+uint64_t g_histogram_percentile(const g_histogram_t *self, double percentile);
+
+double g_histogram_mean(const g_histogram_t *self);
+
+#endif // G_HISTOGRAM_H
+
+// -----------------------------------------------------------------------------
+// End of File
@@ -8,11 +8,14 @@
 
 #include "g_layer.h"
 
-#include <assert.h> // assert
-#include <math.h>   // expf, fmaxf, fminf, sqrtf
-#include <stdlib.h> // NULL, calloc, free
+#include <assert.h>  // assert
+#include <math.h>    // expf, fmaxf, fminf, sqrtf
+#include <pthread.h> // pthread_create, pthread_join, pthread_t
+#include <stdlib.h>  // NULL, calloc, free
+#include <string.h>  // memset
 
-#include "g_random.h" // g_random_range
+#include "g_profile.h" // G_PROFILE_BEGIN, G_PROFILE_END
+#include "g_random.h"  // g_random_fill_uniform, g_random_jump
 
 // -----------------------------------------------------------------------------
 
@@ -28,24 +31,197 @@ static void __unsafe_reset(g_layer_t *self) {
     self->_is_safe = false;
 }
 
-static void __he_uniform_init(float *weights, int fan_in, float bias) {
-    const float std_dev = sqrtf(6.0f / fan_in);
+// Weight initialization: the rows are split in as many slices as threads,
+// slice t draws from stream t of the generator, so the weights depend on the
+// seed and the thread count only. Small layers run the slices in turn.
 
-    for (int i = 0; i < fan_in; ++i) {
-        weights[i] = g_random_range(-std_dev, std_dev);
+#define G_LAYER_INIT_PARALLEL (1 << 16) // weights worth a thread per slice
+
+typedef struct g_layer_init_t {
+    g_page_t  *page;
+    g_random_t random;
+    int        begin; // first row
+    int        end;   // last row, excluded
+    float      limit; // uniform in [-limit, limit)
+    float      bias;
+    pthread_t  thread;
+} g_layer_init_t;
+
+static void *__init_rows(void *arg) {
+    g_layer_init_t *slice = arg;
+
+    const int fan_in = slice->page->x.len;
+
+    for (int j = slice->begin; j < slice->end; ++j) {
+        float *Wj = f_matrix_row(&slice->page->w, j);
+
+        g_random_fill_uniform(&slice->random, Wj, fan_in, -slice->limit, slice->limit);
+
+        Wj[fan_in] = slice->bias;
+    }
+
+    return NULL;
+}
+
+// Fused update kernels: one pass over the row of the n-th neuron computes the
+// gradient (dE/dz * x, bias input is 1), refreshes the moments and applies it.
+
+static void __op_sgd(g_page_t *page, int n_id, float de_dz) {
+    const int    N = page->x.len;
+    const float *X = page->x.ptr;
+    float       *W = f_matrix_row(&page->w, n_id);
+
+    const float lr = page->lr;
+
+    for (int i = 0; i < N; ++i) {
+        W[i] -= lr * de_dz * X[i];
+    }
+
+    W[N] -= lr * de_dz;
+}
+
+static void __op_momentum(g_page_t *page, int n_id, float de_dz) {
+    const int    N = page->x.len;
+    const float *X = page->x.ptr;
+    float       *W = f_matrix_row(&page->w, n_id);
+    float       *M = f_matrix_row(&page->m, n_id);
+
+    const float lr = page->lr;
+    const float b1 = page->op_args.beta_1;
+
+    for (int i = 0; i < N; ++i) {
+        M[i] = b1 * M[i] + de_dz * X[i];
+        W[i] -= lr * M[i];
+    }
+
+    M[N] = b1 * M[N] + de_dz;
+    W[N] -= lr * M[N];
+}
+
+static void __op_nesterov(g_page_t *page, int n_id, float de_dz) {
+    const int    N = page->x.len;
+    const float *X = page->x.ptr;
+    float       *W = f_matrix_row(&page->w, n_id);
+    float       *M = f_matrix_row(&page->m, n_id);
+
+    const float lr = page->lr;
+    const float b1 = page->op_args.beta_1;
+
+    for (int i = 0; i < N; ++i) {
+        const float g = de_dz * X[i];
+
+        M[i] = b1 * M[i] + g;
+        W[i] -= lr * (g + b1 * M[i]);
+    }
+
+    M[N] = b1 * M[N] + de_dz;
+    W[N] -= lr * (de_dz + b1 * M[N]);
+}
+
+static void __op_rmsprop(g_page_t *page, int n_id, float de_dz) {
+    const int    N = page->x.len;
+    const float *X = page->x.ptr;
+    float       *W = f_matrix_row(&page->w, n_id);
+    float       *V = f_matrix_row(&page->v, n_id);
+
+    const float lr  = page->lr;
+    const float b2  = page->op_args.beta_2;
+    const float eps = page->op_args.epsilon;
+
+    for (int i = 0; i < N; ++i) {
+        const float g = de_dz * X[i];
+
+        V[i] = b2 * V[i] + (1.0f - b2) * g * g;
+        W[i] -= lr * g / (sqrtf(V[i]) + eps);
     }
 
-    weights[fan_in] = bias;
+    V[N] = b2 * V[N] + (1.0f - b2) * de_dz * de_dz;
+    W[N] -= lr * de_dz / (sqrtf(V[N]) + eps);
+}
+
+static void __op_adam(g_page_t *page, int n_id, float de_dz) {
+    const int    N = page->x.len;
+    const float *X = page->x.ptr;
+    float       *W = f_matrix_row(&page->w, n_id);
+    float       *M = f_matrix_row(&page->m, n_id);
+    float       *V = f_matrix_row(&page->v, n_id);
+
+    const float b1  = page->op_args.beta_1;
+    const float b2  = page->op_args.beta_2;
+    const float eps = page->op_args.epsilon;
+
+    // bias corrections folded into the step size and the second moment
+    const float lr_t = page->lr / (1.0f - page->op_args.beta_1_t);
+    const float c2_t = 1.0f / (1.0f - page->op_args.beta_2_t);
+
+    for (int i = 0; i < N; ++i) {
+        const float g = de_dz * X[i];
+
+        M[i] = b1 * M[i] + (1.0f - b1) * g;
+        V[i] = b2 * V[i] + (1.0f - b2) * g * g;
+        W[i] -= lr_t * M[i] / (sqrtf(V[i] * c2_t) + eps);
+    }
+
+    M[N] = b1 * M[N] + (1.0f - b1) * de_dz;
+    V[N] = b2 * V[N] + (1.0f - b2) * de_dz * de_dz;
+    W[N] -= lr_t * M[N] / (sqrtf(V[N] * c2_t) + eps);
+}
+
+static bool __op_buffer_check(g_page_t *page, f_matrix_t *buffer) {
+    bool rvalue = buffer->ptr != NULL;
+
+    rvalue = rvalue && (buffer->ptr != page->w.ptr);
+    rvalue = rvalue && (buffer->row == page->w.row);
+    rvalue = rvalue && (buffer->col == page->w.col);
+
+    return rvalue;
 }
 
-static void __xavier_uniform_init(float *weights, int fan_in, int fan_out, float bias) {
-    const float std_dev = sqrtf(6.0f / (fan_in + fan_out));
+static bool __op_link(g_page_t *page) {
+    bool rvalue = true;
+
+    switch (page->op_type) {
+        case SGD: {
+            page->op_call = __op_sgd;
+        } break;
+
+        case MOMENTUM: {
+            page->op_call = __op_momentum;
+
+            rvalue = rvalue && __op_buffer_check(page, &page->m);
+        } break;
+
+        case NESTEROV: {
+            page->op_call = __op_nesterov;
+
+            rvalue = rvalue && __op_buffer_check(page, &page->m);
+        } break;
+
+        case RMSPROP: {
+            page->op_call = __op_rmsprop;
+
+            rvalue = rvalue && __op_buffer_check(page, &page->v);
+        } break;
 
-    for (int i = 0; i < fan_in; ++i) {
-        weights[i] = g_random_range(-std_dev, std_dev);
+        case ADAM: {
+            page->op_call = __op_adam;
+
+            rvalue = rvalue && __op_buffer_check(page, &page->m);
+            rvalue = rvalue && __op_buffer_check(page, &page->v);
+        } break;
+
+        default: {
+            rvalue = false;
+        } break;
+    }
+
+    if (!rvalue) {
+        // missing state buffers: keep training with plain SGD
+        page->op_type = SGD;
+        page->op_call = __op_sgd;
     }
 
-    weights[fan_in] = bias;
+    return rvalue;
 }
 
 static bool Create(struct g_layer_t *self, g_page_t *page, int l_id) {
@@ -77,6 +253,10 @@ static bool Create(struct g_layer_t *self, g_page_t *page, int l_id) {
             }
         }
 
+        if (rvalue && (page->op_call == NULL)) {
+            rvalue = __op_link(page);
+        }
+
         self->_is_safe = rvalue;
 
         if (rvalue) {
@@ -110,34 +290,28 @@ static void Destroy(struct g_layer_t *self) {
     }
 }
 
-static void Init_Weights(struct g_layer_t *self, float bias) {
-    if ((self != NULL) && self->_is_safe) {
+static void Init_Weights(struct g_layer_t *self, float bias, const g_random_t *random, int threads) {
+    if ((self != NULL) && self->_is_safe && (random != NULL) && (threads > 0)) {
         const int fan_in  = self->page->x.len;
         const int fan_out = self->page->y.len;
 
         const g_act_func_type_t af_type = self->page->af_type;
 
+        float limit = 0.0f;
+
         switch (af_type) {
             case RELU:
             case LEAKY_RELU:
             case PRELU:
             case SWISH:
             case ELU: {
-                for (int j = 0; j < fan_out; ++j) {
-                    float *Wj = f_matrix_row(&self->page->w, j);
-
-                    __he_uniform_init(Wj, fan_in, bias);
-                }
+                limit = sqrtf(6.0f / fan_in); // He uniform
             } break;
 
             case TANH:
             case SIGMOID:
             case SOFTMAX: {
-                for (int j = 0; j < fan_out; ++j) {
-                    float *Wj = f_matrix_row(&self->page->w, j);
-
-                    __xavier_uniform_init(Wj, fan_in, fan_out, bias);
-                }
+                limit = sqrtf(6.0f / (fan_in + fan_out)); // Xavier uniform
             } break;
 
             default: {
@@ -150,8 +324,52 @@ static void Init_Weights(struct g_layer_t *self, float bias) {
                     }
                     Wj[fan_in] = bias;
                 }
-            } break;
+                return;
+            }
+        }
+
+        g_layer_init_t *slices = calloc(threads, sizeof(g_layer_init_t));
+        if (slices == NULL) {
+            return;
+        }
+
+        g_random_t stream = *random;
+
+        for (int t = 0; t < threads; ++t) {
+            slices[t].page   = self->page;
+            slices[t].random = stream;
+            slices[t].begin  = (int)((long)fan_out * t / threads);
+            slices[t].end    = (int)((long)fan_out * (t + 1) / threads);
+            slices[t].limit  = limit;
+            slices[t].bias   = bias;
+
+            g_random_jump(&stream);
+        }
+
+        const bool parallel = (threads > 1) && ((long)fan_out * (fan_in + 1) >= G_LAYER_INIT_PARALLEL);
+
+        // slice 0 runs on the calling thread, as does any slice whose thread
+        // cannot start
+        bool *started = calloc(threads, sizeof(bool));
+
+        for (int t = 1; parallel && (started != NULL) && (t < threads); ++t) {
+            started[t] = pthread_create(&slices[t].thread, NULL, __init_rows, &slices[t]) == 0;
         }
+
+        for (int t = 0; t < threads; ++t) {
+            if ((started == NULL) || !started[t]) {
+                __init_rows(&slices[t]);
+            }
+        }
+
+        for (int t = 1; (started != NULL) && (t < threads); ++t) {
+            if (started[t]) {
+                pthread_join(slices[t].thread, NULL);
+            }
+        }
+
+        free(started);
+        free(slices);
     }
 }
 
@@ -161,10 +379,15 @@ static void Step_Forward(struct g_layer_t *self) {
 
         g_neuron_t *neuron = self->neurons.ptr;
 
+        G_PROFILE_BEGIN(t0);
+
         for (int j = 0; j < P; ++j) {
             neuron[j].Step_Forward_Z(&neuron[j]);
         }
 
+        G_PROFILE_END(t0, self->l_id, G_PROFILE_FORWARD_Z);
+        G_PROFILE_BEGIN(t1);
+
         if (self->page->af_type == SOFTMAX) {
             const float *Z = self->page->z.ptr;
 
@@ -187,12 +410,16 @@ static void Step_Forward(struct g_layer_t *self) {
         for (int j = 0; j < P; ++j) {
             neuron[j].Step_Forward_Y(&neuron[j]);
         }
+
+        G_PROFILE_END(t1, self->l_id, G_PROFILE_ACTIVATION);
     }
 }
 
 static void Step_Errors(struct g_layer_t *self, struct g_layer_t *next) {
     if ((self != NULL) && self->_is_safe) {
         if ((self != next) && (next != NULL) && next->_is_safe) {
+            G_PROFILE_BEGIN(t0);
+
             const int P0 = self->page->de_dy.len;
             const int P1 = next->page->de_dy.len;
 
@@ -200,6 +427,8 @@ static void Step_Errors(struct g_layer_t *self, struct g_layer_t *next) {
             float *dE_dy_k1 = next->page->de_dy.ptr;
             float *dy_dz_k1 = next->page->dy_dz.ptr;
 
+            float err = 0.0f;
+
             for (int j = 0; j < P0; ++j) {
                 dE_dy_k0[j] = 0.0f;
 
@@ -208,21 +437,23 @@ static void Step_Errors(struct g_layer_t *self, struct g_layer_t *next) {
 
                     dE_dy_k0[j] += dE_dy_k1[i] * dy_dz_k1[i] * w_k1_ji;
                 }
+
+                err += dE_dy_k0[j] * dE_dy_k0[j];
             }
+
+            self->page->err = err / P0;
+
+            G_PROFILE_END(t0, self->l_id, G_PROFILE_ERRORS);
         }
     }
 }
 
 static void Step_Adjust(struct g_layer_t *self) {
     if ((self != NULL) && self->_is_safe) {
-        const int P = self->page->de_dy.len;
+        G_PROFILE_BEGIN(t0);
 
-        float mse = 0.0f;
-        for (int j = 0; j < P; ++j) {
-            float de_dy = self->page->de_dy.ptr[j];
-            mse += de_dy * de_dy;
-        }
-        mse /= P;
+        // computed by the error pass
+        const float mse = self->page->err;
 
         // adjust learning rate
         self->page->lr += (self->page->mse > mse) ? -0.0001f : +0.0005f;
@@ -232,30 +463,59 @@ static void Step_Adjust(struct g_layer_t *self) {
 
         // update mean squared error
         self->page->mse = mse;
+
+        G_PROFILE_END(t0, self->l_id, G_PROFILE_ADJUST);
+    }
+}
+
+static bool Set_Optimizer(struct g_layer_t *self, g_optim_type_t op_type, g_optim_args_t op_args) {
+    bool rvalue = (self != NULL) && self->_is_safe;
+
+    if (rvalue) {
+        g_page_t *page = self->page;
+
+        page->op_type          = op_type;
+        page->op_args          = op_args;
+        page->op_args.beta_1_t = 1.0f;
+        page->op_args.beta_2_t = 1.0f;
+
+        rvalue = __op_link(page);
+
+        // fresh moments for the new update rule
+        if (rvalue && (page->m.ptr != NULL)) {
+            memset(page->m.ptr, 0, sizeof(float) * page->m.row * page->m.col);
+        }
+
+        if (rvalue && (page->v.ptr != NULL)) {
+            memset(page->v.ptr, 0, sizeof(float) * page->v.row * page->v.col);
+        }
     }
+
+    return rvalue;
 }
 
 static void Step_Backward(struct g_layer_t *self) {
     if ((self != NULL) && self->_is_safe) {
-        float *dE_dy = self->page->de_dy.ptr;
-        float *dy_dz = self->page->dy_dz.ptr;
+        g_page_t *page = self->page;
 
-        const int   P  = self->page->y.len; // number of neurons
-        const int   N  = self->page->x.len; // number of inputs (all neurons)
-        const float lr = self->page->lr;    // learning rate
+        float *dE_dy = page->de_dy.ptr;
+        float *dy_dz = page->dy_dz.ptr;
 
-        for (int j = 0; j < P; ++j) {
-            const float dE_dz_j = dE_dy[j] * dy_dz[j];
+        const int P = page->y.len; // number of neurons
 
-            float *Xj = &self->page->x.ptr[0];
-            float *Wj = f_matrix_row(&self->page->w, j);
+        G_PROFILE_BEGIN(t0);
 
-            for (int i = 0; i < N; ++i) {
-                Wj[i] -= lr * dE_dz_j * Xj[i];
-            }
+        // one more step for the bias corrections
+        page->op_args.beta_1_t *= page->op_args.beta_1;
+        page->op_args.beta_2_t *= page->op_args.beta_2;
 
-            Wj[N] -= lr * dE_dz_j;
+        for (int j = 0; j < P; ++j) {
+            const float dE_dz_j = dE_dy[j] * dy_dz[j];
+
+            page->op_call(page, j, dE_dz_j);
         }
+
+        G_PROFILE_END(t0, self->l_id, G_PROFILE_BACKWARD);
     }
 }
 
@@ -271,6 +531,7 @@ void g_layer_link(g_layer_t *self) {
         self->Step_Forward  = Step_Forward;
         self->Step_Errors   = Step_Errors;
         self->Step_Adjust   = Step_Adjust;
+        self->Set_Optimizer = Set_Optimizer;
         self->Step_Backward = Step_Backward;
     }
 }
@@ -10,6 +10,7 @@
 #define G_LAYER_H
 
 #include "g_neuron.h" // g_neuron_t
+#include "g_random.h" // g_random_t
 
 // -----------------------------------------------------------------------------
 
@@ -22,10 +23,11 @@ typedef struct g_layer_t {
     // functions
     bool (*Create)(struct g_layer_t *self, g_page_t *page, int l_id);
     void (*Destroy)(struct g_layer_t *self);
-    void (*Init_Weights)(struct g_layer_t *self, float bias);
+    void (*Init_Weights)(struct g_layer_t *self, float bias, const g_random_t *random, int threads);
     void (*Step_Forward)(struct g_layer_t *self);
     void (*Step_Errors)(struct g_layer_t *self, struct g_layer_t *next);
     void (*Step_Adjust)(struct g_layer_t *self);
+    bool (*Set_Optimizer)(struct g_layer_t *self, g_optim_type_t op_type, g_optim_args_t op_args);
     void (*Step_Backward)(struct g_layer_t *self);
 
     // intrinsic
@@ -9,10 +9,11 @@
 #include "g_network.h"
 
 #include <assert.h> // assert
+#include <math.h>   // fmaxf, fminf, logf
 #include <stdlib.h> // NULL, calloc, free
-#include <time.h>   // time
 
-#include "g_random.h" // g_random_seed
+#include "g_profile.h" // G_PROFILE_BEGIN, G_PROFILE_END
+#include "g_random.h"  // g_random_init, g_random_jump
 
 // -----------------------------------------------------------------------------
 
@@ -22,11 +23,139 @@ static void __unsafe_reset(g_network_t *self) {
     self->pages      = NULL;
     self->layers.ptr = NULL;
     self->layers.len = 0;
+    self->loss       = 0.0f;
+    self->loss_type  = MSE;
+    self->loss_call  = NULL;
 
     // intrinsic
     self->_is_safe = false;
 }
 
+// Loss kernels: one pass over the output page writes dE/dY and accumulates
+// the loss and the mean squared dE/dY (page->err, used by Step_Adjust).
+
+#define G_LOSS_EPSILON 1e-7f // keeps logarithms and divisions finite
+
+static float __loss_mse(g_page_t *page, f_vector_t *targets) {
+    const int    P = page->y.len;
+    const float *Y = page->y.ptr;
+    const float *T = targets->ptr;
+    float       *G = page->de_dy.ptr;
+
+    // MSE: we treat each output of the last layer as independent
+    // from the other outputs. This simplification allows us to
+    // calculate the error for each output independently, without
+    // scaling it by the total number of outputs.
+
+    float loss = 0.0f;
+    float err  = 0.0f;
+
+    for (int j = 0; j < P; ++j) {
+        const float e = Y[j] - T[j];
+
+        G[j] = 2.0f * e;
+
+        loss += e * e;
+        err += G[j] * G[j];
+    }
+
+    page->err = err / P;
+
+    return loss / P;
+}
+
+static float __loss_bce(g_page_t *page, f_vector_t *targets) {
+    const int    P = page->y.len;
+    const float *Y = page->y.ptr;
+    const float *T = targets->ptr;
+    float       *G = page->de_dy.ptr;
+
+    float loss = 0.0f;
+    float err  = 0.0f;
+
+    for (int j = 0; j < P; ++j) {
+        const float y = fminf(fmaxf(Y[j], G_LOSS_EPSILON), 1.0f - G_LOSS_EPSILON);
+
+        G[j] = (y - T[j]) / (y * (1.0f - y));
+
+        loss -= T[j] * logf(y) + (1.0f - T[j]) * logf(1.0f - y);
+        err += G[j] * G[j];
+    }
+
+    page->err = err / P;
+
+    return loss / P;
+}
+
+static float __loss_cce(g_page_t *page, f_vector_t *targets) {
+    const int    P = page->y.len;
+    const float *Y = page->y.ptr;
+    const float *T = targets->ptr;
+    float       *G = page->de_dy.ptr;
+
+    float loss = 0.0f;
+    float err  = 0.0f;
+
+    for (int j = 0; j < P; ++j) {
+        const float y = fmaxf(Y[j], G_LOSS_EPSILON);
+
+        G[j] = -T[j] / y;
+
+        loss -= T[j] * logf(y);
+        err += G[j] * G[j];
+    }
+
+    page->err = err / P;
+
+    return loss;
+}
+
+// Sigmoid + BCE and softmax + CCE: dE/dZ reduces to Y - T, stored as dE/dY
+// with a unit dY/dZ so that the layers need no special case.
+static float __loss_fused(g_page_t *page, f_vector_t *targets, bool categorical) {
+    const int    P = page->y.len;
+    const float *Y = page->y.ptr;
+    const float *T = targets->ptr;
+    float       *G = page->de_dy.ptr;
+    float       *D = page->dy_dz.ptr;
+
+    float loss = 0.0f;
+    float err  = 0.0f;
+
+    for (int j = 0; j < P; ++j) {
+        const float y = fminf(fmaxf(Y[j], G_LOSS_EPSILON), 1.0f - G_LOSS_EPSILON);
+
+        G[j] = Y[j] - T[j];
+        D[j] = 1.0f;
+
+        loss -= categorical ? T[j] * logf(y) : T[j] * logf(y) + (1.0f - T[j]) * logf(1.0f - y);
+        err += G[j] * G[j];
+    }
+
+    page->err = err / P;
+
+    return categorical ? loss : loss / P;
+}
+
+static float __loss_sigmoid_bce(g_page_t *page, f_vector_t *targets) {
+    return __loss_fused(page, targets, false);
+}
+
+static float __loss_softmax_cce(g_page_t *page, f_vector_t *targets) {
+    return __loss_fused(page, targets, true);
+}
+
+static g_loss_call_t __loss_link(g_loss_type_t loss_type, g_act_func_type_t af_type) {
+    switch (loss_type) {
+        case BCE:
+            return (af_type == SIGMOID) ? __loss_sigmoid_bce : __loss_bce;
+        case CCE:
+            return (af_type == SOFTMAX) ? __loss_softmax_cce : __loss_cce;
+        default:
+            return __loss_mse;
+    }
+}
+
 static bool Create(struct g_network_t *self, g_pages_t *pages) {
     bool rvalue = self != NULL;
 
@@ -71,7 +200,8 @@ static bool Create(struct g_network_t *self, g_pages_t *pages) {
         self->_is_safe = rvalue;
 
         if (rvalue) {
-            self->pages = pages;
+            self->pages     = pages;
+            self->loss_call = __loss_link(self->loss_type, pages->ptr[L - 1].af_type);
         } else {
             self->Destroy(self);
         }
@@ -100,16 +230,22 @@ static void Destroy(struct g_network_t *self) {
     }
 }
 
-static void Init_Weights(struct g_network_t *self, float bias) {
-    if ((self != NULL) && self->_is_safe) {
-        g_random_seed(time(NULL));
+static void Init_Weights(struct g_network_t *self, float bias, uint32_t seed, int threads) {
+    if ((self != NULL) && self->_is_safe && (threads > 0)) {
+        g_random_t random;
+        g_random_init(&random, seed, 0);
 
         const int L = self->layers.len;
 
         for (int k = 0; k < L; ++k) {
             g_layer_t *layer = &self->layers.ptr[k];
 
-            layer->Init_Weights(layer, bias);
+            layer->Init_Weights(layer, bias, &random, threads);
+
+            // the layer used streams [0, threads), the next one starts after
+            for (int t = 0; t < threads; ++t) {
+                g_random_jump(&random);
+            }
         }
     }
 }
@@ -136,17 +272,11 @@ static void Step_Errors(struct g_network_t *self, f_vector_t *actual_outputs) {
             const int P = layer_L->page->y.len;
 
             if (P == actual_outputs->len) {
-                float *Y_L     = layer_L->page->y.ptr;
-                float *dE_dy_L = layer_L->page->de_dy.ptr;
+                G_PROFILE_BEGIN(t0);
 
-                // MSE: we treat each output of the last layer as independent
-                // from the other outputs. This simplification allows us to
-                // calculate the error for each output independently, without
-                // scaling it by the total number of outputs.
+                self->loss = self->loss_call(layer_L->page, actual_outputs);
 
-                for (int j = 0; j < P; ++j) {
-                    dE_dy_L[j] = 2.0f * (Y_L[j] - actual_outputs->ptr[j]);
-                }
+                G_PROFILE_END(t0, layer_L->l_id, G_PROFILE_ERRORS);
 
                 for (int k = L - 2; k >= 0; --k) {
                     g_layer_t *layer_k0 = &self->layers.ptr[k + 0];
@@ -171,6 +301,39 @@ static void Step_Adjust(struct g_network_t *self) {
     }
 }
 
+static bool Set_Optimizer(struct g_network_t *self, g_optim_type_t op_type, g_optim_args_t op_args) {
+    bool rvalue = (self != NULL) && self->_is_safe;
+
+    if (rvalue) {
+        const int L = self->layers.len;
+
+        for (int k = 0; k < L; ++k) {
+            g_layer_t *layer_k = &self->layers.ptr[k];
+
+            rvalue = layer_k->Set_Optimizer(layer_k, op_type, op_args) && rvalue;
+        }
+    }
+
+    return rvalue;
+}
+
+static bool Set_Loss(struct g_network_t *self, g_loss_type_t loss_type) {
+    bool rvalue = (self != NULL) && self->_is_safe;
+
+    if (rvalue) {
+        rvalue = (loss_type == MSE) || (loss_type == BCE) || (loss_type == CCE);
+    }
+
+    if (rvalue) {
+        const int L = self->layers.len;
+
+        self->loss_type = loss_type;
+        self->loss_call = __loss_link(loss_type, self->layers.ptr[L - 1].page->af_type);
+    }
+
+    return rvalue;
+}
+
 static void Step_Backward(struct g_network_t *self) {
     if ((self != NULL) && self->_is_safe) {
         const int L = self->layers.len;
@@ -216,6 +379,8 @@ void g_network_link(g_network_t *self) {
         self->Step_Forward  = Step_Forward;
         self->Step_Errors   = Step_Errors;
         self->Step_Adjust   = Step_Adjust;
+        self->Set_Optimizer = Set_Optimizer;
+        self->Set_Loss      = Set_Loss;
         self->Step_Backward = Step_Backward;
     }
 }
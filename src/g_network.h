@@ -13,18 +13,34 @@
 
 // -----------------------------------------------------------------------------
 
+typedef enum g_loss_type_t {
+    MSE, // mean squared error (regression)
+    BCE, // binary cross-entropy (independent outputs)
+    CCE  // categorical cross-entropy (one-hot targets)
+} g_loss_type_t;
+
+// fills dE/dY (and dY/dZ when fused) of the output page, returns the loss
+typedef float (*g_loss_call_t)(g_page_t *page, f_vector_t *targets);
+
+// -----------------------------------------------------------------------------
+
 typedef struct g_network_t {
     // variables
-    g_pages_t *pages;
-    g_layers_t layers;
+    g_pages_t    *pages;
+    g_layers_t    layers;
+    float         loss; // loss of the last Step_Errors
+    g_loss_type_t loss_type;
+    g_loss_call_t loss_call;
 
     // functions
     bool (*Create)(struct g_network_t *self, g_pages_t *pages);
     void (*Destroy)(struct g_network_t *self);
-    void (*Init_Weights)(struct g_network_t *self, float bias);
+    void (*Init_Weights)(struct g_network_t *self, float bias, uint32_t seed, int threads);
     void (*Step_Forward)(struct g_network_t *self);
     void (*Step_Errors)(struct g_network_t *self, f_vector_t *actual_outputs);
     void (*Step_Adjust)(struct g_network_t *self);
+    bool (*Set_Optimizer)(struct g_network_t *self, g_optim_type_t op_type, g_optim_args_t op_args);
+    bool (*Set_Loss)(struct g_network_t *self, g_loss_type_t loss_type);
     void (*Step_Backward)(struct g_network_t *self);
 
     // intrinsic
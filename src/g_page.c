@@ -9,7 +9,9 @@
 #include "g_page.h"
 
 #include <stdbool.h> // bool
-#include <stddef.h>  // NULL
+#include <stddef.h>  // NULL, size_t
+#include <stdlib.h>  // calloc, free
+#include <string.h>  // memcpy
 
 // -----------------------------------------------------------------------------
 
@@ -66,6 +68,23 @@ void g_page_reset(g_page_t *page) {
         page->de_dy.len = 0;
         page->lr        = 0.0f;
         page->mse       = 0.0f;
+        page->err       = 0.0f;
+
+        // optimizer
+        page->m.ptr = NULL;
+        page->m.row = 0;
+        page->m.col = 0;
+        page->v.ptr = NULL;
+        page->v.row = 0;
+        page->v.col = 0;
+
+        page->op_type          = SGD;
+        page->op_call          = NULL;
+        page->op_args.beta_1   = 0.0f;
+        page->op_args.beta_2   = 0.0f;
+        page->op_args.epsilon  = 0.0f;
+        page->op_args.beta_1_t = 1.0f;
+        page->op_args.beta_2_t = 1.0f;
 
         page->af_type     = UNKNOWN;
         page->af_call     = NULL;
@@ -74,5 +93,78 @@ void g_page_reset(g_page_t *page) {
     }
 }
 
+bool g_pages_clone(g_pages_t *dst, g_pages_t *src) {
+    if ((dst == NULL) || (src == NULL) || (src->ptr == NULL) || (src->len <= 0)) {
+        return false;
+    }
+
+    const int L = src->len;
+
+    // one block: the pages, then their private vectors
+    size_t floats = (size_t)src->ptr[0].x.len;
+    for (int k = 0; k < L; ++k) {
+        const g_page_t *page = &src->ptr[k];
+
+        floats += (size_t)page->z.len + page->y.len + page->dy_dz.len + page->de_dy.len;
+        floats += (size_t)page->af_args.len + 2; // softmax keeps two values
+    }
+
+    g_page_t *pages = calloc(1, L * sizeof(g_page_t) + floats * sizeof(float));
+    if (pages == NULL) {
+        return false;
+    }
+
+    float *ptr = (float *)(pages + L);
+
+    for (int k = 0; k < L; ++k) {
+        g_page_t *page = &pages[k];
+
+        *page = src->ptr[k];
+
+        // layers are chained: the outputs of k are the inputs of k + 1
+        if (k == 0) {
+            page->x.ptr = ptr;
+            ptr += page->x.len;
+        } else {
+            page->x.ptr = pages[k - 1].y.ptr;
+        }
+
+        page->z.ptr = ptr;
+        ptr += page->z.len;
+        page->y.ptr = ptr;
+        ptr += page->y.len;
+        page->dy_dz.ptr = ptr;
+        ptr += page->dy_dz.len;
+        page->de_dy.ptr = ptr;
+        ptr += page->de_dy.len;
+
+        if (page->af_args.ptr != NULL) {
+            memcpy(ptr, page->af_args.ptr, page->af_args.len * sizeof(float));
+            page->af_args.ptr = ptr;
+        }
+        ptr += page->af_args.len + 2;
+
+        // weights are shared, optimizer state is not
+        page->m.ptr   = NULL;
+        page->v.ptr   = NULL;
+        page->op_type = SGD;
+        page->op_call = NULL;
+    }
+
+    dst->ptr = pages;
+    dst->len = L;
+
+    return true;
+}
+
+void g_pages_free(g_pages_t *pages) {
+    if (pages != NULL) {
+        free(pages->ptr); // g_pages_clone allocates a single block
+
+        pages->ptr = NULL;
+        pages->len = 0;
+    }
+}
+
 // -----------------------------------------------------------------------------
 // End of File
@@ -9,6 +9,8 @@
 #ifndef G_PAGE_H
 #define G_PAGE_H
 
+#include <stdbool.h> // bool
+
 // -----------------------------------------------------------------------------
 
 typedef struct f_vector_t {
@@ -52,10 +54,20 @@ typedef enum g_act_func_type_t {
     UNKNOWN = -1
 } g_act_func_type_t;
 
+typedef enum g_optim_type_t {
+    SGD,      // plain stochastic gradient descent
+    MOMENTUM, // heavy-ball momentum (M)
+    NESTEROV, // Nesterov accelerated gradient (M)
+    RMSPROP,  // running average of squared gradients (V)
+    ADAM      // bias-corrected first and second moments (M, V)
+} g_optim_type_t;
+
 struct g_page_t; // forward declaration
 
 typedef void (*g_act_func_call_t)(struct g_page_t *page, int n_id);
 
+typedef void (*g_optim_call_t)(struct g_page_t *page, int n_id, float de_dz);
+
 // -----------------------------------------------------------------------------
 
 typedef struct g_act_func_args_t {
@@ -63,6 +75,14 @@ typedef struct g_act_func_args_t {
     int    len;
 } g_act_func_args_t;
 
+typedef struct g_optim_args_t {
+    float beta_1;   // decay of the first moment (momentum)
+    float beta_2;   // decay of the second moment
+    float epsilon;  // denominator guard
+    float beta_1_t; // beta_1^t, Adam bias correction
+    float beta_2_t; // beta_2^t, Adam bias correction
+} g_optim_args_t;
+
 // -----------------------------------------------------------------------------
 
 typedef struct g_page_t {
@@ -77,7 +97,15 @@ typedef struct g_page_t {
     f_vector_t dy_dz; // dY/dZ[layer]
     f_vector_t de_dy; // dE/dY[layer]
     float      lr;    // learning rate
-    float      mse;   // mean squared error
+    float      mse;   // mean squared error (previous sample)
+    float      err;   // mean squared dE/dY, accumulated by the error pass
+
+    // optimizer
+    f_matrix_t     m; // first moment, shaped as w (NULL if unused)
+    f_matrix_t     v; // second moment, shaped as w (NULL if unused)
+    g_optim_type_t op_type;
+    g_optim_call_t op_call;
+    g_optim_args_t op_args;
 
     // activation function
     g_act_func_type_t af_type;
@@ -94,6 +122,11 @@ typedef struct g_pages_t {
 
 extern void g_page_reset(g_page_t *page);
 
+// private x, z, y, dY/dZ, dE/dY and activation arguments, shared weights
+extern bool g_pages_clone(g_pages_t *dst, g_pages_t *src);
+
+extern void g_pages_free(g_pages_t *pages);
+
 #endif // G_PAGE_H
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,439 @@
+// -----------------------------------------------------------------------------
+// @file g_profile.c
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#include "g_profile.h"
+#include "g_trace.h" // g_trace_enabled, g_trace_record
+
+#ifdef G_PROFILE
+
+#include <stdatomic.h> // atomic_compare_exchange_weak, atomic_exchange, atomic_load, _Atomic
+#include <stdio.h>     // printf
+#include <stdlib.h>    // calloc, free
+#include <string.h>    // memset, strerror
+#include <time.h>      // clock_gettime, CLOCK_MONOTONIC
+
+#ifdef __linux__
+#include <errno.h>            // errno, ENOSYS
+#include <linux/perf_event.h> // perf_event_attr, PERF_*
+#include <sys/ioctl.h>        // ioctl
+#include <sys/syscall.h>      // SYS_perf_event_open
+#include <unistd.h>           // close, read, syscall
+#endif
+
+// -----------------------------------------------------------------------------
+
+#define G_PROFILE_ROWS (G_PROFILE_LAYERS + 1) // layers, then reader and writer
+
+typedef struct g_profile_block_t {
+    uint64_t cycles[G_PROFILE_ROWS][G_PROFILE_PHASES];
+    uint64_t calls[G_PROFILE_ROWS][G_PROFILE_PHASES];
+    uint64_t events[G_PROFILE_ROWS][G_PROFILE_PHASES][G_PROFILE_EVENTS];
+
+    // counter group of the owning thread, the leader is -1 when not counting
+    int fds[G_PROFILE_EVENTS];
+    int slot[G_PROFILE_EVENTS]; // position in a group read, -1 when not opened
+    int group;
+
+    struct g_profile_block_t *next;
+} g_profile_block_t;
+
+bool g_profile_enabled  = false;
+bool g_profile_counting = false;
+
+static _Atomic(g_profile_block_t *) _blocks = NULL;
+
+static _Thread_local g_profile_block_t *_block = NULL;
+
+static uint64_t _start_cycles;
+static double   _start_seconds;
+
+static const char *_phase_names[G_PROFILE_PHASES] = {
+    "forward Z", "activation", "errors", "adjust", "backward", "reader", "writer"};
+
+static const char *_event_names[G_PROFILE_EVENTS] = {"cycles", "instructions", "L1D misses", "LLC misses", "branch misses"};
+
+// -----------------------------------------------------------------------------
+
+static double __seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+#ifdef __linux__
+static int __open_event(uint32_t type, uint64_t config, int group) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+
+    attr.size           = sizeof(attr);
+    attr.type           = type;
+    attr.config         = config;
+    attr.disabled       = (group < 0) ? 1 : 0; // the leader starts the whole group
+    attr.exclude_kernel = 1;                   // user space only, allowed up to perf_event_paranoid 2
+    attr.exclude_hv     = 1;
+    attr.read_format    = PERF_FORMAT_GROUP;
+
+    // calling thread, any CPU
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+}
+#endif
+
+static void __close_group(g_profile_block_t *block) {
+    for (int e = 0; e < G_PROFILE_EVENTS; ++e) {
+#ifdef __linux__
+        if (block->fds[e] >= 0) {
+            close(block->fds[e]);
+        }
+#endif
+        block->fds[e]  = -1;
+        block->slot[e] = -1;
+    }
+
+    block->group = -1;
+}
+
+// counter group of the calling thread; events the PMU lacks are skipped, errno when none opens
+static int __open_group(g_profile_block_t *block) {
+    __close_group(block);
+
+#ifdef __linux__
+    static const uint32_t types[G_PROFILE_EVENTS] = {
+        PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE};
+
+    static const uint64_t configs[G_PROFILE_EVENTS] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+        PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+        PERF_COUNT_HW_BRANCH_MISSES};
+
+    int error  = 0;
+    int opened = 0;
+
+    for (int e = 0; e < G_PROFILE_EVENTS; ++e) {
+        const int fd = __open_event(types[e], configs[e], block->group);
+
+        if (fd < 0) {
+            if (error == 0) {
+                error = errno;
+            }
+            continue;
+        }
+
+        if (block->group < 0) {
+            block->group = fd;
+        }
+
+        block->fds[e]  = fd;
+        block->slot[e] = opened++;
+    }
+
+    if (block->group < 0) {
+        return error;
+    }
+
+    if (ioctl(block->group, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) < 0) {
+        error = errno;
+        __close_group(block);
+        return error;
+    }
+
+    return 0;
+#else
+    return ENOSYS;
+#endif
+}
+
+static g_profile_block_t *__register(void) {
+    g_profile_block_t *block = calloc(1, sizeof(g_profile_block_t));
+
+    if (block != NULL) {
+        block->group = -1;
+        for (int e = 0; e < G_PROFILE_EVENTS; ++e) {
+            block->fds[e]  = -1;
+            block->slot[e] = -1;
+        }
+
+        if (g_profile_counting) {
+            __open_group(block);
+        }
+
+        // lock-free push, blocks are only freed by g_profile_release
+        block->next = atomic_load(&_blocks);
+        while (!atomic_compare_exchange_weak(&_blocks, &block->next, block)) {
+        }
+    }
+
+    return block;
+}
+
+static inline g_profile_block_t *__block(void) {
+    if (_block == NULL) {
+        _block = __register();
+    }
+
+    return _block;
+}
+
+void g_profile_read(g_profile_mark_t *mark) {
+    memset(mark->events, 0, sizeof(mark->events));
+
+#ifdef __linux__
+    g_profile_block_t *block = __block();
+
+    if (block == NULL || block->group < 0) {
+        return;
+    }
+
+    // PERF_FORMAT_GROUP: number of events, then their values in opening order
+    uint64_t values[1 + G_PROFILE_EVENTS];
+
+    if (read(block->group, values, sizeof(values)) < (ssize_t)sizeof(uint64_t)) {
+        return;
+    }
+
+    for (int e = 0; e < G_PROFILE_EVENTS; ++e) {
+        if (block->slot[e] >= 0 && (uint64_t)block->slot[e] < values[0]) {
+            mark->events[e] = values[1 + block->slot[e]];
+        }
+    }
+#endif
+}
+
+void g_profile_add(int layer, g_profile_phase_t phase, const g_profile_mark_t *mark) {
+    const uint64_t now    = g_profile_now();
+    const uint64_t cycles = now - mark->cycles;
+
+    if (g_trace_enabled) {
+        g_trace_record(_phase_names[phase], (layer < 0) ? "io" : "layer", layer, mark->cycles, now);
+    }
+
+    g_profile_block_t *block = __block();
+
+    if (block == NULL) {
+        return;
+    }
+
+    const int row = (layer < 0) ? G_PROFILE_LAYERS : (layer < G_PROFILE_LAYERS) ? layer : G_PROFILE_LAYERS - 1;
+
+    block->cycles[row][phase] += cycles;
+    block->calls[row][phase]++;
+
+    if (g_profile_counting && block->group >= 0) {
+        g_profile_mark_t end;
+        g_profile_read(&end);
+
+        for (int e = 0; e < G_PROFILE_EVENTS; ++e) {
+            block->events[row][phase][e] += end.events[e] - mark->events[e];
+        }
+    }
+}
+
+bool g_profile_enable(void) {
+    _start_cycles  = g_profile_now();
+    _start_seconds = __seconds();
+
+    g_profile_enabled = true;
+
+    return true;
+}
+
+bool g_profile_enable_counters(void) {
+    g_profile_block_t *block = __block();
+
+    if (block == NULL) {
+        return false;
+    }
+
+    const int error = __open_group(block);
+
+    if (error != 0) {
+        printf("[ALERT] Hardware counters unavailable (perf_event_open: %s), timing only\n", strerror(error));
+        return false;
+    }
+
+    int missing = 0;
+    for (int e = 0; e < G_PROFILE_EVENTS; ++e) {
+        if (block->slot[e] < 0) {
+            printf("[ALERT] Hardware counter '%s' unavailable, not reported\n", _event_names[e]);
+            missing++;
+        }
+    }
+
+    // threads started from now on open their own group on first use
+    g_profile_counting = true;
+
+    return missing < G_PROFILE_EVENTS;
+}
+
+static void __report_counters(uint64_t events[G_PROFILE_ROWS][G_PROFILE_PHASES][G_PROFILE_EVENTS],
+                              uint64_t calls[G_PROFILE_ROWS][G_PROFILE_PHASES]) {
+    printf("[INFO] Counters (user space, per 1k instructions for misses):\n");
+    printf("  %-7s %-11s %13s %13s %7s %10s %10s %10s\n",
+           "layer", "phase", "cycles/call", "instr/call", "IPC", "L1D/1k", "LLC/1k", "branch/1k");
+
+    for (int r = 0; r < G_PROFILE_ROWS; ++r) {
+        for (int p = 0; p < G_PROFILE_PHASES; ++p) {
+            const uint64_t *counts = events[r][p];
+
+            if (calls[r][p] == 0 || counts[G_PROFILE_INSTRUCTIONS] == 0) {
+                continue;
+            }
+
+            if (r < G_PROFILE_LAYERS) {
+                printf("  %-7d", r);
+            } else {
+                printf("  %-7s", "I/O");
+            }
+
+            const double instructions = (double)counts[G_PROFILE_INSTRUCTIONS];
+
+            printf(" %-11s %13.1f %13.1f %7.2f %10.2f %10.3f %10.2f\n",
+                   _phase_names[p],
+                   (double)counts[G_PROFILE_CYCLES] / calls[r][p],
+                   instructions / calls[r][p],
+                   (counts[G_PROFILE_CYCLES] > 0) ? instructions / counts[G_PROFILE_CYCLES] : 0.0,
+                   1e3 * counts[G_PROFILE_L1D_MISSES] / instructions,
+                   1e3 * counts[G_PROFILE_LLC_MISSES] / instructions,
+                   1e3 * counts[G_PROFILE_BRANCH_MISSES] / instructions);
+        }
+    }
+}
+
+void g_profile_report(double seconds) {
+    if (!g_profile_enabled) {
+        return;
+    }
+
+    // counter rate over the run, 1 GHz when it is nanoseconds already
+    const double elapsed = __seconds() - _start_seconds;
+    const double rate    = (elapsed > 0.0) ? (double)(g_profile_now() - _start_cycles) / elapsed : 1e9;
+
+    uint64_t cycles[G_PROFILE_ROWS][G_PROFILE_PHASES] = {{0}};
+    uint64_t calls[G_PROFILE_ROWS][G_PROFILE_PHASES]  = {{0}};
+
+    static uint64_t events[G_PROFILE_ROWS][G_PROFILE_PHASES][G_PROFILE_EVENTS];
+    memset(events, 0, sizeof(events));
+
+    for (g_profile_block_t *block = atomic_load(&_blocks); block != NULL; block = block->next) {
+        for (int r = 0; r < G_PROFILE_ROWS; ++r) {
+            for (int p = 0; p < G_PROFILE_PHASES; ++p) {
+                cycles[r][p] += block->cycles[r][p];
+                calls[r][p] += block->calls[r][p];
+
+                for (int e = 0; e < G_PROFILE_EVENTS; ++e) {
+                    events[r][p][e] += block->events[r][p][e];
+                }
+            }
+        }
+    }
+
+    uint64_t total = 0;
+    for (int r = 0; r < G_PROFILE_ROWS; ++r) {
+        for (int p = 0; p < G_PROFILE_PHASES; ++p) {
+            total += cycles[r][p];
+        }
+    }
+
+    const uint64_t samples = calls[0][G_PROFILE_FORWARD_Z];
+
+    printf("[INFO] Profile: %llu forward passes in %.3f s, %.0f samples/s (counter at %.3f GHz)\n",
+           (unsigned long long)samples,
+           seconds,
+           (seconds > 0.0) ? (double)samples / seconds : 0.0,
+           rate * 1e-9);
+
+    printf("  %-7s", "layer");
+    for (int p = 0; p < G_PROFILE_PHASES; ++p) {
+        printf(" %11s", _phase_names[p]);
+    }
+    printf(" %11s %6s\n", "total ms", "share");
+
+    for (int r = 0; r < G_PROFILE_ROWS; ++r) {
+        uint64_t row = 0;
+        for (int p = 0; p < G_PROFILE_PHASES; ++p) {
+            row += cycles[r][p];
+        }
+
+        if (row == 0) {
+            continue;
+        }
+
+        if (r < G_PROFILE_LAYERS) {
+            printf("  %-7d", r);
+        } else {
+            printf("  %-7s", "I/O");
+        }
+
+        // milliseconds per phase
+        for (int p = 0; p < G_PROFILE_PHASES; ++p) {
+            if (calls[r][p] > 0) {
+                printf(" %11.3f", 1e3 * cycles[r][p] / rate);
+            } else {
+                printf(" %11s", "-");
+            }
+        }
+
+        printf(" %11.3f %5.1f%%\n", 1e3 * row / rate, (total > 0) ? 100.0 * row / total : 0.0);
+    }
+
+    // per sample, the figure that compares across runs
+    if (samples > 0) {
+        printf("  %-7s", "ns/smp");
+        for (int p = 0; p < G_PROFILE_PHASES; ++p) {
+            uint64_t column = 0;
+            for (int r = 0; r < G_PROFILE_ROWS; ++r) {
+                column += cycles[r][p];
+            }
+            printf(" %11.1f", 1e9 * column / rate / samples);
+        }
+        printf(" %11.1f\n", 1e9 * total / rate / samples);
+    }
+
+    if (g_profile_counting) {
+        __report_counters(events, calls);
+    }
+}
+
+void g_profile_release(void) {
+    g_profile_block_t *block = atomic_exchange(&_blocks, NULL);
+
+    while (block != NULL) {
+        g_profile_block_t *next = block->next;
+        __close_group(block);
+        free(block);
+        block = next;
+    }
+
+    _block = NULL;
+
+    g_profile_enabled  = false;
+    g_profile_counting = false;
+}
+
+#else
+
+bool g_profile_enable(void) {
+    return false;
+}
+
+bool g_profile_enable_counters(void) {
+    return false;
+}
+
+void g_profile_report(double seconds) {
+    (void)seconds;
+}
+
+void g_profile_release(void) {
+}
+
+#endif // G_PROFILE
+
+// -----------------------------------------------------------------------------
+// End of File
@@ -0,0 +1,131 @@
+// -----------------------------------------------------------------------------
+// @file g_profile.h
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#ifndef G_PROFILE_H
+#define G_PROFILE_H
+
+#include <stdbool.h> // bool
+#include <stdint.h>  // uint64_t
+
+// -----------------------------------------------------------------------------
+/*
+ * Per-layer, per-phase timing. Built only with G_PROFILE defined; otherwise
+ * the macros expand to nothing and no code is left in the kernels. When
+ * built, timing still runs only after g_profile_enable, at the cost of one
+ * branch per phase otherwise.
+ *
+ * Every thread accumulates cycles (TSC on x86-64, nanoseconds elsewhere) in
+ * its own block, so workers never share a cache line; the report sums the
+ * blocks and converts cycles with a rate measured since g_profile_enable.
+ *
+ * Optionally (g_profile_enable_counters, Linux) every thread also opens a
+ * perf_event_open group of user-space hardware counters, read at both ends
+ * of each phase. Each read is a system call, so phases run slower, but the
+ * counts stay attributed to the right layer and phase. Where the counters
+ * are not available, as in most containers, only the timing is kept.
+ */
+
+typedef enum g_profile_phase_t {
+    G_PROFILE_FORWARD_Z,  // weighted sums
+    G_PROFILE_ACTIVATION, // activation and its derivative
+    G_PROFILE_ERRORS,     // loss (output layer) and dE/dY
+    G_PROFILE_ADJUST,     // learning rate adjustment
+    G_PROFILE_BACKWARD,   // weight updates
+    G_PROFILE_READER,     // samples read or bound (layer G_PROFILE_IO)
+    G_PROFILE_WRITER,     // outputs and weights written (layer G_PROFILE_IO)
+    G_PROFILE_PHASES
+} g_profile_phase_t;
+
+typedef enum g_profile_event_t {
+    G_PROFILE_CYCLES,       // core cycles
+    G_PROFILE_INSTRUCTIONS, // retired instructions
+    G_PROFILE_L1D_MISSES,   // L1 data read misses
+    G_PROFILE_LLC_MISSES,   // last level cache read misses
+    G_PROFILE_BRANCH_MISSES,
+    G_PROFILE_EVENTS
+} g_profile_event_t;
+
+#define G_PROFILE_LAYERS 16 // deeper layers are folded into the last row
+#define G_PROFILE_IO     -1 // layer of the reader and writer phases
+
+// start of a phase: timestamp and, when counting, the counter values
+typedef struct g_profile_mark_t {
+    uint64_t cycles;
+    uint64_t events[G_PROFILE_EVENTS];
+} g_profile_mark_t;
+
+#ifdef G_PROFILE
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h> // __rdtsc
+
+static inline uint64_t g_profile_now(void) {
+    return __rdtsc();
+}
+#else
+#include <time.h> // clock_gettime, CLOCK_MONOTONIC
+
+static inline uint64_t g_profile_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+extern bool g_profile_enabled;
+extern bool g_profile_counting;
+
+extern void g_profile_read(g_profile_mark_t *mark);
+
+extern void g_profile_add(int layer, g_profile_phase_t phase, const g_profile_mark_t *mark);
+
+static inline void g_profile_begin(g_profile_mark_t *mark) {
+    if (g_profile_counting) {
+        g_profile_read(mark);
+    }
+
+    mark->cycles = g_profile_now();
+}
+
+#define G_PROFILE_BEGIN(name)     \
+    g_profile_mark_t name;        \
+    if (g_profile_enabled) {      \
+        g_profile_begin(&(name)); \
+    }
+
+#define G_PROFILE_END(name, layer, phase)               \
+    do {                                                \
+        if (g_profile_enabled) {                        \
+            g_profile_add((layer), (phase), &(name));   \
+        }                                               \
+    } while (0)
+
+#else
+
+#define G_PROFILE_BEGIN(name)
+#define G_PROFILE_END(name, layer, phase)
+
+#endif // G_PROFILE
+
+// -----------------------------------------------------------------------------
+
+// false when built without G_PROFILE
+extern bool g_profile_enable(void);
+
+// false when the hardware counters cannot be opened; timing goes on
+extern bool g_profile_enable_counters(void);
+
+// per-layer breakdown; samples/s from the forward passes of layer 0
+extern void g_profile_report(double seconds);
+
+extern void g_profile_release(void);
+
+#endif // G_PROFILE_H
+
+// -----------------------------------------------------------------------------
+// End of File
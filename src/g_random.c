@@ -8,6 +8,8 @@
 
 #include "g_random.h"
 
+#include <math.h> // cosf, logf, sinf, sqrtf
+
 // Variant for 32-bit microcontrollers of the Xoshiro256+ algorithm
 //
 // Source: https://prng.di.unimi.it/
@@ -60,5 +62,231 @@ float g_random_range(float min, float max) {
     return min + (random * (max - min));
 }
 
+void g_random_shuffle(uint32_t *ptr, uint32_t len) {
+    // Fisher-Yates, bounded draws by multiply-shift
+    for (uint32_t i = len; i > 1; --i) {
+        const uint32_t j = (uint32_t)(((uint64_t)g_random_next() * i) >> 32);
+
+        const uint32_t tmp = ptr[i - 1];
+        ptr[i - 1]         = ptr[j];
+        ptr[j]             = tmp;
+    }
+}
+
+void g_random_get_state(uint32_t state[8]) {
+    for (int i = 0; i < 8; i++) {
+        state[i] = _state[i];
+    }
+}
+
+void g_random_set_state(const uint32_t state[8]) {
+    for (int i = 0; i < 8; i++) {
+        _state[i] = state[i];
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Generator object: xoshiro128+, one stream per lane
+//
+// The variant above mixes ADD into the state update, so it has no jump
+// polynomial; xoshiro128+ is linear and jumps with the published tables.
+// -----------------------------------------------------------------------------
+
+#define G_RANDOM_BLOCK 256 // draws per chunk of the bulk fills
+
+static const uint32_t _jump_64[4] = {0x8764000B, 0xF542D2D3, 0x6FA035C3, 0x77F2DB5B};
+static const uint32_t _jump_96[4] = {0xB523952E, 0x0B6F099F, 0xCCF5A0EF, 0x1C580662};
+
+static inline void _step(uint32_t s[4]) {
+    const uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = _rotate_left(s[3], 11);
+}
+
+static void _jump(uint32_t s[4], const uint32_t table[4]) {
+    uint32_t acc[4] = {0, 0, 0, 0};
+
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 32; b++) {
+            if (table[i] & (1u << b)) {
+                acc[0] ^= s[0];
+                acc[1] ^= s[1];
+                acc[2] ^= s[2];
+                acc[3] ^= s[3];
+            }
+            _step(s);
+        }
+    }
+
+    s[0] = acc[0];
+    s[1] = acc[1];
+    s[2] = acc[2];
+    s[3] = acc[3];
+}
+
+static inline void _lane_get(const g_random_t *self, int l, uint32_t s[4]) {
+    for (int i = 0; i < 4; i++) {
+        s[i] = self->s[i][l];
+    }
+}
+
+static inline void _lane_set(g_random_t *self, int l, const uint32_t s[4]) {
+    for (int i = 0; i < 4; i++) {
+        self->s[i][l] = s[i];
+    }
+}
+
+// one step of every lane, written to out; plain loops the compiler vectorizes
+static inline void _step_lanes(g_random_t *self, uint32_t *out) {
+    uint32_t *s0 = self->s[0];
+    uint32_t *s1 = self->s[1];
+    uint32_t *s2 = self->s[2];
+    uint32_t *s3 = self->s[3];
+
+    for (int l = 0; l < G_RANDOM_LANES; l++) {
+        const uint32_t t = s1[l] << 9;
+
+        out[l] = s0[l] + s3[l];
+
+        s2[l] ^= s0[l];
+        s3[l] ^= s1[l];
+        s1[l] ^= s2[l];
+        s0[l] ^= s3[l];
+        s2[l] ^= t;
+        s3[l] = (s3[l] << 11) | (s3[l] >> 21);
+    }
+}
+
+// the interleaved sequence of g_random_draw, a block at a time
+static void _fill_bits(g_random_t *self, uint32_t *ptr, size_t len) {
+    while ((len > 0) && (self->cursor < G_RANDOM_LANES)) {
+        *ptr++ = self->out[self->cursor++];
+        len--;
+    }
+
+    while (len >= G_RANDOM_LANES) {
+        _step_lanes(self, ptr);
+        ptr += G_RANDOM_LANES;
+        len -= G_RANDOM_LANES;
+    }
+
+    if (len > 0) {
+        _step_lanes(self, self->out);
+        self->cursor = 0;
+
+        while (len > 0) {
+            *ptr++ = self->out[self->cursor++];
+            len--;
+        }
+    }
+}
+
+void g_random_init(g_random_t *self, uint32_t seed, uint32_t stream) {
+    uint32_t s[4];
+
+    // SplitMix32 expansion of the seed, never all zero
+    for (int i = 0; i < 4; i++) {
+        uint32_t z = (seed += 0x9E3779B9);
+        z          = (z ^ (z >> 16)) * 0x85EBCA6B;
+        z          = (z ^ (z >> 13)) * 0xC2B2AE35;
+        s[i]       = z ^ (z >> 16);
+    }
+
+    if ((s[0] | s[1] | s[2] | s[3]) == 0) {
+        s[0] = 0xBAD5EED1;
+    }
+
+    for (uint32_t k = 0; k < stream; k++) {
+        _jump(s, _jump_96);
+    }
+
+    for (int l = 0; l < G_RANDOM_LANES; l++) {
+        _lane_set(self, l, s);
+        _jump(s, _jump_64);
+    }
+
+    self->cursor = G_RANDOM_LANES; // out is empty
+}
+
+void g_random_jump(g_random_t *self) {
+    uint32_t s[4];
+
+    // every lane moves to the same lane of the next stream
+    for (int l = 0; l < G_RANDOM_LANES; l++) {
+        _lane_get(self, l, s);
+        _jump(s, _jump_96);
+        _lane_set(self, l, s);
+    }
+
+    self->cursor = G_RANDOM_LANES;
+}
+
+uint32_t g_random_draw(g_random_t *self) {
+    if (self->cursor >= G_RANDOM_LANES) {
+        _step_lanes(self, self->out);
+        self->cursor = 0;
+    }
+
+    return self->out[self->cursor++];
+}
+
+void g_random_fill_uniform(g_random_t *self, float *ptr, size_t len, float min, float max) {
+    uint32_t bits[G_RANDOM_BLOCK];
+
+    // top 24 bits: exact floats in [0, 1)
+    const float scale = (max - min) * 0x1.0p-24f;
+
+    while (len > 0) {
+        const size_t n = (len < G_RANDOM_BLOCK) ? len : G_RANDOM_BLOCK;
+
+        _fill_bits(self, bits, n);
+
+        for (size_t i = 0; i < n; i++) {
+            ptr[i] = min + (float)(bits[i] >> 8) * scale;
+        }
+
+        ptr += n;
+        len -= n;
+    }
+}
+
+void g_random_fill_normal(g_random_t *self, float *ptr, size_t len, float mean, float std_dev) {
+    uint32_t bits[G_RANDOM_BLOCK];
+
+    const float two_pi = 6.28318530718f;
+
+    // Box-Muller, two values per pair of draws; an odd tail drops the sine
+    while (len > 0) {
+        const size_t n     = (len < G_RANDOM_BLOCK) ? len : G_RANDOM_BLOCK;
+        const size_t pairs = (n + 1) / 2;
+
+        _fill_bits(self, bits, 2 * pairs);
+
+        for (size_t i = 0; i < n / 2; i++) {
+            const float u_1 = (float)((bits[2 * i] >> 8) + 1) * 0x1.0p-24f; // (0, 1]
+            const float u_2 = (float)(bits[2 * i + 1] >> 8) * 0x1.0p-24f;   // [0, 1)
+            const float r   = std_dev * sqrtf(-2.0f * logf(u_1));
+
+            ptr[2 * i]     = mean + r * cosf(two_pi * u_2);
+            ptr[2 * i + 1] = mean + r * sinf(two_pi * u_2);
+        }
+
+        if (n & 1) {
+            const float u_1 = (float)((bits[n - 1] >> 8) + 1) * 0x1.0p-24f;
+            const float u_2 = (float)(bits[n] >> 8) * 0x1.0p-24f;
+
+            ptr[n - 1] = mean + std_dev * sqrtf(-2.0f * logf(u_1)) * cosf(two_pi * u_2);
+        }
+
+        ptr += n;
+        len -= n;
+    }
+}
+
 // -----------------------------------------------------------------------------
 // End of File
@@ -9,14 +9,52 @@
 #ifndef G_RANDOM_H
 #define G_RANDOM_H
 
+#include <stddef.h> // size_t
 #include <stdint.h> // uint32_t
 
+// -----------------------------------------------------------------------------
+/*
+ * Generator object, independent of the global state below. It runs
+ * G_RANDOM_LANES xoshiro128+ streams side by side (one per SIMD lane) and
+ * returns their outputs interleaved, so bulk fills step all lanes at once.
+ * Lanes are 2^64 draws apart; streams, selected at init or by jumping, are
+ * 2^96 draws apart, enough for one stream per thread from a single seed.
+ */
+
+#define G_RANDOM_LANES 8
+
+typedef struct g_random_t {
+    uint32_t s[4][G_RANDOM_LANES]; // state words, lane-major for vector code
+    uint32_t out[G_RANDOM_LANES];  // last outputs of every lane
+    int      cursor;               // next unread value of out
+} g_random_t;
+
+// -----------------------------------------------------------------------------
+
+void g_random_init(g_random_t *self, uint32_t seed, uint32_t stream);
+
+void g_random_jump(g_random_t *self);
+
+uint32_t g_random_draw(g_random_t *self);
+
+void g_random_fill_uniform(g_random_t *self, float *ptr, size_t len, float min, float max);
+
+void g_random_fill_normal(g_random_t *self, float *ptr, size_t len, float mean, float std_dev);
+
+// -----------------------------------------------------------------------------
+
 void g_random_seed(uint32_t seed);
 
 uint32_t g_random_next(void);
 
 float g_random_range(float min, float max);
 
+void g_random_shuffle(uint32_t *ptr, uint32_t len);
+
+void g_random_get_state(uint32_t state[8]);
+
+void g_random_set_state(const uint32_t state[8]);
+
 #endif // G_RANDOM_H
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,219 @@
+// -----------------------------------------------------------------------------
+// @file g_scheduler.c
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#include "g_scheduler.h"
+
+#include <assert.h> // assert
+#include <math.h>   // cosf, fmaxf, fminf, powf, INFINITY
+#include <stdio.h>  // printf
+#include <stdlib.h> // NULL, calloc, free
+
+// -----------------------------------------------------------------------------
+
+#define G_SCHEDULER_PI 3.14159265358979f
+
+static void __unsafe_reset(g_scheduler_t *self) {
+    assert(self != NULL);
+    // variables
+    self->network = NULL;
+    self->type    = ADAPTIVE;
+    self->args    = (g_sched_args_t){0};
+    self->base_lr = NULL;
+    self->scale   = 1.0f;
+    self->step    = 0;
+    self->samples = 0;
+    self->sum     = 0.0;
+    self->loss    = 0.0f;
+    self->best    = INFINITY;
+    self->stale   = 0;
+
+    // intrinsic
+    self->_is_safe = false;
+}
+
+// cosine from hi (t = 0) down to lo (t = T)
+static float __cosine(float hi, float lo, int t, int T) {
+    const float p = (T > 0) ? fminf((float)t / T, 1.0f) : 1.0f;
+
+    return lo + (hi - lo) * 0.5f * (1.0f + cosf(G_SCHEDULER_PI * p));
+}
+
+// scale after t evaluated periods; PLATEAU updates it from the period loss
+static float __scale_at(g_scheduler_t *self, int t) {
+    const g_sched_args_t *a = &self->args;
+
+    switch (self->type) {
+        case STEP_DECAY:
+            return fmaxf(powf(a->gamma, (float)(t / a->step_size)), a->min_scale);
+        case COSINE:
+            return __cosine(1.0f, a->min_scale, t, a->total);
+        case ONE_CYCLE:
+            if (t < a->warmup) {
+                return 1.0f + (a->max_scale - 1.0f) * (float)t / a->warmup;
+            }
+            return __cosine(a->max_scale, a->min_scale, t - a->warmup, a->total - a->warmup);
+        case WARMUP:
+            return fminf((float)(t + 1) / (a->warmup + 1), 1.0f);
+        case PLATEAU:
+            if (self->loss < self->best * (1.0f - a->threshold)) {
+                self->best  = self->loss;
+                self->stale = 0;
+            } else if (++self->stale > a->patience) {
+                self->stale = 0;
+                return fmaxf(self->scale * a->factor, a->min_scale);
+            }
+            return self->scale;
+        default:
+            return 1.0f;
+    }
+}
+
+static void __apply(g_scheduler_t *self) {
+    g_pages_t *pages = self->network->pages;
+
+    for (int k = 0; k < pages->len; ++k) {
+        pages->ptr[k].lr = self->base_lr[k] * self->scale;
+    }
+}
+
+static void __evaluate(g_scheduler_t *self) {
+    self->loss = (float)(self->sum / self->samples);
+    self->step++;
+
+    self->sum     = 0.0;
+    self->samples = 0;
+
+    if (self->type != ADAPTIVE) {
+        self->scale = __scale_at(self, self->step);
+
+        __apply(self);
+    }
+}
+
+static bool __args_check(g_sched_type_t type, g_sched_args_t *args) {
+    bool rvalue = args->period >= 0;
+
+    switch (type) {
+        case STEP_DECAY:
+            rvalue = rvalue && (args->step_size > 0) && (args->gamma > 0.0f);
+            break;
+        case COSINE:
+            rvalue = rvalue && (args->total > 0);
+            break;
+        case ONE_CYCLE:
+            rvalue = rvalue && (args->total > 0) && (args->warmup >= 0) && (args->warmup < args->total);
+            rvalue = rvalue && (args->max_scale >= 1.0f);
+            break;
+        case WARMUP:
+            rvalue = rvalue && (args->warmup >= 0);
+            break;
+        case PLATEAU:
+            rvalue = rvalue && (args->patience >= 0) && (args->factor > 0.0f) && (args->factor < 1.0f);
+            break;
+        default:
+            break;
+    }
+
+    return rvalue;
+}
+
+static bool Create(struct g_scheduler_t *self, g_network_t *network, g_sched_type_t type, g_sched_args_t args) {
+    bool rvalue = (self != NULL) && (network != NULL) && network->_is_safe;
+
+    if (rvalue) {
+        rvalue = __args_check(type, &args);
+
+        if (!rvalue) {
+            printf("[ERROR] Invalid arguments for learning rate schedule\n");
+        }
+    }
+
+    if (rvalue) {
+        g_pages_t *pages = network->pages;
+
+        self->base_lr = calloc(pages->len, sizeof(float));
+
+        rvalue = self->base_lr != NULL;
+
+        if (rvalue) {
+            for (int k = 0; k < pages->len; ++k) {
+                self->base_lr[k] = pages->ptr[k].lr;
+            }
+
+            self->network = network;
+            self->type    = type;
+            self->args    = args;
+
+            // rates of the first period
+            if (type != ADAPTIVE) {
+                self->scale = __scale_at(self, 0);
+
+                __apply(self);
+            }
+        }
+
+        self->_is_safe = rvalue;
+
+        if (!rvalue) {
+            self->Destroy(self);
+        }
+    }
+
+    return rvalue;
+}
+
+static void Destroy(struct g_scheduler_t *self) {
+    if (self != NULL) {
+        free(self->base_lr);
+
+        __unsafe_reset(self);
+    }
+}
+
+static void Step_Sample(struct g_scheduler_t *self) {
+    if ((self != NULL) && self->_is_safe) {
+        g_network_t *network = self->network;
+
+        // loss of the error pass that just ran
+        self->sum += network->loss;
+        self->samples++;
+
+        if (self->type == ADAPTIVE) {
+            network->Step_Adjust(network);
+        }
+
+        if ((self->args.period > 0) && (self->samples == self->args.period)) {
+            __evaluate(self);
+        }
+    }
+}
+
+static void Step_Epoch(struct g_scheduler_t *self) {
+    if ((self != NULL) && self->_is_safe) {
+        // batches run across epoch boundaries
+        if ((self->args.period == 0) && (self->samples > 0)) {
+            __evaluate(self);
+        }
+    }
+}
+
+void g_scheduler_link(g_scheduler_t *self) {
+    if (self != NULL) {
+        // variables & intrinsic
+        __unsafe_reset(self);
+
+        // functions
+        self->Create      = Create;
+        self->Destroy     = Destroy;
+        self->Step_Sample = Step_Sample;
+        self->Step_Epoch  = Step_Epoch;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// End of File
@@ -0,0 +1,76 @@
+// -----------------------------------------------------------------------------
+// @file g_scheduler.h
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#ifndef G_SCHEDULER_H
+#define G_SCHEDULER_H
+
+#include "g_network.h" // g_network_t
+
+// -----------------------------------------------------------------------------
+/*
+ * A scheduler drives the learning rate of every layer. It is fed once per
+ * trained sample (after Step_Errors) and evaluates its schedule at the end of
+ * each period: a fixed number of samples (a batch) or a whole epoch. Every
+ * schedule except ADAPTIVE scales the rate each layer had at Create time.
+ */
+
+typedef enum g_sched_type_t {
+    ADAPTIVE,   // per-layer heuristic of Step_Adjust, every sample
+    CONSTANT,   // rates left untouched
+    STEP_DECAY, // scaled by gamma every step_size periods
+    COSINE,     // cosine annealing from 1 down to min_scale
+    ONE_CYCLE,  // linear rise to max_scale, then cosine down to min_scale
+    WARMUP,     // linear rise from 1 / (warmup + 1) to 1, then constant
+    PLATEAU     // scaled by factor after patience periods without improvement
+} g_sched_type_t;
+
+typedef struct g_sched_args_t {
+    long  period;    // samples per evaluation, 0: one epoch (Step_Epoch)
+    int   total;     // periods of the whole run (COSINE, ONE_CYCLE)
+    int   step_size; // periods between decays (STEP_DECAY)
+    float gamma;     // decay factor (STEP_DECAY)
+    int   warmup;    // periods of the linear rise (ONE_CYCLE, WARMUP)
+    int   patience;  // periods without improvement (PLATEAU)
+    float factor;    // reduction factor (PLATEAU)
+    float threshold; // relative improvement that resets patience (PLATEAU)
+    float min_scale; // lower bound of the scale
+    float max_scale; // peak of the scale (ONE_CYCLE)
+} g_sched_args_t;
+
+typedef struct g_scheduler_t {
+    // variables
+    g_network_t   *network;
+    g_sched_type_t type;
+    g_sched_args_t args;
+    float         *base_lr; // learning rate of each layer at Create time
+    float          scale;   // current multiplier of base_lr
+    int            step;    // periods evaluated so far
+    long           samples; // samples in the current period
+    double         sum;     // loss accumulated in the current period
+    float          loss;    // mean loss of the last period
+    float          best;    // lowest period loss (PLATEAU)
+    int            stale;   // periods since best (PLATEAU)
+
+    // functions
+    bool (*Create)(struct g_scheduler_t *self, g_network_t *network, g_sched_type_t type, g_sched_args_t args);
+    void (*Destroy)(struct g_scheduler_t *self);
+    void (*Step_Sample)(struct g_scheduler_t *self);
+    void (*Step_Epoch)(struct g_scheduler_t *self);
+
+    // intrinsic
+    bool _is_safe;
+} g_scheduler_t;
+
+// -----------------------------------------------------------------------------
+
+extern void g_scheduler_link(g_scheduler_t *self);
+
+#endif // G_SCHEDULER_H
+
+// -----------------------------------------------------------------------------
+// End of File
@@ -0,0 +1,236 @@
+// -----------------------------------------------------------------------------
+// @file g_trace.c
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#include "g_trace.h"
+
+#ifdef G_PROFILE
+
+#include <stdatomic.h> // atomic_compare_exchange_weak, atomic_exchange, atomic_fetch_add, atomic_load, _Atomic
+#include <stdio.h>     // fclose, ferror, fopen, fprintf, printf, FILE
+#include <stdlib.h>    // calloc, free
+#include <time.h>      // clock_gettime, CLOCK_MONOTONIC
+
+// -----------------------------------------------------------------------------
+
+typedef struct g_trace_event_t {
+    uint64_t    begin;
+    uint64_t    end;
+    const char *name;
+    const char *category;
+    int32_t     layer;
+} g_trace_event_t;
+
+typedef struct g_trace_ring_t {
+    g_trace_event_t *events;
+    uint64_t         head; // events recorded, the newest at (head - 1) & mask
+    uint64_t         mask;
+
+    int         tid;
+    const char *name;
+
+    struct g_trace_ring_t *next;
+} g_trace_ring_t;
+
+bool g_trace_enabled = false;
+
+static _Atomic(g_trace_ring_t *) _rings = NULL;
+static atomic_int                _tids  = 0;
+
+static _Thread_local g_trace_ring_t *_ring = NULL;
+static _Thread_local const char     *_name = NULL;
+
+static size_t   _capacity;
+static uint64_t _start_cycles;
+static double   _start_seconds;
+
+// -----------------------------------------------------------------------------
+
+static double __seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static g_trace_ring_t *__register(void) {
+    g_trace_ring_t *ring = calloc(1, sizeof(g_trace_ring_t));
+
+    if (ring != NULL) {
+        ring->events = calloc(_capacity, sizeof(g_trace_event_t));
+
+        if (ring->events == NULL) {
+            free(ring);
+            return NULL;
+        }
+
+        ring->mask = _capacity - 1;
+        ring->tid  = atomic_fetch_add(&_tids, 1);
+        ring->name = _name;
+
+        // lock-free push, rings are only freed by g_trace_release
+        ring->next = atomic_load(&_rings);
+        while (!atomic_compare_exchange_weak(&_rings, &ring->next, ring)) {
+        }
+    }
+
+    return ring;
+}
+
+void g_trace_record(const char *name, const char *category, int layer, uint64_t begin, uint64_t end) {
+    if (_ring == NULL) {
+        _ring = __register();
+
+        if (_ring == NULL) {
+            return;
+        }
+    }
+
+    g_trace_event_t *event = &_ring->events[_ring->head++ & _ring->mask];
+
+    event->begin    = begin;
+    event->end      = end;
+    event->name     = name;
+    event->category = category;
+    event->layer    = layer;
+}
+
+bool g_trace_enable(size_t capacity) {
+    _capacity = 2;
+    while (_capacity < capacity) {
+        _capacity <<= 1;
+    }
+
+    _start_cycles  = g_profile_now();
+    _start_seconds = __seconds();
+
+    g_trace_enabled = true;
+
+    return true;
+}
+
+void g_trace_thread_name(const char *name) {
+    // threads started before g_trace_enable pass it on when they register
+    _name = name;
+
+    if (_ring != NULL) {
+        _ring->name = name;
+    }
+}
+
+bool g_trace_dump(const char *filename) {
+    if (!g_trace_enabled) {
+        return false;
+    }
+
+    FILE *file = fopen(filename, "w");
+    if (file == NULL) {
+        printf("[ERROR] Unable to open trace file '%s'\n", filename);
+        return false;
+    }
+
+    // counter ticks per microsecond over the run
+    const double elapsed = __seconds() - _start_seconds;
+    const double rate    = (elapsed > 0.0) ? (double)(g_profile_now() - _start_cycles) / elapsed * 1e-6 : 1e3;
+
+    uint64_t events  = 0;
+    uint64_t dropped = 0;
+
+    fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"g_fnn\"}}");
+
+    for (g_trace_ring_t *ring = atomic_load(&_rings); ring != NULL; ring = ring->next) {
+        if (ring->name != NULL) {
+            fprintf(file,
+                    ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                    ring->tid,
+                    ring->name);
+        }
+
+        // oldest kept event first
+        const uint64_t first = (ring->head > ring->mask + 1) ? ring->head - (ring->mask + 1) : 0;
+
+        dropped += first;
+
+        for (uint64_t i = first; i < ring->head; ++i) {
+            const g_trace_event_t *event = &ring->events[i & ring->mask];
+
+            const double ts  = (event->begin >= _start_cycles) ? (double)(event->begin - _start_cycles) / rate : 0.0;
+            const double dur = (double)(event->end - event->begin) / rate;
+
+            fprintf(file,
+                    ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f",
+                    event->name,
+                    event->category,
+                    ring->tid,
+                    ts,
+                    dur);
+
+            if (event->layer >= 0) {
+                fprintf(file, ",\"args\":{\"layer\":%d}", event->layer);
+            }
+
+            fprintf(file, "}");
+            events++;
+        }
+    }
+
+    fprintf(file, "\n],\"otherData\":{\"dropped\":%llu}}\n", (unsigned long long)dropped);
+
+    const bool rvalue = (ferror(file) == 0) & (fclose(file) == 0);
+
+    if (!rvalue) {
+        printf("[ERROR] Unable to write trace file '%s'\n", filename);
+    } else {
+        printf("[INFO] Trace: %llu events written to '%s' (%llu dropped)\n",
+               (unsigned long long)events,
+               filename,
+               (unsigned long long)dropped);
+    }
+
+    return rvalue;
+}
+
+void g_trace_release(void) {
+    g_trace_ring_t *ring = atomic_exchange(&_rings, NULL);
+
+    while (ring != NULL) {
+        g_trace_ring_t *next = ring->next;
+        free(ring->events);
+        free(ring);
+        ring = next;
+    }
+
+    _ring = NULL;
+
+    atomic_store(&_tids, 0);
+
+    g_trace_enabled = false;
+}
+
+#else
+
+bool g_trace_enable(size_t capacity) {
+    (void)capacity;
+    return false;
+}
+
+void g_trace_thread_name(const char *name) {
+    (void)name;
+}
+
+bool g_trace_dump(const char *filename) {
+    (void)filename;
+    return false;
+}
+
+void g_trace_release(void) {
+}
+
+#endif // G_PROFILE
+
+// -----------------------------------------------------------------------------
+// End of File
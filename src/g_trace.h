@@ -0,0 +1,71 @@
+// -----------------------------------------------------------------------------
+// @file g_trace.h
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#ifndef G_TRACE_H
+#define G_TRACE_H
+
+#include <stdbool.h> // bool
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint64_t
+
+#include "g_profile.h" // g_profile_now
+
+// -----------------------------------------------------------------------------
+/*
+ * Timeline of layer phases, I/O batches, queue waits and checkpoints, dumped
+ * as Chrome trace-event JSON (chrome://tracing, ui.perfetto.dev). Built with
+ * G_PROFILE, like the timing it shares the clock with; layer phases come from
+ * the G_PROFILE_BEGIN/END marks, other spans from G_TRACE_BEGIN/END.
+ *
+ * Every thread records complete events into its own ring, so recording is a
+ * counter read and a 40-byte store without atomics. A full ring overwrites
+ * its oldest events; the dump keeps the newest and reports how many were
+ * dropped. Dump only after the recording threads have been joined.
+ */
+
+#define G_TRACE_CAPACITY (1 << 16) // default events per thread (power of two)
+
+#ifdef G_PROFILE
+
+extern bool g_trace_enabled;
+
+// name and category must outlive the dump (string literals)
+extern void g_trace_record(const char *name, const char *category, int layer, uint64_t begin, uint64_t end);
+
+#define G_TRACE_BEGIN(name) const uint64_t name = g_trace_enabled ? g_profile_now() : 0
+
+#define G_TRACE_END(name, label, category)                                                   \
+    do {                                                                                      \
+        if (g_trace_enabled) {                                                                \
+            g_trace_record((label), (category), G_PROFILE_IO, (name), g_profile_now());       \
+        }                                                                                     \
+    } while (0)
+
+#else
+
+#define G_TRACE_BEGIN(name)
+#define G_TRACE_END(name, label, category)
+
+#endif // G_PROFILE
+
+// -----------------------------------------------------------------------------
+
+// capacity in events per thread, rounded up to a power of two; false when built without G_PROFILE
+extern bool g_trace_enable(size_t capacity);
+
+// names the calling thread in the timeline
+extern void g_trace_thread_name(const char *name);
+
+extern bool g_trace_dump(const char *filename);
+
+extern void g_trace_release(void);
+
+#endif // G_TRACE_H
+
+// -----------------------------------------------------------------------------
+// End of File
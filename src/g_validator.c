@@ -0,0 +1,306 @@
+// -----------------------------------------------------------------------------
+// @file g_validator.c
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#include "g_validator.h"
+
+#include <assert.h> // assert
+#include <stdlib.h> // NULL, calloc, free
+#include <string.h> // memset
+#include <time.h>   // clock_gettime, CLOCK_MONOTONIC
+
+// -----------------------------------------------------------------------------
+
+static void __unsafe_reset(g_validator_t *self) {
+    assert(self != NULL);
+    // variables
+    self->threads   = 0;
+    self->top_k     = 1;
+    self->classes   = 0;
+    self->workers   = NULL;
+    self->bind      = NULL;
+    self->ctx       = NULL;
+    self->total     = 0;
+    self->predicted = NULL;
+    self->samples   = 0;
+    self->hits_1    = 0;
+    self->hits_k    = 0;
+    self->loss      = 0.0;
+    self->confusion = NULL;
+
+    memset(&self->latency, 0, sizeof(self->latency));
+
+    atomic_init(&self->next, 0);
+
+    // intrinsic
+    self->_is_safe = false;
+}
+
+static inline uint64_t __now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// scalar loops: the argmax compares carry Y[y_max] from one class to the
+// next, so they do not vectorize; P is the output width, so they stay cheap
+static void __sample_metrics(g_validator_worker_t *worker, long index) {
+    g_validator_t *self = worker->owner;
+
+    g_pages_t *pages = &worker->pages;
+    g_page_t  *page  = &pages->ptr[pages->len - 1];
+
+    const int    P = self->classes;
+    const float *Y = page->y.ptr;
+    const float *T = worker->targets.ptr;
+
+    int y_max = 0;
+    int t_max = 0;
+
+    for (int j = 1; j < P; ++j) {
+        y_max = (Y[j] > Y[y_max]) ? j : y_max;
+        t_max = (T[j] > T[t_max]) ? j : t_max;
+    }
+
+    // rank of the target class: outputs strictly above it
+    int rank = 0;
+
+    for (int j = 0; j < P; ++j) {
+        rank += Y[j] > Y[t_max];
+    }
+
+    worker->samples++;
+    worker->hits_1 += (y_max == t_max);
+    worker->hits_k += (rank < self->top_k);
+    worker->loss += worker->network.loss_call(page, &worker->targets); // writes the private dE/dY only
+    worker->confusion[t_max * P + y_max]++;
+
+    if (self->predicted != NULL) {
+        self->predicted[index] = y_max;
+    }
+}
+
+static void *__worker(void *arg) {
+    g_validator_worker_t *worker = arg;
+    g_validator_t        *self   = worker->owner;
+
+    g_network_t *network = &worker->network;
+    f_vector_t  *inputs  = &worker->pages.ptr[0].x;
+
+    float *x_row = inputs->ptr;
+
+    long begin;
+
+    while ((begin = atomic_fetch_add(&self->next, G_VALIDATOR_BATCH)) < self->total) {
+        const long end = (begin + G_VALIDATOR_BATCH < self->total) ? begin + G_VALIDATOR_BATCH : self->total;
+
+        for (long n = begin; n < end; ++n) {
+            // binders may point the vectors elsewhere or copy into them
+            inputs->ptr          = x_row;
+            worker->targets.ptr = worker->target_row;
+
+            if (!self->bind(self->ctx, n, inputs, &worker->targets)) {
+                if (self->predicted != NULL) {
+                    self->predicted[n] = -1; // not validated
+                }
+                continue;
+            }
+
+            const uint64_t t0 = __now_ns();
+
+            network->Step_Forward(network);
+
+            g_histogram_record(&worker->latency, __now_ns() - t0);
+
+            __sample_metrics(worker, n);
+        }
+    }
+
+    inputs->ptr = x_row;
+
+    return NULL;
+}
+
+static bool Create(struct g_validator_t *self, g_pages_t *pages, int threads, int top_k) {
+    bool rvalue = (self != NULL) && g_network_pages_check(pages) && (threads > 0) && (top_k > 0);
+
+    if (rvalue) {
+        const int P = pages->ptr[pages->len - 1].y.len;
+
+        self->threads   = threads;
+        self->top_k     = top_k;
+        self->classes   = P;
+        self->workers   = calloc(threads, sizeof(g_validator_worker_t));
+        self->confusion = calloc((size_t)P * P, sizeof(long));
+
+        rvalue = (self->workers != NULL) && (self->confusion != NULL);
+        rvalue = rvalue && g_histogram_init(&self->latency, 1, G_VALIDATOR_LATENCY_MAX, G_VALIDATOR_LATENCY_DIGITS);
+
+        for (int t = 0; (t < threads) && rvalue; ++t) {
+            g_validator_worker_t *worker = &self->workers[t];
+
+            worker->owner      = self;
+            worker->targets.len = P;
+            worker->target_row = calloc(P, sizeof(float));
+            worker->confusion  = calloc((size_t)P * P, sizeof(long));
+
+            rvalue = (worker->target_row != NULL) && (worker->confusion != NULL);
+            rvalue = rvalue && g_histogram_init(&worker->latency, 1, G_VALIDATOR_LATENCY_MAX, G_VALIDATOR_LATENCY_DIGITS);
+            rvalue = rvalue && g_pages_clone(&worker->pages, pages);
+
+            if (rvalue) {
+                g_network_link(&worker->network);
+
+                rvalue = worker->network.Create(&worker->network, &worker->pages);
+            }
+        }
+
+        self->_is_safe = rvalue;
+
+        if (!rvalue) {
+            self->Destroy(self);
+        }
+    }
+
+    return rvalue;
+}
+
+static void Destroy(struct g_validator_t *self) {
+    if (self != NULL) {
+        if (self->workers != NULL) {
+            for (int t = 0; t < self->threads; ++t) {
+                g_validator_worker_t *worker = &self->workers[t];
+
+                if (worker->network.Destroy != NULL) {
+                    worker->network.Destroy(&worker->network);
+                }
+
+                g_pages_free(&worker->pages);
+
+                free(worker->target_row);
+                free(worker->confusion);
+
+                g_histogram_free(&worker->latency);
+            }
+
+            free(self->workers);
+        }
+
+        free(self->confusion);
+
+        g_histogram_free(&self->latency);
+
+        __unsafe_reset(self);
+    }
+}
+
+static bool Run(struct g_validator_t *self, g_validator_bind_t bind, void *ctx, long total, int32_t *predicted) {
+    bool rvalue = (self != NULL) && self->_is_safe && (bind != NULL) && (total >= 0);
+
+    if (rvalue) {
+        const int P = self->classes;
+
+        self->bind      = bind;
+        self->ctx       = ctx;
+        self->total     = total;
+        self->predicted = predicted;
+
+        atomic_store(&self->next, 0);
+
+        for (int t = 0; t < self->threads; ++t) {
+            g_validator_worker_t *worker = &self->workers[t];
+
+            worker->samples = 0;
+            worker->hits_1  = 0;
+            worker->hits_k  = 0;
+            worker->loss    = 0.0;
+
+            memset(worker->confusion, 0, (size_t)P * P * sizeof(long));
+
+            g_histogram_reset(&worker->latency);
+        }
+
+        // worker 0 runs on the calling thread; a worker whose thread cannot
+        // start leaves its share to the others
+        bool *started = calloc(self->threads, sizeof(bool));
+
+        rvalue = started != NULL;
+
+        for (int t = 1; (t < self->threads) && rvalue; ++t) {
+            started[t] = pthread_create(&self->workers[t].thread, NULL, __worker, &self->workers[t]) == 0;
+        }
+
+        if (rvalue) {
+            __worker(&self->workers[0]);
+
+            for (int t = 1; t < self->threads; ++t) {
+                if (started[t]) {
+                    pthread_join(self->workers[t].thread, NULL);
+                }
+            }
+        }
+
+        free(started);
+
+        // merge
+        self->samples = 0;
+        self->hits_1  = 0;
+        self->hits_k  = 0;
+        self->loss    = 0.0;
+
+        memset(self->confusion, 0, (size_t)P * P * sizeof(long));
+
+        g_histogram_reset(&self->latency);
+
+        for (int t = 0; t < self->threads; ++t) {
+            g_validator_worker_t *worker = &self->workers[t];
+
+            self->samples += worker->samples;
+            self->hits_1 += worker->hits_1;
+            self->hits_k += worker->hits_k;
+            self->loss += worker->loss;
+
+            for (int i = 0; i < P * P; ++i) {
+                self->confusion[i] += worker->confusion[i];
+            }
+
+            g_histogram_merge(&self->latency, &worker->latency);
+        }
+
+        self->loss = (self->samples > 0) ? self->loss / self->samples : 0.0;
+    }
+
+    return rvalue;
+}
+
+static bool Set_Loss(struct g_validator_t *self, g_loss_type_t loss_type) {
+    bool rvalue = (self != NULL) && self->_is_safe;
+
+    for (int t = 0; rvalue && (t < self->threads); ++t) {
+        g_network_t *network = &self->workers[t].network;
+
+        rvalue = network->Set_Loss(network, loss_type);
+    }
+
+    return rvalue;
+}
+
+void g_validator_link(g_validator_t *self) {
+    if (self != NULL) {
+        // variables & intrinsic
+        __unsafe_reset(self);
+
+        // functions
+        self->Create   = Create;
+        self->Destroy  = Destroy;
+        self->Run      = Run;
+        self->Set_Loss = Set_Loss;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// End of File
@@ -0,0 +1,98 @@
+// -----------------------------------------------------------------------------
+// @file g_validator.h
+//
+// @date October, 2026
+//
+// @author Gino Francesco Bogo
+// -----------------------------------------------------------------------------
+
+#ifndef G_VALIDATOR_H
+#define G_VALIDATOR_H
+
+#include <pthread.h>   // pthread_t
+#include <stdatomic.h> // atomic_long
+#include <stdint.h>    // int32_t
+
+#include "g_histogram.h" // g_histogram_t
+#include "g_network.h"   // g_network_t
+
+// -----------------------------------------------------------------------------
+/*
+ * Multi-threaded inference over a labelled set. Every worker owns a clone of
+ * the pages (private activations, shared read-only weights) and a network
+ * built on it, claims batches of samples from a shared counter and keeps its
+ * own counters; they are merged once all workers are done. The pages given
+ * to Create are never written.
+ *
+ * Workers also time every forward pass into their own latency histogram,
+ * merged like the counters. The loss is the one set with Set_Loss (MSE by
+ * default), computed as in training, so that early stopping follows the
+ * objective being trained.
+ */
+
+#define G_VALIDATOR_BATCH 256 // samples claimed at once by a worker
+
+#define G_VALIDATOR_LATENCY_DIGITS 2            // significant digits of the latency histograms
+#define G_VALIDATOR_LATENCY_MAX    10000000000u // 10 s in nanoseconds, longer passes are clamped
+
+// binds (or copies) the index-th sample into inputs and targets; called
+// concurrently by the workers
+typedef bool (*g_validator_bind_t)(void *ctx, long index, f_vector_t *inputs, f_vector_t *targets);
+
+struct g_validator_t; // forward declaration
+
+typedef struct g_validator_worker_t {
+    struct g_validator_t *owner;
+
+    g_pages_t   pages; // private clone
+    g_network_t network;
+    f_vector_t  targets;
+    float      *target_row; // for binders that copy
+    pthread_t   thread;
+
+    long          samples;
+    long          hits_1;
+    long          hits_k;
+    double        loss;
+    long         *confusion; // [classes][classes], row: target, column: prediction
+    g_histogram_t latency;   // forward pass, nanoseconds
+} g_validator_worker_t;
+
+typedef struct g_validator_t {
+    // variables
+    int                   threads;
+    int                   top_k;
+    int                   classes;
+    g_validator_worker_t *workers;
+
+    g_validator_bind_t bind;
+    void              *ctx;
+    long               total;
+    int32_t           *predicted; // [total] winning class, -1 if not bound, optional
+    atomic_long        next;      // first sample of the next batch
+
+    long          samples;   // merged results of the last Run
+    long          hits_1;    // argmax matches the target class
+    long          hits_k;    // target class among the top_k outputs
+    double        loss;      // mean loss per sample
+    long         *confusion; // [classes][classes], row: target, column: prediction
+    g_histogram_t latency;   // forward pass, nanoseconds
+
+    // functions
+    bool (*Create)(struct g_validator_t *self, g_pages_t *pages, int threads, int top_k);
+    void (*Destroy)(struct g_validator_t *self);
+    bool (*Run)(struct g_validator_t *self, g_validator_bind_t bind, void *ctx, long total, int32_t *predicted);
+    bool (*Set_Loss)(struct g_validator_t *self, g_loss_type_t loss_type);
+
+    // intrinsic
+    bool _is_safe;
+} g_validator_t;
+
+// -----------------------------------------------------------------------------
+
+extern void g_validator_link(g_validator_t *self);
+
+#endif // G_VALIDATOR_H
+
+// -----------------------------------------------------------------------------
+// End of File